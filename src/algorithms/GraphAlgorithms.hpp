@@ -37,6 +37,27 @@ bool reachabilityDFS(const DiGraph &graph, Vertex source, Vertex target);
  */
 bool reachabilityBiBFS(const DiGraph &graph, Vertex source, Vertex target);
 
+/**
+ * @brief returns true if target is reachable from source, only following edges with a label in the label set.
+ * Uses Bi-directional BFS, each step expands a level of the side with the smaller frontier.
+ */
+bool labelConstrainedBiBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target, const LabelSet &labelSet,
+                           TraversalScratch &forward, TraversalScratch &backward);
+
+/**
+ * @brief returns true if target is reachable from source, only following edges with a label in the label set.
+ * Uses direction optimizing BFS, large frontiers are expanded bottom up over the reverse edges of unvisited vertices.
+ */
+bool labelConstrainedHybridBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target, const LabelSet &labelSet,
+                               TraversalScratch &scratch);
+
+/**
+ * @brief returns true if target is reachable from source, only following edges with a label in the label set.
+ * Uses Bi-directional direction optimizing BFS, each step expands the side with the fewest frontier edges.
+ */
+bool labelConstrainedHybridBiBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target,
+                                 const LabelSet &labelSet, TraversalScratch &forward, TraversalScratch &backward);
+
 /**
  * @brief returns true if target is reachable from source in the graph.
  * Also constructs the found path from target to source.
@@ -105,6 +126,16 @@ std::unique_ptr<SCCGraph> tarjanSCC(const LabeledEdgeGraph &graph);
  */
 std::unique_ptr<SCCGraph> tarjanSCC(const LabeledEdgeGraph &graph, bool includeComponents);
 
+/**
+ * @brief Returns the strongly connected component graph of the graph merged over labelSet.
+ * Derived from the scc graph of a subset of labelSet, which still has its component graph: the edges of the labels
+ * outside of the subset are added to that component graph, which is then condensed again.
+ * The SCC graph is guaranteed to be topologically sorted, the stats are those of mergeGraphForLabels.
+ */
+std::unique_ptr<SCCGraph> deriveSCCGraph(const LabeledEdgeGraph &labeledGraph, const SCCGraph &subsetGraph,
+                                         const LabelSet &subsetLabelSet, const LabelSet &labelSet,
+                                         MergedGraphStats &outStats);
+
 /**
  * @brief Counts the number of weakly connected components in the graph.
  */
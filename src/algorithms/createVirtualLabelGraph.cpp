@@ -144,6 +144,10 @@ createVirtualLabelGraph(const LabeledEdgeGraph &labeledGraph, const std::vector<
         }
     }
 
+    if (labeledGraph.isLabelGrouped()) {
+        graph->groupByLabel();
+    }
+
     graph->optimize();
     return graph;
 }
\ No newline at end of file
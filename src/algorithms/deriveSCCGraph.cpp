@@ -0,0 +1,88 @@
+#include "graphs/SCCGraph.hpp"
+#include "graphs/LabeledEdgeGraph.hpp"
+
+std::unique_ptr<SCCGraph> deriveSCCGraph(const LabeledEdgeGraph &labeledGraph, const SCCGraph &subsetGraph,
+                                         const LabelSet &subsetLabelSet, const LabelSet &labelSet,
+                                         MergedGraphStats &outStats) {
+    auto &subsetComponents = subsetGraph.getComponentGraph();
+    auto componentCount = subsetComponents.getVertexCount();
+
+    // The edges of the added labels between different components of the subset.
+    std::vector<std::pair<Vertex, Vertex>> addedEdges;
+
+    boost::dynamic_bitset<> visited(labeledGraph.getVertexCount());
+    std::vector<Vertex> targets;
+
+    std::vector<size_t> labelEdgeCounts(labeledGraph.getLabelCount());
+    size_t mergedEdgeCount = 0;
+
+    for (auto source = 0u; source < labeledGraph.getVertexCount(); source++) {
+        auto sourceComponent = subsetGraph.getComponentIndex(source);
+        auto it = labeledGraph.getConnected(source, labelSet);
+
+        while (it.next()) {
+            auto &edge = *it;
+            labelEdgeCounts[edge.label]++;
+
+            if (!subsetLabelSet[edge.label]) {
+                auto targetComponent = subsetGraph.getComponentIndex(edge.target);
+
+                if (sourceComponent != targetComponent) {
+                    addedEdges.emplace_back(sourceComponent, targetComponent);
+                }
+            }
+
+            // Count the unique edges of the merged graph, as mergeGraphForLabels does.
+            if (!visited[edge.target]) {
+                visited[edge.target] = true;
+                targets.emplace_back(edge.target);
+            }
+        }
+
+        mergedEdgeCount += targets.size();
+
+        for (auto target : targets) {
+            visited[target] = false;
+        }
+
+        targets.clear();
+    }
+
+    auto maxEdgeCount = *std::max_element(labelEdgeCounts.begin(), labelEdgeCounts.end());
+
+    outStats.increase = int64_t(maxEdgeCount) - int64_t(mergedEdgeCount);
+    outStats.increasePercentage = double(outStats.increase) / double(maxEdgeCount) * 100.0;
+
+    std::sort(addedEdges.begin(), addedEdges.end());
+
+    // The component graph of the subset plus the added edges, without duplicates.
+    DiGraph graph;
+    graph.setVertices(componentCount);
+
+    std::vector<uint32_t> edgeUsed(componentCount, std::numeric_limits<uint32_t>::max());
+    auto added = addedEdges.begin();
+
+    for (Vertex component = 0; component < componentCount; component++) {
+        for (auto target : subsetComponents.getConnected(component)) {
+            edgeUsed[target] = component;
+            targets.emplace_back(target);
+        }
+
+        for (; added != addedEdges.end() && added->first == component; added++) {
+            if (edgeUsed[added->second] != component) {
+                edgeUsed[added->second] = component;
+                targets.emplace_back(added->second);
+            }
+        }
+
+        graph.addEdgesNoChecks(component, targets);
+        targets.clear();
+    }
+
+    std::vector<std::pair<Vertex, Vertex>>().swap(addedEdges);
+
+    auto sccGraph = tarjanSCC(graph);
+    sccGraph->composeVertexMapping(subsetGraph.getVertexMapping());
+
+    return sccGraph;
+}
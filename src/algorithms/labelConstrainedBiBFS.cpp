@@ -0,0 +1,64 @@
+#include "graphs/SCCGraph.hpp"
+#include "graphs/LabeledGraph.hpp"
+#include "dataStructures/QueryContext.hpp"
+
+/**
+ * @brief expands all vertices of the current level of one side, returns true if the other side is reached.
+ */
+template<bool backward>
+static bool expandLevel(const LabeledEdgeGraph &graph, const LabelSet &labelSet, TraversalScratch &side,
+                        const EpochVisitedSet &otherVisited) {
+    for (auto count = side.queue.size(); count > 0; count--) {
+        auto vertex = side.queue.front();
+        side.queue.pop_front();
+
+        auto it = backward ? graph.getReverseConnected(vertex, labelSet) : graph.getConnected(vertex, labelSet);
+
+        while (it.next()) {
+            if (!side.visited.insert(it->target)) {
+                continue;
+            }
+
+            if (otherVisited[it->target]) {
+                return true;
+            }
+
+            side.queue.emplace_back(it->target);
+        }
+    }
+
+    return false;
+}
+
+bool labelConstrainedBiBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target, const LabelSet &labelSet,
+                           TraversalScratch &forward, TraversalScratch &backward) {
+    if (source == target) {
+        return true;
+    }
+
+    if (labelSet.none()) {
+        return false;
+    }
+
+    forward.prepareVisited(graph.getVertexCount());
+    backward.prepareVisited(graph.getVertexCount());
+
+    forward.visited.set(source);
+    backward.visited.set(target);
+
+    forward.queue.emplace_back(source);
+    backward.queue.emplace_back(target);
+
+    while (!forward.queue.empty() && !backward.queue.empty()) {
+        // Expand the side with the smaller frontier, such that both searches stay small.
+        if (forward.queue.size() <= backward.queue.size()) {
+            if (expandLevel<false>(graph, labelSet, forward, backward.visited)) {
+                return true;
+            }
+        } else if (expandLevel<true>(graph, labelSet, backward, forward.visited)) {
+            return true;
+        }
+    }
+
+    return false;
+}
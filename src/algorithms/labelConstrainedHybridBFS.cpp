@@ -0,0 +1,177 @@
+#include "graphs/SCCGraph.hpp"
+#include "graphs/LabeledGraph.hpp"
+#include "dataStructures/QueryContext.hpp"
+
+namespace {
+    // Switch to bottom up once the frontier has more than 1/alpha of the unexplored edges,
+    // and back to top down once the frontier holds less than 1/beta of the vertices.
+    constexpr uint64_t alpha = 14;
+    constexpr uint64_t beta = 24;
+
+    /**
+     * @brief one direction of a level synchronous, direction optimizing search.
+     * A backward search walks the reverse edges, thus its bottom up steps walk the forward edges.
+     */
+    class SearchSide {
+    private:
+        const LabeledEdgeGraph &graph;
+        const LabelSet &labelSet;
+        TraversalScratch &scratch;
+
+        bool backward;
+        bool bottomUp = false;
+
+        uint64_t unexploredEdges;
+
+        [[nodiscard]] uint64_t degree(Vertex vertex) const {
+            return backward ? graph.getReverseConnected(vertex).size() : graph.getConnected(vertex).size();
+        }
+
+        [[nodiscard]] LabeledEdgeGraphLabelSetIterator outgoing(Vertex vertex) const {
+            return backward ? graph.getReverseConnected(vertex, labelSet) : graph.getConnected(vertex, labelSet);
+        }
+
+        [[nodiscard]] LabeledEdgeGraphLabelSetIterator incoming(Vertex vertex) const {
+            return backward ? graph.getConnected(vertex, labelSet) : graph.getReverseConnected(vertex, labelSet);
+        }
+
+        /**
+         * @brief adds the vertex to the next frontier, returns true if the search is done.
+         */
+        bool discover(Vertex vertex, const SearchSide *other, Vertex goal, uint64_t &nextEdges) {
+            scratch.visited.set(vertex);
+            scratch.nextFrontier.emplace_back(vertex);
+            nextEdges += degree(vertex);
+
+            return other == nullptr ? vertex == goal : other->isVisited(vertex);
+        }
+
+    public:
+        // Edges of the frontier, used to decide which side of a bi-directional search to expand.
+        uint64_t frontierEdges;
+
+        SearchSide(const LabeledEdgeGraph &graph, const LabelSet &labelSet, TraversalScratch &scratch, Vertex start,
+                   bool backward) : graph(graph), labelSet(labelSet), scratch(scratch), backward(backward) {
+            scratch.prepareVisited(graph.getVertexCount());
+            scratch.visited.set(start);
+
+            scratch.frontier.clear();
+            scratch.frontier.emplace_back(start);
+
+            frontierEdges = degree(start);
+            unexploredEdges = graph.getEdgeCount() - frontierEdges;
+        }
+
+        [[nodiscard]] bool isVisited(Vertex vertex) const {
+            return scratch.visited[vertex];
+        }
+
+        [[nodiscard]] bool exhausted() const {
+            return scratch.frontier.empty();
+        }
+
+        /**
+         * @brief expands the frontier by one level, returns true once the goal or the other side is reached.
+         */
+        bool expand(const SearchSide *other, Vertex goal) {
+            uint64_t nextEdges = 0;
+            scratch.nextFrontier.clear();
+
+            if (bottomUp) {
+                // Any visited parent suffices, as for reachability only discovery matters, not the level.
+                for (Vertex vertex = 0; vertex < graph.getVertexCount(); vertex++) {
+                    if (scratch.visited[vertex]) {
+                        continue;
+                    }
+
+                    auto it = incoming(vertex);
+
+                    while (it.next()) {
+                        if (!scratch.visited[it->target]) {
+                            continue;
+                        }
+
+                        if (discover(vertex, other, goal, nextEdges)) {
+                            return true;
+                        }
+
+                        break;
+                    }
+                }
+            } else {
+                for (auto vertex : scratch.frontier) {
+                    auto it = outgoing(vertex);
+
+                    while (it.next()) {
+                        if (scratch.visited[it->target]) {
+                            continue;
+                        }
+
+                        if (discover(it->target, other, goal, nextEdges)) {
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            unexploredEdges -= std::min(unexploredEdges, nextEdges);
+            frontierEdges = nextEdges;
+
+            if (!bottomUp && nextEdges > unexploredEdges / alpha) {
+                bottomUp = true;
+            } else if (bottomUp && scratch.nextFrontier.size() < graph.getVertexCount() / beta) {
+                bottomUp = false;
+            }
+
+            std::swap(scratch.frontier, scratch.nextFrontier);
+            return false;
+        }
+    };
+}
+
+bool labelConstrainedHybridBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target, const LabelSet &labelSet,
+                               TraversalScratch &scratch) {
+    if (source == target) {
+        return true;
+    }
+
+    if (labelSet.none()) {
+        return false;
+    }
+
+    SearchSide search(graph, labelSet, scratch, source, false);
+
+    while (!search.exhausted()) {
+        if (search.expand(nullptr, target)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool labelConstrainedHybridBiBFS(const LabeledEdgeGraph &graph, Vertex source, Vertex target,
+                                 const LabelSet &labelSet, TraversalScratch &forward, TraversalScratch &backward) {
+    if (source == target) {
+        return true;
+    }
+
+    if (labelSet.none()) {
+        return false;
+    }
+
+    SearchSide forwardSearch(graph, labelSet, forward, source, false);
+    SearchSide backwardSearch(graph, labelSet, backward, target, true);
+
+    while (!forwardSearch.exhausted() && !backwardSearch.exhausted()) {
+        if (forwardSearch.frontierEdges <= backwardSearch.frontierEdges) {
+            if (forwardSearch.expand(&backwardSearch, target)) {
+                return true;
+            }
+        } else if (backwardSearch.expand(&forwardSearch, source)) {
+            return true;
+        }
+    }
+
+    return false;
+}
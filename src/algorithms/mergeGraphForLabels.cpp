@@ -118,15 +118,9 @@ mergeGraphForLabels(const LabeledEdgeGraph &labeledGraph, const LabelSet &labelS
     std::vector<uint32_t> edges;
 
     edges.reserve(labeledGraph.getVertexCount());
-    size_t maxEdgeCount = 0;
 
-    for (auto label = 0u; label < labeledGraph.getLabelCount(); label++) {
-        if (!labelSet[label]) {
-            continue;
-        }
-
-        maxEdgeCount = std::max(maxEdgeCount, labeledGraph.getEdgeCount(label));
-    }
+    // The edge count of every label, counted while merging instead of a pass over all edges per label.
+    std::vector<size_t> labelEdgeCounts(labeledGraph.getLabelCount());
 
     if (labelSet.count() == 0) {
         return graph;
@@ -137,6 +131,7 @@ mergeGraphForLabels(const LabeledEdgeGraph &labeledGraph, const LabelSet &labelS
 
         while(it.next()) {
             auto& edge = *it;
+            labelEdgeCounts[edge.label]++;
 
             if (visited[edge.target]) {
                 continue;
@@ -147,10 +142,17 @@ mergeGraphForLabels(const LabeledEdgeGraph &labeledGraph, const LabelSet &labelS
         }
 
         graph->addEdgesNoChecks(source, edges);
+
+        // Only clear the bits that were set, clearing the whole set for every vertex is quadratic.
+        for (auto target : edges) {
+            visited[target] = false;
+        }
+
         edges.clear();
-        visited.reset();
     }
 
+    auto maxEdgeCount = *std::max_element(labelEdgeCounts.begin(), labelEdgeCounts.end());
+
     if (labelSet.count() > 1) {
         outStats.increase = (int64_t(maxEdgeCount) - int64_t(graph->getEdgeCount()));
         outStats.increasePercentage = double(outStats.increase) / double(maxEdgeCount) * 100.0;
@@ -84,6 +84,10 @@ void sccLabeledInnerGraphs(const LabeledEdgeGraph &labeledGraph, const SCCGraph
 
             if (innerGraph->getVertexCount() == 0) {
                 innerGraph->setSizes(labeledGraph.getVertexCount(), labeledGraph.getLabelCount(), 0);
+
+                if (labeledGraph.isLabelGrouped()) {
+                    innerGraph->groupByLabel();
+                }
             }
 
             innerGraph->addEdge(source, edge.target, edge.label);
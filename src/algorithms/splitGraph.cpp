@@ -19,6 +19,10 @@ splitGraph(const LabeledEdgeGraph &labeledGraph, const LabelSet &labels, const s
         }
     }
 
+    if (labeledGraph.isLabelGrouped()) {
+        graph->groupByLabel();
+    }
+
     graph->optimize();
     return graph;
 }
\ No newline at end of file
@@ -11,22 +11,7 @@ static inline size_t calculateDegree(const LabeledGraph &graph, Vertex vertex) {
 }
 
 static inline size_t calculateDegree(const LabeledEdgeGraph &graph, Vertex vertex) {
-    auto totalIncoming = 1u;
-    auto totalOutgoing = 1u;
-
-    auto it = graph.getConnected(vertex);
-
-    while (it.next()) {
-        totalOutgoing++;
-    }
-
-    auto revIt = graph.getReverseConnected(vertex);
-
-    while (revIt.next()) {
-        totalIncoming++;
-    }
-
-    return totalIncoming * totalOutgoing;
+    return (graph.getConnected(vertex).size() + 1) * (graph.getReverseConnected(vertex).size() + 1);
 }
 
 static inline size_t calculateDegree(const PerLabelGraph &graph, Vertex vertex) {
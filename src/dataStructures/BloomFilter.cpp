@@ -63,3 +63,43 @@ bool BloomFilterDynamic::contains(Vertex vertex) const {
     return true;
 }
 
+static uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33u;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33u;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33u;
+    return hash;
+}
+
+BlockedBloomFilter::Probe BlockedBloomFilter::probe(uint64_t key, uint32_t bits, uint32_t hashCount) {
+    auto blockHash = mixHash(key);
+    auto bitHash = mixHash(blockHash);
+
+    Probe probe;
+    probe.blockHash = uint32_t(blockHash >> 32u);
+
+    auto blockBits = uint64_t(blockWords(bits)) * 32;
+
+    // Double hashing, the i-th bit is h1 + i * h2 mapped onto the bits of a block.
+    auto first = uint32_t(bitHash);
+    auto second = uint32_t(bitHash >> 32u) | 1u;
+
+    for (auto i = 0u; i < hashCount; i++) {
+        auto bit = uint32_t((uint64_t(first + i * second) * blockBits) >> 32u);
+        probe.mask[bit >> 5u] |= 1u << (bit & 31u);
+    }
+
+    return probe;
+}
+
+BlockedBloomFilter &BlockedBloomFilter::operator |=(const BlockedBloomFilter &rhs) {
+    auto *words = blocks[0];
+    auto *otherWords = rhs.blocks.data();
+
+    for (auto i = 0u; i < blocks.size(); i++) {
+        words[i] |= otherWords[i];
+    }
+
+    return *this;
+}
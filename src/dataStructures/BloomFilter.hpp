@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graphs/Definitions.hpp"
+#include "dataStructures/BloomLabels.hpp"
 
 uint32_t hashFunc(uint32_t input);
 uint32_t hashFunc(uint32_t input, uint32_t index);
@@ -31,7 +32,7 @@ public:
 
     void add(Vertex vertex, const LabelSet &labelSet) {
         auto hash = boost::hash_value(vertex);
-        boost::hash_combine(hash, boost::hash_value(labelSet));
+        boost::hash_combine(hash, labelSet.hash());
 
         bitVector[hash % bitVector.size()] = true;
     }
@@ -92,7 +93,7 @@ public:
 
     [[nodiscard]] bool contains(Vertex vertex, const LabelSet &labelSet) const {
         auto hash = boost::hash_value(vertex);
-        boost::hash_combine(hash, boost::hash_value(labelSet));
+        boost::hash_combine(hash, labelSet.hash());
         return bitVector[hash % bitVector.size()];
     }
 
@@ -138,6 +139,14 @@ public:
     [[nodiscard]] size_t sizeInBytes() const {
         return bitVector.capacity() / 8;
     }
+
+    [[nodiscard]] const boost::dynamic_bitset<> &getBits() const {
+        return bitVector;
+    }
+
+    [[nodiscard]] boost::dynamic_bitset<> &getBits() {
+        return bitVector;
+    }
 };
 
 class BloomFilter2Hash {
@@ -256,4 +265,98 @@ public:
     [[nodiscard]] size_t sizeInBytes() const {
         return bitVector.capacity() / 8;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief a bloom filter with k hash functions, where all bits of a key are in the same block of at most 512 bits.
+ * A block fits in a single cache line, thus a lookup reads one cache line regardless of k.
+ *
+ * The bits of a key within a block only depend on the key, the block size and k. They are computed once as a probe,
+ * which can be tested against all filters of the same size, every test is a vectorized subset check of the block.
+ */
+class BlockedBloomFilter {
+public:
+    static constexpr uint32_t maxBlockWords = 16;
+
+    struct Probe {
+        uint32_t blockHash = 0;
+        uint32_t mask[maxBlockWords] = { };
+    };
+
+private:
+    BloomLabels blocks;
+    uint32_t hashCount = 1;
+
+    [[nodiscard]] uint32_t blockIndex(const Probe &probe) const {
+        return uint32_t((uint64_t(probe.blockHash) * blocks.getVertexCount()) >> 32u);
+    }
+
+public:
+    /**
+     * @brief the number of words in a block of a filter with the given number of bits.
+     */
+    [[nodiscard]] static uint32_t blockWords(uint32_t bits) {
+        return std::clamp((bits + 31) / 32, 1u, maxBlockWords);
+    }
+
+    /**
+     * @brief computes the block and bits of key, for filters with the given number of bits and hash functions.
+     */
+    [[nodiscard]] static Probe probe(uint64_t key, uint32_t bits, uint32_t hashCount);
+
+    /**
+     * @brief allocates the filter, the bits are rounded up to a whole number of blocks.
+     */
+    void setup(uint32_t bits, uint32_t hashFunctions) {
+        auto words = blockWords(bits);
+
+        hashCount = hashFunctions;
+        blocks.resize(((bits + 31) / 32 + words - 1) / words, words);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return blocks.size() == 0;
+    }
+
+    BlockedBloomFilter &operator |=(const BlockedBloomFilter &rhs);
+
+    [[nodiscard]] Probe probe(uint64_t key) const {
+        return probe(key, uint32_t(blocks.size() * 32), hashCount);
+    }
+
+    void add(const Probe &probe) {
+        auto *block = blocks[blockIndex(probe)];
+
+        for (auto i = 0u; i < blocks.getWords(); i++) {
+            block[i] |= probe.mask[i];
+        }
+    }
+
+    void add(uint64_t key) {
+        add(probe(key));
+    }
+
+    [[nodiscard]] bool contains(const Probe &probe) const {
+        return BloomLabels::isSubset(probe.mask, blocks[blockIndex(probe)], blocks.getWords());
+    }
+
+    [[nodiscard]] bool contains(uint64_t key) const {
+        return contains(probe(key));
+    }
+
+    [[nodiscard]] uint32_t getHashCount() const {
+        return hashCount;
+    }
+
+    [[nodiscard]] const BloomLabels &getBlocks() const {
+        return blocks;
+    }
+
+    [[nodiscard]] BloomLabels &getBlocks() {
+        return blocks;
+    }
+
+    [[nodiscard]] size_t sizeInBytes() const {
+        return blocks.sizeInBytes();
+    }
+};
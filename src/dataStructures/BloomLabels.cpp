@@ -0,0 +1,97 @@
+#include "BloomLabels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BLOOM_LABELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    using SubsetKernel = bool (*)(const uint32_t *subset, const uint32_t *superset, uint32_t words);
+
+    bool isSubsetScalar(const uint32_t *subset, const uint32_t *superset, uint32_t words) {
+        for (auto i = 0u; i < words; i++) {
+            if ((subset[i] & ~superset[i]) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+#ifdef BLOOM_LABELS_X86
+    __attribute__((target("sse4.1")))
+    bool isSubsetSSE4(const uint32_t *subset, const uint32_t *superset, uint32_t words) {
+        auto i = 0u;
+
+        for (; i + 4 <= words; i += 4) {
+            auto sub = _mm_loadu_si128(reinterpret_cast<const __m128i *>(subset + i));
+            auto super = _mm_loadu_si128(reinterpret_cast<const __m128i *>(superset + i));
+
+            // testc is set if all bits of sub are set in super.
+            if (!_mm_testc_si128(super, sub)) {
+                return false;
+            }
+        }
+
+        return isSubsetScalar(subset + i, superset + i, words - i);
+    }
+
+    __attribute__((target("avx2")))
+    bool isSubsetAVX2(const uint32_t *subset, const uint32_t *superset, uint32_t words) {
+        auto i = 0u;
+
+        for (; i + 8 <= words; i += 8) {
+            auto sub = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(subset + i));
+            auto super = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(superset + i));
+
+            if (!_mm256_testc_si256(super, sub)) {
+                return false;
+            }
+        }
+
+        if (i + 4 <= words) {
+            auto sub = _mm_loadu_si128(reinterpret_cast<const __m128i *>(subset + i));
+            auto super = _mm_loadu_si128(reinterpret_cast<const __m128i *>(superset + i));
+
+            if (!_mm_testc_si128(super, sub)) {
+                return false;
+            }
+
+            i += 4;
+        }
+
+        return isSubsetScalar(subset + i, superset + i, words - i);
+    }
+#endif
+
+    SubsetKernel selectSubsetKernel() {
+#ifdef BLOOM_LABELS_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2")) {
+            return isSubsetAVX2;
+        }
+
+        if (__builtin_cpu_supports("sse4.1")) {
+            return isSubsetSSE4;
+        }
+#endif
+
+        return isSubsetScalar;
+    }
+
+    const SubsetKernel subsetKernel = selectSubsetKernel();
+}
+
+void BloomLabels::resize(size_t vertices, uint32_t wordsPerVertex) {
+    words = wordsPerVertex;
+    vertexCount = vertices;
+
+    auto count = std::max(size_t(1), size());
+    elements.reset(new(std::align_val_t(alignment)) uint32_t[count]);
+    std::fill(elements.get(), elements.get() + count, 0u);
+}
+
+bool BloomLabels::isSubset(const uint32_t *subset, const uint32_t *superset, uint32_t words) {
+    return subsetKernel(subset, superset, words);
+}
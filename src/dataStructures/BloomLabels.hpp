@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @brief the bloom filter labels of all vertices, stored back to back in one aligned array.
+ * Every vertex owns a row of words 32 bit words, the row of a vertex starts at vertex * words.
+ */
+class BloomLabels {
+private:
+    static constexpr size_t alignment = 64;
+
+    struct AlignedDelete {
+        void operator ()(uint32_t *pointer) const {
+            ::operator delete[](pointer, std::align_val_t(alignment));
+        }
+    };
+
+    std::unique_ptr<uint32_t[], AlignedDelete> elements;
+
+    uint32_t words = 0;
+    size_t vertexCount = 0;
+
+public:
+    /**
+     * @brief allocates the rows of vertices vertices, all words are cleared.
+     */
+    void resize(size_t vertices, uint32_t wordsPerVertex);
+
+    [[nodiscard]] uint32_t *operator [](size_t vertex) {
+        return elements.get() + vertex * words;
+    }
+
+    [[nodiscard]] const uint32_t *operator [](size_t vertex) const {
+        return elements.get() + vertex * words;
+    }
+
+    [[nodiscard]] const uint32_t *data() const {
+        return elements.get();
+    }
+
+    [[nodiscard]] uint32_t getWords() const {
+        return words;
+    }
+
+    [[nodiscard]] size_t getVertexCount() const {
+        return vertexCount;
+    }
+
+    /**
+     * @brief the number of words in all rows together.
+     */
+    [[nodiscard]] size_t size() const {
+        return vertexCount * words;
+    }
+
+    [[nodiscard]] size_t sizeInBytes() const {
+        return size() * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief returns whether every bit set in subset is also set in superset, both rows hold words words.
+     * Uses AVX2 or SSE4.1 when the processor supports it, the kernel is selected once at startup.
+     */
+    static bool isSubset(const uint32_t *subset, const uint32_t *superset, uint32_t words);
+};
@@ -0,0 +1,71 @@
+#include "CombinationRanking.hpp"
+
+CombinationRanking::CombinationRanking(uint32_t labelCount, uint32_t minSize, uint32_t maxSize) : labelCount(
+        labelCount), minSize(minSize), maxSize(maxSize) {
+    if (maxSize < minSize) {
+        std::cerr << "Combinations of at most " << maxSize << " labels cannot be ranked from " << minSize
+                  << " labels!" << std::fatal;
+    }
+
+    binomials.resize(size_t(labelCount + 1) * (maxSize + 1));
+
+    // Pascal's triangle, cut off after maxSize. Entries with k > n stay 0.
+    for (auto n = 0u; n <= labelCount; n++) {
+        binomials[size_t(n) * (maxSize + 1)] = 1;
+
+        for (auto k = 1u; k <= std::min(n, maxSize); k++) {
+            binomials[size_t(n) * (maxSize + 1) + k] = binomial(n - 1, k - 1) + binomial(n - 1, k);
+        }
+    }
+
+    offsets.resize(maxSize - minSize + 2);
+
+    for (auto setSize = minSize; setSize <= maxSize; setSize++) {
+        auto count = setSize <= labelCount ? binomial(labelCount, setSize) : 0;
+        offsets[setSize - minSize + 1] = offsets[setSize - minSize] + count;
+    }
+}
+
+size_t CombinationRanking::rank(const LabelSet &labelSet) const {
+    auto setSize = uint32_t(labelSet.count());
+
+    if (offsets.empty() || setSize < minSize || setSize > maxSize) {
+        return npos;
+    }
+
+    size_t rank = offset(setSize);
+    uint32_t position = 0;
+
+    for (auto label = 0u; label < labelCount && position < setSize; label++) {
+        if (labelSet[label]) {
+            rank += binomial(label, ++position);
+        }
+    }
+
+    return rank;
+}
+
+LabelSet CombinationRanking::unrank(size_t rank) const {
+    auto setSize = minSize;
+
+    while (offsets[setSize - minSize + 1] <= rank) {
+        setSize++;
+    }
+
+    rank -= offset(setSize);
+
+    LabelSet labelSet(labelCount);
+    auto label = labelCount;
+
+    // The largest label first, it is the largest label whose binomial does not exceed the rank.
+    for (auto position = setSize; position > 0; position--) {
+        do {
+            label--;
+        } while (binomial(label, position) > rank);
+
+        labelSet.set(label);
+        rank -= binomial(label, position);
+    }
+
+    return labelSet;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "graphs/LabelSet.hpp"
+
+/**
+ * @brief ranks the label sets of minSize up to maxSize labels out of labelCount labels densely, by the combinatorial
+ * number system. The sets of one size are ranked in colex order, the sizes follow each other.
+ * The sorted labels l_1 < ... < l_s of a set have the rank offset(s) + sum of (l_i choose i).
+ */
+class CombinationRanking {
+private:
+    uint32_t labelCount = 0;
+    uint32_t minSize = 0;
+    uint32_t maxSize = 0;
+
+    // (n choose k) at n * (maxSize + 1) + k, for every n <= labelCount and k <= maxSize.
+    std::vector<size_t> binomials;
+
+    // The rank of the first set of every size, from minSize up to one past maxSize.
+    std::vector<size_t> offsets;
+
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief ranks no label sets at all.
+     */
+    CombinationRanking() = default;
+
+    /**
+     * @brief requires minSize <= maxSize.
+     */
+    CombinationRanking(uint32_t labelCount, uint32_t minSize, uint32_t maxSize);
+
+    /**
+     * @brief n choose k, for n <= labelCount and k <= maxSize.
+     */
+    [[nodiscard]] size_t binomial(uint32_t n, uint32_t k) const {
+        return binomials[size_t(n) * (maxSize + 1) + k];
+    }
+
+    /**
+     * @brief the rank of the first set of setSize labels.
+     */
+    [[nodiscard]] size_t offset(uint32_t setSize) const {
+        return offsets[setSize - minSize];
+    }
+
+    /**
+     * @brief the number of ranked sets, all ranks are below it.
+     */
+    [[nodiscard]] size_t size() const {
+        return offsets.empty() ? 0 : offsets.back();
+    }
+
+    /**
+     * @brief the rank of labelSet, or npos if its number of labels is not ranked.
+     */
+    [[nodiscard]] size_t rank(const LabelSet &labelSet) const;
+
+    /**
+     * @brief the label set of a rank below size().
+     */
+    [[nodiscard]] LabelSet unrank(size_t rank) const;
+};
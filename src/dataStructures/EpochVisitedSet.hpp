@@ -0,0 +1,87 @@
+#pragma once
+
+#include "graphs/Definitions.hpp"
+
+/**
+ * @brief a visited set over the vertices of a graph, which is cleared in constant time.
+ * Every vertex stores the epoch in which it was last visited, a vertex is visited if its epoch is newer than the base
+ * of the current traversal. Clearing the set moves the base past all used epochs, only when the epochs wrap around
+ * the marks are actually zeroed. Level synchronous traversals use a new epoch per level, to tell the levels apart.
+ */
+class EpochVisitedSet {
+private:
+    std::vector<uint32_t> marks;
+    uint32_t base = 0;
+    uint32_t epoch = 0;
+
+public:
+    /**
+     * @brief clears the set, such that it can hold the given number of vertices and be used for the given number of
+     * levels.
+     */
+    void reset(size_t vertexCount, uint32_t levels = 1) {
+        if (marks.size() < vertexCount) {
+            marks.resize(vertexCount, 0);
+        }
+
+        if (epoch > std::numeric_limits<uint32_t>::max() - levels) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 0;
+        }
+
+        base = epoch;
+        epoch++;
+    }
+
+    /**
+     * @brief starts the next level, vertices are visited at this level from now on.
+     */
+    void nextLevel() {
+        epoch++;
+    }
+
+    /**
+     * @brief the level at which the vertex was visited, the first level is 1. Zero if it was not visited.
+     */
+    [[nodiscard]] uint32_t level(Vertex vertex) const {
+        return marks[vertex] > base ? marks[vertex] - base : 0;
+    }
+
+    [[nodiscard]] uint32_t currentLevel() const {
+        return epoch - base;
+    }
+
+    [[nodiscard]] bool operator [](Vertex vertex) const {
+        return marks[vertex] > base;
+    }
+
+    void set(Vertex vertex) {
+        marks[vertex] = epoch;
+    }
+
+    /**
+     * @brief marks the vertex as visited, returns false if it already was visited.
+     */
+    bool insert(Vertex vertex) {
+        if (marks[vertex] > base) {
+            return false;
+        }
+
+        marks[vertex] = epoch;
+        return true;
+    }
+
+    /**
+     * @brief marks all vertices in the bitset as visited.
+     */
+    void insertAll(const boost::dynamic_bitset<> &vertices) {
+        for (auto vertex = vertices.find_first(); vertex != boost::dynamic_bitset<>::npos;
+             vertex = vertices.find_next(vertex)) {
+            marks[vertex] = epoch;
+        }
+    }
+
+    [[nodiscard]] size_t sizeInBytes() const {
+        return marks.capacity() * sizeof(uint32_t);
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @brief a read only array, which either owns its elements or views them in a mapped file.
+ * A mapped array keeps the file alive, such that an index loaded from a file can use its arrays without copying.
+ */
+template<typename T>
+class MappedArray {
+private:
+    std::vector<T> owned;
+
+    const T *elements = nullptr;
+    size_t count = 0;
+
+    std::shared_ptr<const void> mapping;
+
+public:
+    MappedArray() = default;
+
+    MappedArray(const MappedArray &) = delete;
+    MappedArray(MappedArray &&) noexcept = default;
+
+    MappedArray &operator =(const MappedArray &) = delete;
+    MappedArray &operator =(MappedArray &&) noexcept = default;
+
+    /**
+     * @brief takes ownership of the elements, releases the mapped file if any.
+     */
+    void assign(std::vector<T> &&values) {
+        owned = std::move(values);
+        elements = owned.data();
+        count = owned.size();
+        mapping = nullptr;
+    }
+
+    /**
+     * @brief views count elements owned by the mapping, which is kept alive as long as the array views it.
+     */
+    void map(const T *data, size_t size, std::shared_ptr<const void> keepAlive) {
+        owned.clear();
+        owned.shrink_to_fit();
+
+        elements = data;
+        count = size;
+        mapping = std::move(keepAlive);
+    }
+
+    [[nodiscard]] bool isMapped() const {
+        return mapping != nullptr;
+    }
+
+    [[nodiscard]] const T &operator [](size_t index) const {
+        return elements[index];
+    }
+
+    [[nodiscard]] const T *data() const {
+        return elements;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return count == 0;
+    }
+
+    [[nodiscard]] const T &back() const {
+        return elements[count - 1];
+    }
+};
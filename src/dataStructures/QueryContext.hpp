@@ -0,0 +1,82 @@
+#pragma once
+
+#include "graphs/Definitions.hpp"
+#include "EpochVisitedSet.hpp"
+#include "RingQueue.hpp"
+
+/**
+ * @brief scratch space used by a single traversal during a query.
+ */
+struct TraversalScratch {
+    EpochVisitedSet visited;
+    RingQueue<Vertex> queue;
+
+    // Level synchronous traversals keep the current and the next frontier as lists.
+    std::vector<Vertex> frontier;
+    std::vector<Vertex> nextFrontier;
+
+    /**
+     * @brief clears the visited set and queue for a traversal over the given number of vertices.
+     * Takes constant time, such that a traversal only pays for the part of the graph it explores.
+     */
+    void prepareVisited(size_t vertexCount) {
+        visited.reset(vertexCount);
+        queue.clear();
+    }
+};
+
+/**
+ * @brief caller owned state for running queries, one context per thread.
+ * Indexes are queried through const methods, all scratch space they need is leased from the context.
+ * Leases are handed out in a stack like fashion, such that an index querying a nested index inside a traversal
+ * receives separate scratch space. The scratch space is kept between queries and thus reused.
+ */
+class QueryContext {
+private:
+    std::vector<std::unique_ptr<TraversalScratch>> scratches;
+    uint32_t inUse = 0;
+
+public:
+    class Lease {
+    private:
+        QueryContext *context;
+        TraversalScratch *scratch;
+
+    public:
+        Lease(QueryContext *context, TraversalScratch *scratch) : context(context), scratch(scratch) { }
+
+        Lease(const Lease &) = delete;
+        Lease &operator =(const Lease &) = delete;
+
+        ~Lease() {
+            context->inUse--;
+        }
+
+        TraversalScratch &operator *() const {
+            return *scratch;
+        }
+
+        TraversalScratch *operator ->() const {
+            return scratch;
+        }
+    };
+
+    QueryContext() = default;
+
+    QueryContext(const QueryContext &) = delete;
+    QueryContext(QueryContext &&) = default;
+
+    QueryContext &operator =(const QueryContext &) = delete;
+    QueryContext &operator =(QueryContext &&) = default;
+
+    [[nodiscard]] Lease acquire() {
+        if (inUse == scratches.size()) {
+            scratches.emplace_back(std::make_unique<TraversalScratch>());
+        }
+
+        auto *scratch = scratches[inUse].get();
+        inUse++;
+
+        return Lease(this, scratch);
+    }
+};
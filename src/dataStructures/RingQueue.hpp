@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ * @brief a double ended queue stored in a single ring buffer.
+ * Unlike std::deque, clearing the queue keeps its buffer, such that a reused queue does not allocate.
+ * The capacity is always a power of two, such that wrapping around is a mask.
+ */
+template<typename T>
+class RingQueue {
+private:
+    std::vector<T> buffer;
+
+    size_t head = 0;
+    size_t count = 0;
+    size_t mask = 0;
+
+    void grow() {
+        auto capacity = std::max<size_t>(16, buffer.size() * 2);
+        std::vector<T> resized(capacity);
+
+        for (size_t i = 0; i < count; i++) {
+            resized[i] = std::move(buffer[(head + i) & mask]);
+        }
+
+        buffer = std::move(resized);
+        head = 0;
+        mask = capacity - 1;
+    }
+
+public:
+    [[nodiscard]] bool empty() const {
+        return count == 0;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    void emplace_back(const T &value) {
+        if (count == buffer.size()) {
+            grow();
+        }
+
+        buffer[(head + count) & mask] = value;
+        count++;
+    }
+
+    void emplace_front(const T &value) {
+        if (count == buffer.size()) {
+            grow();
+        }
+
+        head = (head - 1) & mask;
+        buffer[head] = value;
+        count++;
+    }
+
+    [[nodiscard]] T &front() {
+        return buffer[head];
+    }
+
+    [[nodiscard]] T &back() {
+        return buffer[(head + count - 1) & mask];
+    }
+
+    void pop_front() {
+        head = (head + 1) & mask;
+        count--;
+    }
+
+    void pop_back() {
+        count--;
+    }
+};
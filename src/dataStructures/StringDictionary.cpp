@@ -0,0 +1,135 @@
+#include "StringDictionary.hpp"
+
+static uint32_t hashString(std::string_view value) {
+    auto hash = std::hash<std::string_view>()(value);
+    return uint32_t(hash ^ (hash >> 32u));
+}
+
+const char *StringDictionary::store(std::string_view value) {
+    if (value.size() > pageSize) {
+        // Strings larger than a page get an allocation of their own, the current page stays in use.
+        auto &allocation = largeStrings.emplace_back(new char[value.size()]);
+        std::copy(value.begin(), value.end(), allocation.get());
+
+        largeBytes += value.size();
+        return allocation.get();
+    }
+
+    if (pages.empty() || pageUsed + value.size() > pageSize) {
+        pages.emplace_back(new char[pageSize]);
+        pageUsed = 0;
+    }
+
+    auto *start = pages.back().get() + pageUsed;
+    std::copy(value.begin(), value.end(), start);
+    pageUsed += value.size();
+
+    return start;
+}
+
+void StringDictionary::grow() {
+    table.assign(std::max(size_t(1024), table.size() * 2), emptySlot);
+
+    for (uint32_t id = 0; id < starts.size(); id++) {
+        auto slot = hashes[id] & (table.size() - 1);
+
+        while (table[slot] != emptySlot) {
+            slot = (slot + 1) & (table.size() - 1);
+        }
+
+        table[slot] = id;
+    }
+}
+
+size_t StringDictionary::findSlot(std::string_view value, uint32_t hash) const {
+    auto slot = hash & (table.size() - 1);
+
+    while (table[slot] != emptySlot) {
+        auto id = table[slot];
+
+        if (hashes[id] == hash && (*this)[id] == value) {
+            return slot;
+        }
+
+        slot = (slot + 1) & (table.size() - 1);
+    }
+
+    return slot;
+}
+
+uint32_t StringDictionary::insert(std::string_view value) {
+    if ((starts.size() + 1) * 2 > table.size()) {
+        grow();
+    }
+
+    auto hash = hashString(value);
+    auto slot = findSlot(value, hash);
+
+    if (table[slot] != emptySlot) {
+        return table[slot];
+    }
+
+    if (starts.size() == emptySlot) {
+        std::cerr << "String dictionary is full! Size: " << starts.size() << std::fatal;
+    }
+
+    auto id = uint32_t(starts.size());
+
+    starts.emplace_back(store(value));
+    lengths.emplace_back(uint32_t(value.size()));
+    hashes.emplace_back(hash);
+
+    table[slot] = id;
+    return id;
+}
+
+bool StringDictionary::find(std::string_view value, uint32_t &id) const {
+    if (table.empty()) {
+        return false;
+    }
+
+    id = table[findSlot(value, hashString(value))];
+    return id != emptySlot;
+}
+
+size_t StringDictionary::getSizeInBytes() const {
+    auto size = sizeof(StringDictionary) + pages.size() * pageSize + largeBytes;
+
+    size += starts.capacity() * sizeof(const char *);
+    size += (lengths.capacity() + hashes.capacity() + table.capacity()) * sizeof(uint32_t);
+
+    return size;
+}
+
+bool StringDictionary::write(const std::string &filePath) const {
+    std::ofstream file { filePath, std::ios::binary };
+
+    if (file.fail()) {
+        std::cerr << "Failed to open file: " << filePath << " for write" << std::fatal;
+        return false;
+    }
+
+    for (auto id = 0u; id < starts.size(); id++) {
+        file.write(starts[id], lengths[id]);
+        file.put('\n');
+    }
+
+    std::flush(file);
+    return !file.fail();
+}
+
+bool StringDictionary::read(const std::string &filePath) {
+    std::ifstream file { filePath, std::ios::binary };
+
+    if (file.fail()) {
+        return false;
+    }
+
+    std::string line;
+
+    while (std::getline(file, line)) {
+        insert(line);
+    }
+
+    return true;
+}
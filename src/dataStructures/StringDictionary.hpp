@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @brief assigns dense ids to strings, in the order in which they are first inserted.
+ * The characters are stored back to back in large pages, the lookup table only holds ids. Thus an entry costs its
+ * characters plus roughly 20 bytes, instead of a std::string, a hash node and its bucket.
+ *
+ * A dictionary can be written to a file with one string per line, the line number being its id. Strings may therefore
+ * not contain newlines, as is the case for escaped n-triples terms.
+ */
+class StringDictionary {
+private:
+    static constexpr size_t pageSize = 1u << 24u;
+    static constexpr uint32_t emptySlot = std::numeric_limits<uint32_t>::max();
+
+    std::vector<std::unique_ptr<char[]>> pages;
+    size_t pageUsed = 0;
+
+    std::vector<std::unique_ptr<char[]>> largeStrings;
+    size_t largeBytes = 0;
+
+    std::vector<const char *> starts;
+    std::vector<uint32_t> lengths;
+    std::vector<uint32_t> hashes;
+
+    // Open addressing table of ids, its size is a power of two and it is kept at most half full.
+    std::vector<uint32_t> table;
+
+    const char *store(std::string_view value);
+
+    void grow();
+
+    [[nodiscard]] size_t findSlot(std::string_view value, uint32_t hash) const;
+
+public:
+    /**
+     * @brief returns the id of the string, a new id is assigned if the string was not inserted before.
+     */
+    uint32_t insert(std::string_view value);
+
+    /**
+     * @brief looks up the id of the string, returns false if the string was never inserted.
+     */
+    [[nodiscard]] bool find(std::string_view value, uint32_t &id) const;
+
+    [[nodiscard]] std::string_view operator [](uint32_t id) const {
+        return { starts[id], lengths[id] };
+    }
+
+    [[nodiscard]] size_t size() const {
+        return starts.size();
+    }
+
+    [[nodiscard]] size_t getSizeInBytes() const;
+
+    bool write(const std::string &filePath) const;
+    bool read(const std::string &filePath);
+};
@@ -5,6 +5,7 @@
 #include <io/QueryReader.hpp>
 #include <io/GraphReader.hpp>
 #include <utility/CategorizedStepTimer.hpp>
+#include <threading/ThreadPool.hpp>
 #include "LCRQueriesRunner.hpp"
 
 namespace lcr {
@@ -24,6 +25,30 @@ namespace lcr {
         }
     }
 
+    void load(const std::vector<std::unique_ptr<Index>> &indices, const std::string &filePath) {
+        std::cout << "\nLoading timings:" << std::endl;
+
+        for (auto &index : indices) {
+            memoryWatch.begin();
+            timer.begin(index->getName());
+            index->load(filePath);
+            timer.endSameLine();
+            memoryWatch.endSameLine();
+            std::cout << std::endl;
+        }
+    }
+
+    void save(const std::vector<std::unique_ptr<Index>> &indices, const std::string &filePath) {
+        timer.begin("Save index");
+
+        for (auto &index : indices) {
+            index->save(filePath);
+        }
+
+        timer.endSameLine();
+        std::cout << std::endl;
+    }
+
     void printStats(const std::vector<std::unique_ptr<Index>> &indices) {
         std::cout << "\nIndexes used:" << std::endl;
 
@@ -60,8 +85,7 @@ namespace lcr {
         }
     }
 
-    void query(Index &truthIndex, std::vector<std::unique_ptr<Index>> &indices, const std::string &fileName,
-               LCRQuerySet &queries) {
+    boost::dynamic_bitset<> evaluateTruths(Index &truthIndex, const std::string &fileName, const LCRQuerySet &queries) {
         boost::dynamic_bitset<> truths(queries.size());
 
         for (auto i = 0u; i < queries.size(); i++) {
@@ -79,6 +103,13 @@ namespace lcr {
         std::cout << "not reachable  = " << totalFalse << "\n";
         std::cout << "used evaluator = " << truthIndex.getName() << "\n";
 
+        return truths;
+    }
+
+    void query(Index &truthIndex, std::vector<std::unique_ptr<Index>> &indices, const std::string &fileName,
+               LCRQuerySet &queries) {
+        auto truths = evaluateTruths(truthIndex, fileName, queries);
+
         std::cout << "\nQuery timings: " << std::endl;
         CategorizedStepTimer stepTimer;
 
@@ -111,6 +142,142 @@ namespace lcr {
         }
     }
 
+    /**
+     * @brief splits the queries in groups that share the same source and label set.
+     * Returns the evaluation order of the queries, and the [start, end) range of each group in that order.
+     */
+    static std::vector<uint32_t>
+    groupQueries(const LCRQuerySet &queries, std::vector<std::pair<uint32_t, uint32_t>> &groups) {
+        std::vector<uint32_t> order(queries.size());
+        std::iota(order.begin(), order.end(), 0u);
+
+        std::sort(order.begin(), order.end(), [&queries](uint32_t left, uint32_t right) {
+            if (queries[left].source != queries[right].source) {
+                return queries[left].source < queries[right].source;
+            }
+
+            return queries[left].labelSet < queries[right].labelSet;
+        });
+
+        for (auto start = 0u; start < order.size();) {
+            auto &first = queries[order[start]];
+            auto end = start + 1;
+
+            while (end < order.size() && queries[order[end]].source == first.source &&
+                   queries[order[end]].labelSet == first.labelSet) {
+                end++;
+            }
+
+            groups.emplace_back(start, end);
+            start = end;
+        }
+
+        return order;
+    }
+
+    static void printLatency(std::ostream &out, const std::string &name, std::vector<double> &latencies,
+                             double percentile) {
+        auto position = size_t(percentile * double(latencies.size() - 1));
+        std::nth_element(latencies.begin(), latencies.begin() + position, latencies.end());
+
+        out << " " << name << ": ";
+        formatTime(out, latencies[position]);
+    }
+
+    void queryBatch(std::vector<std::unique_ptr<Index>> &indices, const std::string &fileName,
+                    const LCRQuerySet &queries, const boost::dynamic_bitset<> *truths) {
+        if (queries.empty()) {
+            return;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> groups;
+        auto order = groupQueries(queries, groups);
+
+        auto &threadPool = getThreadPool();
+        auto numThreads = threadPool.getNumThreads();
+
+        // Hand out several groups per work item, such that the dispatch overhead is spread over many queries.
+        auto groupsPerWork = std::max<size_t>(1, groups.size() / (size_t(numThreads) * 16));
+
+        std::cout << "\nBatch query timings: " << fileName << " (" << groups.size() << " groups, " << numThreads
+                  << " threads)" << std::endl;
+
+        for (auto &index : indices) {
+            std::vector<QueryContext> contexts(numThreads);
+            std::vector<uint8_t> results(queries.size());
+
+            // Latency of a query is the time spent on its group, divided over the queries in the group.
+            std::vector<double> latencies(queries.size());
+            std::vector<std::function<void(uint32_t id)>> workGroup;
+
+            for (size_t begin = 0; begin < groups.size(); begin += groupsPerWork) {
+                auto end = std::min(groups.size(), begin + groupsPerWork);
+
+                workGroup.emplace_back([&, begin, end](uint32_t id) {
+                    std::vector<const LCRQuery *> group;
+                    std::vector<uint8_t> groupResults;
+
+                    for (auto g = begin; g < end; g++) {
+                        auto [start, stop] = groups[g];
+
+                        group.clear();
+
+                        for (auto i = start; i < stop; i++) {
+                            group.emplace_back(&queries[order[i]]);
+                        }
+
+                        groupResults.assign(group.size(), 0u);
+
+                        auto groupStart = std::chrono::steady_clock::now();
+                        index->queryGroup(group, groupResults, contexts[id]);
+                        auto groupEnd = std::chrono::steady_clock::now();
+
+                        auto latency = std::chrono::duration<double, std::nano>(groupEnd - groupStart).count() /
+                                       double(group.size());
+
+                        for (auto i = start; i < stop; i++) {
+                            results[order[i]] = groupResults[i - start];
+                            latencies[order[i]] = latency;
+                        }
+                    }
+                });
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            threadPool.queueWorkGroup(workGroup)->waitTillCompleted();
+            auto end = std::chrono::steady_clock::now();
+
+            auto totalNs = std::chrono::duration<double, std::nano>(end - start).count();
+            auto queriesPerSecond = double(queries.size()) / (totalNs / 1e9);
+
+            formatWidth(std::cout, index->getName(), 50);
+            std::cout << "took: ";
+            formatTime(std::cout, totalNs);
+            std::cout << " qps: " << uint64_t(queriesPerSecond);
+
+            printLatency(std::cout, "p50", latencies, 0.5);
+            printLatency(std::cout, "p90", latencies, 0.9);
+            printLatency(std::cout, "p99", latencies, 0.99);
+            printLatency(std::cout, "max", latencies, 1.0);
+            std::cout << std::endl;
+
+            if (truths == nullptr) {
+                continue;
+            }
+
+            for (auto i = 0u; i < queries.size(); i++) {
+                bool result = results[i] != 0;
+
+                if (result == (*truths)[i]) {
+                    continue;
+                }
+
+                std::cout << "    query: " << queries[i] << " result: " << (result ? "true" : "false")
+                          << " expected: " << ((*truths)[i] ? "true" : "false") << "\n";
+            }
+        }
+    }
+
     std::unique_ptr<LCRQuerySet> readQueries(const std::string &queryFile) {
         auto queryReader = QueryReader::createQueryReader();
         auto queries = queryReader->readLabeledQueries(queryFile);
@@ -123,6 +290,9 @@ namespace lcr {
         memoryWatch.begin();
         timer.begin("Read graph");
         auto graph = graphReader->readLabeledEdgeGraph(graphFile);
+
+        // Label constrained traversals only touch the edges of the allowed labels.
+        graph->groupByLabel();
         timer.endSameLine();
         memoryWatch.end();
 
@@ -164,7 +334,15 @@ namespace lcr {
             controlIndex->train();
         }
 
-        train(indices);
+        if (loadIndexFile.empty()) {
+            train(indices);
+        } else {
+            load(indices, loadIndexFile);
+        }
+
+        if (!saveIndexFile.empty()) {
+            save(indices, saveIndexFile);
+        }
 
         std::vector<std::pair<std::string, std::shared_ptr<LCRQuerySet>>> querySets;
 
@@ -181,7 +359,14 @@ namespace lcr {
         printStats(indices);
 
         for (auto &queryPair : querySets) {
-            if (hasControl) {
+            if (batchMode) {
+                if (hasControl) {
+                    auto truths = evaluateTruths(*controlIndex, queryPair.first, *queryPair.second);
+                    queryBatch(indices, queryPair.first, *queryPair.second, &truths);
+                } else {
+                    queryBatch(indices, queryPair.first, *queryPair.second, nullptr);
+                }
+            } else if (hasControl) {
                 query(*controlIndex, indices, queryPair.first, *queryPair.second);
             } else {
                 query(indices, queryPair.first, *queryPair.second);
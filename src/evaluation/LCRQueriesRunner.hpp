@@ -12,6 +12,11 @@ namespace lcr {
 
         std::unique_ptr<Limit> limit = nullptr;
 
+        bool batchMode = false;
+
+        std::string loadIndexFile;
+        std::string saveIndexFile;
+
     public:
 
         void setControlIndex(std::unique_ptr<Index> &&index) {
@@ -26,6 +31,27 @@ namespace lcr {
             limit = std::move(lim);
         }
 
+        /**
+         * @brief evaluates the query sets over the thread pool, grouped by source and label set.
+         */
+        void setBatchMode(bool batch) {
+            batchMode = batch;
+        }
+
+        /**
+         * @brief loads the trained index from the file instead of training it.
+         */
+        void setLoadIndexFile(std::string filePath) {
+            loadIndexFile = std::move(filePath);
+        }
+
+        /**
+         * @brief saves the index to the file after training.
+         */
+        void setSaveIndexFile(std::string filePath) {
+            saveIndexFile = std::move(filePath);
+        }
+
         void run(std::string &graphFile, const std::vector<std::string>& queryFiles);
     };
 }
\ No newline at end of file
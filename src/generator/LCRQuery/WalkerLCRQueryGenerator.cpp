@@ -38,7 +38,7 @@ void WalkerLCRQueryGenerator::generate(uint32_t numQueries, uint32_t labelCount,
                 continue;
             }
 
-            auto &nextPos = selectNextStrategy(labeledGraph, outgoingIt, true);
+            auto nextPos = selectNextStrategy(labeledGraph, outgoingIt, true);
             pathStack.emplace_back(nextPos);
             currentForwardPos = nextPos.target;
 
@@ -61,7 +61,7 @@ void WalkerLCRQueryGenerator::generate(uint32_t numQueries, uint32_t labelCount,
                 continue;
             }
 
-            auto &nextPos = selectNextStrategy(labeledGraph, incomingIt, false);
+            auto nextPos = selectNextStrategy(labeledGraph, incomingIt, false);
             pathStack.emplace_front(nextPos);
             currentBackwardPos = nextPos.target;
 
@@ -118,7 +118,7 @@ Vertex WalkerLCRQueryGenerator::defaultPlacementStrategy(const LabeledEdgeGraph
     return distribution(randomEngine);
 }
 
-const Edge &
+Edge
 WalkerLCRQueryGenerator::defaultSelectNextStrategy(const LabeledEdgeGraph &labeledGraph, const LabeledEdgeGraphIterator &next,
                                                    bool isForward) {
     std::uniform_int_distribution<Vertex> distribution(0, next.size() - 1);
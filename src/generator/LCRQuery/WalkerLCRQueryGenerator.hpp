@@ -13,7 +13,7 @@ private:
 private:
     // Strategies
     std::function<Vertex(const LabeledEdgeGraph &)> placementStrategy;
-    std::function<const Edge &(const LabeledEdgeGraph &, const LabeledEdgeGraphIterator &, bool)> selectNextStrategy;
+    std::function<Edge(const LabeledEdgeGraph &, const LabeledEdgeGraphIterator &, bool)> selectNextStrategy;
     std::function<bool(const LabeledEdgeGraph &, const Edge &, const std::deque<Edge> &, LCRQuery &, bool,
                        uint32_t)> emitQueryStrategy;
 
@@ -48,7 +48,7 @@ public:
     }
 
     void setSelectNextStrategy(
-            std::function<const Edge &(const LabeledEdgeGraph &, const LabeledEdgeGraphIterator &, bool)> strategy) {
+            std::function<Edge(const LabeledEdgeGraph &, const LabeledEdgeGraphIterator &, bool)> strategy) {
         selectNextStrategy = std::move(strategy);
     }
 
@@ -81,7 +81,7 @@ private:
 
     static bool defaultShouldResetStrategy(const LabeledEdgeGraph &labeledGraph, const std::deque<Edge> &pathStack);
 
-    static const Edge &
+    static Edge
     defaultSelectNextStrategy(const LabeledEdgeGraph &labeledGraph, const LabeledEdgeGraphIterator &nextVertices, bool isForward);
 
     static bool defaultEmitQueryStrategy(const LabeledEdgeGraph &labeledGraph, const Edge &visitingVertex,
@@ -1,6 +1,7 @@
 #include <io/GraphReader.hpp>
 #include <graphs/SCCGraph.hpp>
 #include "io/GraphWriter.hpp"
+#include "io/graphReader/RdfGraphReader.hpp"
 #include "utility/Timer.hpp"
 #include "Selector.hpp"
 
@@ -22,7 +23,8 @@ void printGraphStats(LabeledEdgeGraph &graph) {
 
 int main(int argc, char **argv) {
     if (argc < 1) {
-        std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--graphFileOut] [graphFileOut] " << std::endl;
+        std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--graphFileOut] [graphFileOut] "
+                     "[--dictionaryOut] [dictionaryFileOut]" << std::endl;
         return 1;
     }
 
@@ -30,6 +32,7 @@ int main(int argc, char **argv) {
 
     std::string graphFileIn;
     std::string graphFileOut;
+    std::string dictionaryFileOut;
 
     for (int i = 1; i < argc; i++) {
         std::string content(argv[i]);
@@ -57,10 +60,16 @@ int main(int argc, char **argv) {
                 }
 
                 graphFileOut = argv[++i];
+            } else if (content == "--dictionaryOut") {
+                if (i + 1 >= argc) {
+                    std::cerr << "expected dictionary file name after --dictionaryOut" << std::fatal;
+                }
+
+                dictionaryFileOut = argv[++i];
             } else {
                 std::cerr << "unrecognized switch: " << content << std::endl;
                 std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--graphFileOut] [graphFileOut] "
-                          << std::endl;
+                             "[--dictionaryOut] [dictionaryFileOut]" << std::endl;
             }
         }
     }
@@ -72,11 +81,29 @@ int main(int argc, char **argv) {
         //graphFileIn =  "./../workload/generated/erV100kD3L64exp.nt" ;
     }
 
-    auto graphReader = GraphReader::createGraphReader();
+    std::unique_ptr<LabeledEdgeGraph> graph;
+
+    if (!dictionaryFileOut.empty()) {
+        // Only rdf files name their vertices and labels, the dictionaries map the ids back to those names.
+        StringDictionary vertices;
+        StringDictionary labels;
+
+        timer.begin("reading graph");
+        graph = RdfGraphReader().readLabeledEdgeGraph(graphFileIn, vertices, labels);
+        graph->optimize();
+        timer.end();
+
+        timer.begin("writing dictionaries");
+        vertices.write(dictionaryFileOut + ".vertices");
+        labels.write(dictionaryFileOut + ".labels");
+        timer.end();
+    } else {
+        auto graphReader = GraphReader::createGraphReader();
 
-    timer.begin("reading graph");
-    auto graph = graphReader->readLabeledEdgeGraph(graphFileIn);
-    timer.end();
+        timer.begin("reading graph");
+        graph = graphReader->readLabeledEdgeGraph(graphFileIn);
+        timer.end();
+    }
 
     if (printStats) {
         printGraphStats(*graph);
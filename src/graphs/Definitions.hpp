@@ -1,12 +1,13 @@
 #pragma once
 
+#include "LabelSet.hpp"
+
 typedef uint32_t Vertex;
 
 typedef std::vector<Vertex> Path;
 typedef std::vector<Vertex> EdgeList;
 
 typedef uint32_t Label;
-typedef boost::dynamic_bitset<> LabelSet;
 typedef std::pair<Vertex, LabelSet> LabeledEdge;
 typedef std::vector<LabeledEdge> LabeledEdgeSet;
 
@@ -17,6 +18,8 @@ class LabeledGraph;
 class LabeledEdgeGraph;
 class SCCGraph;
 
+struct TraversalScratch;
+
 struct Edge {
     Vertex source;
     Vertex target;
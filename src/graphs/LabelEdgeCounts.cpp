@@ -0,0 +1,22 @@
+#include "LabelEdgeCounts.hpp"
+
+LabelEdgeCounts::LabelEdgeCounts(const LabeledEdgeGraph &labeledGraph) : counts(labeledGraph.getLabelCount()) {
+    std::vector<std::pair<uint32_t, Label>> numEdgesByLabel;
+    labelDistribution(labeledGraph, numEdgesByLabel);
+
+    for (auto &labelEdges : numEdgesByLabel) {
+        counts[labelEdges.second] = labelEdges.first;
+    }
+}
+
+size_t LabelEdgeCounts::countEdges(const LabelSet &labelSet) const {
+    size_t edgeCount = 0;
+
+    for (auto label = 0u; label < counts.size(); label++) {
+        if (labelSet[label]) {
+            edgeCount += counts[label];
+        }
+    }
+
+    return edgeCount;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "LabeledEdgeGraph.hpp"
+
+/**
+ * @brief the number of edges of every label of a graph, such that the edges of a label set can be counted without
+ * going over the graph.
+ */
+class LabelEdgeCounts {
+private:
+    std::vector<size_t> counts;
+
+public:
+    explicit LabelEdgeCounts(const LabeledEdgeGraph &labeledGraph);
+
+    /**
+     * @brief the number of edges of the labels in labelSet.
+     */
+    [[nodiscard]] size_t countEdges(const LabelSet &labelSet) const;
+};
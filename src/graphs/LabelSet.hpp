@@ -0,0 +1,494 @@
+#pragma once
+
+/**
+ * @brief a fixed size set of labels, stored as a bitset.
+ * Sets of up to 128 labels are stored inline, such that they do not allocate and copy without pointer chasing.
+ * Only larger sets allocate their blocks on the heap. Whether a set is inline is decided by its size, which is the
+ * label count of the graph, thus all sets of a graph use the same representation.
+ *
+ * Implements the part of the boost::dynamic_bitset interface used by the indexes.
+ */
+class LabelSet {
+public:
+    typedef uint64_t block_type;
+    typedef size_t size_type;
+
+    static constexpr size_type bits_per_block = 64;
+    static constexpr size_type inline_blocks = 2;
+
+    class reference {
+    private:
+        block_type &block;
+        block_type mask;
+
+    public:
+        reference(block_type &block, size_type pos) : block(block), mask(block_type(1) << pos) { }
+
+        operator bool() const {
+            return (block & mask) != 0;
+        }
+
+        bool operator ~() const {
+            return (block & mask) == 0;
+        }
+
+        reference &operator =(bool value) {
+            if (value) {
+                block |= mask;
+            } else {
+                block &= ~mask;
+            }
+
+            return *this;
+        }
+
+        reference &operator =(const reference &other) {
+            return *this = bool(other);
+        }
+
+        reference &operator |=(bool value) {
+            if (value) {
+                block |= mask;
+            }
+
+            return *this;
+        }
+
+        reference &operator &=(bool value) {
+            if (!value) {
+                block &= ~mask;
+            }
+
+            return *this;
+        }
+
+        reference &flip() {
+            block ^= mask;
+            return *this;
+        }
+    };
+
+private:
+    union {
+        block_type inlineBlocks[inline_blocks];
+        block_type *heapBlocks;
+    };
+
+    size_type numBits = 0;
+
+    [[nodiscard]] static constexpr size_type blockCount(size_type bits) {
+        return (bits + bits_per_block - 1) / bits_per_block;
+    }
+
+    [[nodiscard]] static constexpr bool fitsInline(size_type bits) {
+        return bits <= inline_blocks * bits_per_block;
+    }
+
+    [[nodiscard]] bool isInline() const {
+        return fitsInline(numBits);
+    }
+
+    [[nodiscard]] block_type *blocks() {
+        return isInline() ? inlineBlocks : heapBlocks;
+    }
+
+    [[nodiscard]] const block_type *blocks() const {
+        return isInline() ? inlineBlocks : heapBlocks;
+    }
+
+    [[nodiscard]] static size_type popCount(block_type block) {
+#ifdef __GNUC__
+        return size_type(__builtin_popcountll(block));
+#else
+        return std::bitset<bits_per_block>(block).count();
+#endif
+    }
+
+    void allocate(size_type bits) {
+        numBits = bits;
+
+        if (isInline()) {
+            inlineBlocks[0] = 0;
+            inlineBlocks[1] = 0;
+        } else {
+            heapBlocks = new block_type[blockCount(bits)]();
+        }
+    }
+
+    void release() {
+        if (!isInline()) {
+            delete[] heapBlocks;
+        }
+
+        numBits = 0;
+        inlineBlocks[0] = 0;
+        inlineBlocks[1] = 0;
+    }
+
+    void clearUnusedBits() {
+        auto extraBits = numBits % bits_per_block;
+
+        if (extraBits != 0) {
+            blocks()[num_blocks() - 1] &= (block_type(1) << extraBits) - 1;
+        }
+    }
+
+public:
+    LabelSet() : inlineBlocks { 0, 0 } { }
+
+    explicit LabelSet(size_type bits, unsigned long value = 0) : inlineBlocks { 0, 0 } {
+        allocate(bits);
+
+        if (bits != 0) {
+            blocks()[0] = value;
+            clearUnusedBits();
+        }
+    }
+
+    LabelSet(const LabelSet &other) : inlineBlocks { 0, 0 } {
+        allocate(other.numBits);
+        std::copy(other.blocks(), other.blocks() + other.num_blocks(), blocks());
+    }
+
+    LabelSet(LabelSet &&other) noexcept : inlineBlocks { other.inlineBlocks[0], other.inlineBlocks[1] },
+                                          numBits(other.numBits) {
+        other.numBits = 0;
+        other.inlineBlocks[0] = 0;
+        other.inlineBlocks[1] = 0;
+    }
+
+    ~LabelSet() {
+        if (!isInline()) {
+            delete[] heapBlocks;
+        }
+    }
+
+    LabelSet &operator =(const LabelSet &other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (numBits != other.numBits) {
+            release();
+            allocate(other.numBits);
+        }
+
+        std::copy(other.blocks(), other.blocks() + other.num_blocks(), blocks());
+        return *this;
+    }
+
+    LabelSet &operator =(LabelSet &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        release();
+
+        numBits = other.numBits;
+        inlineBlocks[0] = other.inlineBlocks[0];
+        inlineBlocks[1] = other.inlineBlocks[1];
+
+        other.numBits = 0;
+        other.inlineBlocks[0] = 0;
+        other.inlineBlocks[1] = 0;
+        return *this;
+    }
+
+    void resize(size_type bits, bool value = false) {
+        LabelSet resized(bits);
+
+        auto copyBlocks = std::min(num_blocks(), resized.num_blocks());
+        std::copy(blocks(), blocks() + copyBlocks, resized.blocks());
+
+        if (value) {
+            for (auto pos = numBits; pos < bits; pos++) {
+                resized.set(pos);
+            }
+        }
+
+        resized.clearUnusedBits();
+        *this = std::move(resized);
+    }
+
+    void clear() {
+        release();
+    }
+
+    [[nodiscard]] size_type size() const {
+        return numBits;
+    }
+
+    [[nodiscard]] size_type num_blocks() const {
+        return blockCount(numBits);
+    }
+
+    [[nodiscard]] const block_type *data() const {
+        return blocks();
+    }
+
+    [[nodiscard]] block_type *data() {
+        return blocks();
+    }
+
+    [[nodiscard]] size_type capacity() const {
+        return num_blocks() * bits_per_block;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return numBits == 0;
+    }
+
+    [[nodiscard]] size_type count() const {
+        size_type total = 0;
+        auto data = blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            total += popCount(data[i]);
+        }
+
+        return total;
+    }
+
+    [[nodiscard]] bool any() const {
+        block_type combined = 0;
+        auto data = blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            combined |= data[i];
+        }
+
+        return combined != 0;
+    }
+
+    [[nodiscard]] bool none() const {
+        return !any();
+    }
+
+    [[nodiscard]] bool all() const {
+        return count() == numBits;
+    }
+
+    [[nodiscard]] bool test(size_type pos) const {
+        return (blocks()[pos / bits_per_block] & (block_type(1) << (pos % bits_per_block))) != 0;
+    }
+
+    [[nodiscard]] bool operator [](size_type pos) const {
+        return test(pos);
+    }
+
+    reference operator [](size_type pos) {
+        return reference(blocks()[pos / bits_per_block], pos % bits_per_block);
+    }
+
+    LabelSet &set(size_type pos, bool value = true) {
+        (*this)[pos] = value;
+        return *this;
+    }
+
+    LabelSet &set() {
+        std::fill(blocks(), blocks() + num_blocks(), ~block_type(0));
+        clearUnusedBits();
+        return *this;
+    }
+
+    LabelSet &reset(size_type pos) {
+        (*this)[pos] = false;
+        return *this;
+    }
+
+    LabelSet &reset() {
+        std::fill(blocks(), blocks() + num_blocks(), block_type(0));
+        return *this;
+    }
+
+    LabelSet &flip(size_type pos) {
+        (*this)[pos].flip();
+        return *this;
+    }
+
+    LabelSet &flip() {
+        auto data = blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            data[i] = ~data[i];
+        }
+
+        clearUnusedBits();
+        return *this;
+    }
+
+    [[nodiscard]] bool is_subset_of(const LabelSet &other) const {
+        block_type missing = 0;
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            missing |= data[i] & ~otherData[i];
+        }
+
+        return missing == 0;
+    }
+
+    [[nodiscard]] bool is_proper_subset_of(const LabelSet &other) const {
+        return is_subset_of(other) && *this != other;
+    }
+
+    [[nodiscard]] bool intersects(const LabelSet &other) const {
+        block_type shared = 0;
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < std::min(num_blocks(), other.num_blocks()); i++) {
+            shared |= data[i] & otherData[i];
+        }
+
+        return shared != 0;
+    }
+
+    LabelSet &operator |=(const LabelSet &other) {
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            data[i] |= otherData[i];
+        }
+
+        return *this;
+    }
+
+    LabelSet &operator &=(const LabelSet &other) {
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            data[i] &= otherData[i];
+        }
+
+        return *this;
+    }
+
+    LabelSet &operator ^=(const LabelSet &other) {
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            data[i] ^= otherData[i];
+        }
+
+        return *this;
+    }
+
+    LabelSet &operator -=(const LabelSet &other) {
+        auto data = blocks();
+        auto otherData = other.blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            data[i] &= ~otherData[i];
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] LabelSet operator ~() const {
+        LabelSet result(*this);
+        result.flip();
+        return result;
+    }
+
+    [[nodiscard]] friend LabelSet operator |(const LabelSet &left, const LabelSet &right) {
+        LabelSet result(left);
+        result |= right;
+        return result;
+    }
+
+    [[nodiscard]] friend LabelSet operator &(const LabelSet &left, const LabelSet &right) {
+        LabelSet result(left);
+        result &= right;
+        return result;
+    }
+
+    [[nodiscard]] friend LabelSet operator ^(const LabelSet &left, const LabelSet &right) {
+        LabelSet result(left);
+        result ^= right;
+        return result;
+    }
+
+    [[nodiscard]] friend LabelSet operator -(const LabelSet &left, const LabelSet &right) {
+        LabelSet result(left);
+        result -= right;
+        return result;
+    }
+
+    [[nodiscard]] friend bool operator ==(const LabelSet &left, const LabelSet &right) {
+        return left.numBits == right.numBits &&
+               std::equal(left.blocks(), left.blocks() + left.num_blocks(), right.blocks());
+    }
+
+    [[nodiscard]] friend bool operator !=(const LabelSet &left, const LabelSet &right) {
+        return !(left == right);
+    }
+
+    /**
+     * @brief orders label sets as numbers, the highest label being the most significant bit.
+     */
+    [[nodiscard]] friend bool operator <(const LabelSet &left, const LabelSet &right) {
+        if (left.numBits != right.numBits) {
+            return left.numBits < right.numBits;
+        }
+
+        auto leftData = left.blocks();
+        auto rightData = right.blocks();
+
+        for (auto i = left.num_blocks(); i > 0; i--) {
+            if (leftData[i - 1] != rightData[i - 1]) {
+                return leftData[i - 1] < rightData[i - 1];
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] friend bool operator >(const LabelSet &left, const LabelSet &right) {
+        return right < left;
+    }
+
+    [[nodiscard]] friend bool operator <=(const LabelSet &left, const LabelSet &right) {
+        return !(right < left);
+    }
+
+    [[nodiscard]] friend bool operator >=(const LabelSet &left, const LabelSet &right) {
+        return !(left < right);
+    }
+
+    [[nodiscard]] size_t hash() const {
+        size_t seed = numBits;
+        auto data = blocks();
+
+        for (size_type i = 0; i < num_blocks(); i++) {
+            seed ^= size_t(data[i]) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+
+        return seed;
+    }
+
+    [[nodiscard]] friend size_t hash_value(const LabelSet &labelSet) {
+        return labelSet.hash();
+    }
+
+    friend std::ostream &operator <<(std::ostream &out, const LabelSet &labelSet) {
+        for (auto pos = labelSet.size(); pos > 0; pos--) {
+            out << (labelSet.test(pos - 1) ? '1' : '0');
+        }
+
+        return out;
+    }
+};
+
+namespace std {
+    template<>
+    struct hash<LabelSet> {
+        size_t operator ()(const LabelSet &labelSet) const {
+            return labelSet.hash();
+        }
+    };
+}
@@ -1,5 +1,407 @@
 #include "LabeledGraph.hpp"
 #include "utility/Format.hpp"
+#include "utility/MappedFile.hpp"
+#include "threading/ThreadPool.hpp"
+
+namespace {
+    // Below this many edges the graph is packed on the calling thread, handing the work to the pool costs more.
+    constexpr size_t parallelEdgeThreshold = 1u << 16u;
+
+    /**
+     * @brief packs the edges of one direction into offset, target and label arrays.
+     * The edges are bucketed on their first vertex by a counting sort, afterwards every bucket is sorted and
+     * de-duplicated on its own. Every step hands out its work as tasks, such that both directions are built side by
+     * side on the thread pool.
+     */
+    class AdjacencyBuilder {
+    private:
+        using WorkGroup = std::vector<std::function<void(uint32_t id)>>;
+
+        const std::vector<Edge> &edges;
+        size_t vertexCount;
+
+        bool reverse;
+        bool labelFirst;
+
+        // Holds the size of every bucket, then its next free position and finally its size after de-duplication.
+        std::vector<std::atomic<uint64_t>> positions;
+        std::vector<uint64_t> bucketOffsets;
+
+        // The other vertex and the label of every edge, packed such that sorting them gives the order of the bucket.
+        std::vector<uint64_t> keys;
+
+        // Vertex ranges holding roughly the same number of edges.
+        std::vector<Vertex> ranges;
+
+        [[nodiscard]] Vertex bucketOf(const Edge &edge) const {
+            return reverse ? edge.target : edge.source;
+        }
+
+        [[nodiscard]] uint64_t keyOf(const Edge &edge) const {
+            uint64_t other = reverse ? edge.source : edge.target;
+            return labelFirst ? (uint64_t(edge.label) << 32u) | other : (other << 32u) | edge.label;
+        }
+
+        template<typename Function>
+        void forEachEdge(WorkGroup &workGroup, size_t tasks, Function function) {
+            for (auto task = 0u; task < tasks; task++) {
+                auto begin = edges.size() * task / tasks;
+                auto end = edges.size() * (task + 1) / tasks;
+
+                workGroup.emplace_back([this, begin, end, function](uint32_t) {
+                    for (auto i = begin; i < end; i++) {
+                        function(edges[i]);
+                    }
+                });
+            }
+        }
+
+        template<typename Function>
+        void forEachRange(WorkGroup &workGroup, Function function) {
+            for (auto range = 0u; range + 1 < ranges.size(); range++) {
+                workGroup.emplace_back([this, range, function](uint32_t) {
+                    for (auto vertex = ranges[range]; vertex < ranges[range + 1]; vertex++) {
+                        function(vertex);
+                    }
+                });
+            }
+        }
+
+    public:
+        AdjacencyBuilder(const std::vector<Edge> &edges, size_t vertexCount, bool reverse, bool labelFirst)
+                : edges(edges), vertexCount(vertexCount), reverse(reverse), labelFirst(labelFirst),
+                  positions(vertexCount + 1) { }
+
+        void countBuckets(WorkGroup &workGroup, size_t tasks) {
+            forEachEdge(workGroup, tasks, [this](const Edge &edge) {
+                positions[bucketOf(edge) + 1].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+
+        void placeBuckets(WorkGroup &workGroup, size_t tasks) {
+            workGroup.emplace_back([this, tasks](uint32_t) {
+                bucketOffsets.resize(vertexCount + 1);
+
+                for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+                    bucketOffsets[vertex + 1] = bucketOffsets[vertex] + positions[vertex + 1].load();
+                    positions[vertex].store(bucketOffsets[vertex]);
+                }
+
+                ranges.clear();
+
+                for (auto task = 0u; task <= tasks; task++) {
+                    auto edgeOffset = bucketOffsets.back() * task / tasks;
+                    auto vertex = std::lower_bound(bucketOffsets.begin(), bucketOffsets.end() - 1, edgeOffset);
+
+                    ranges.emplace_back(Vertex(vertex - bucketOffsets.begin()));
+                }
+
+                ranges.back() = Vertex(vertexCount);
+                keys.resize(edges.size());
+            });
+        }
+
+        void scatterEdges(WorkGroup &workGroup, size_t tasks) {
+            forEachEdge(workGroup, tasks, [this](const Edge &edge) {
+                keys[positions[bucketOf(edge)].fetch_add(1, std::memory_order_relaxed)] = keyOf(edge);
+            });
+        }
+
+        void sortBuckets(WorkGroup &workGroup) {
+            forEachRange(workGroup, [this](Vertex vertex) {
+                auto begin = keys.begin() + bucketOffsets[vertex];
+                auto end = keys.begin() + bucketOffsets[vertex + 1];
+
+                std::sort(begin, end);
+                positions[vertex].store(uint64_t(std::unique(begin, end) - begin), std::memory_order_relaxed);
+            });
+        }
+
+        void packOffsets(WorkGroup &workGroup, std::vector<uint32_t> &offsets, std::vector<Vertex> &targets,
+                         std::vector<Label> &labels) {
+            workGroup.emplace_back([this, &offsets, &targets, &labels](uint32_t) {
+                uint64_t edgeCount = 0;
+
+                for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+                    offsets[vertex] = uint32_t(edgeCount);
+                    edgeCount += positions[vertex].load();
+                }
+
+                if (edgeCount > std::numeric_limits<uint32_t>::max()) {
+                    std::cerr << "Graph has more edges than its offsets can address! Edges: " << edgeCount
+                              << std::fatal;
+                }
+
+                offsets[vertexCount] = uint32_t(edgeCount);
+
+                targets.resize(edgeCount);
+                labels.resize(edgeCount);
+                targets.shrink_to_fit();
+                labels.shrink_to_fit();
+            });
+        }
+
+        void writeEdges(WorkGroup &workGroup, const std::vector<uint32_t> &offsets, std::vector<Vertex> &targets,
+                        std::vector<Label> &labels) {
+            forEachRange(workGroup, [this, &offsets, &targets, &labels](Vertex vertex) {
+                auto key = bucketOffsets[vertex];
+
+                for (auto i = offsets[vertex]; i < offsets[vertex + 1]; i++, key++) {
+                    auto high = Vertex(keys[key] >> 32u);
+                    auto low = Vertex(keys[key]);
+
+                    targets[i] = labelFirst ? low : high;
+                    labels[i] = labelFirst ? high : low;
+                }
+            });
+        }
+    };
+}
+
+void LabeledEdgeGraph::optimize() {
+    if (edgeBuffer.empty() && edgeCount != 0) {
+        return;
+    }
+
+    // Unpack the edges that were already packed, such that they are merged with the new edges.
+    for (auto source = 0u; source < vertexCount && edgeCount != 0; source++) {
+        for (auto i = forward.offsets[source]; i < forward.offsets[source + 1]; i++) {
+            edgeBuffer.emplace_back(source, forward.targets[i], forward.labels[i]);
+        }
+    }
+
+    // The graph owns its arrays from here on, a mapped file is no longer needed.
+    mapping.reset();
+    mappedBytes = 0;
+
+    adjOffsets.resize(vertexCount + 1);
+    reverseAdjOffsets.resize(vertexCount + 1);
+
+    auto &threadPool = getThreadPool();
+    auto parallel = edgeBuffer.size() >= parallelEdgeThreshold;
+    auto tasks = parallel ? size_t(threadPool.getNumThreads()) * 4 : 1;
+
+    // A grouped graph sorts its buckets on label first, such that the label runs follow directly.
+    AdjacencyBuilder forwardBuilder(edgeBuffer, vertexCount, false, labelGrouped);
+    AdjacencyBuilder reverseBuilder(edgeBuffer, vertexCount, true, labelGrouped);
+
+    std::vector<std::function<void(uint32_t id)>> workGroup;
+
+    auto runWorkGroup = [&]() {
+        if (parallel) {
+            threadPool.runWorkGroup(workGroup);
+        } else {
+            for (auto &work : workGroup) {
+                work(0);
+            }
+        }
+
+        workGroup.clear();
+    };
+
+    // Both directions are built side by side, every step waits for the previous step of both.
+    forwardBuilder.countBuckets(workGroup, tasks);
+    reverseBuilder.countBuckets(workGroup, tasks);
+    runWorkGroup();
+
+    forwardBuilder.placeBuckets(workGroup, tasks);
+    reverseBuilder.placeBuckets(workGroup, tasks);
+    runWorkGroup();
+
+    forwardBuilder.scatterEdges(workGroup, tasks);
+    reverseBuilder.scatterEdges(workGroup, tasks);
+    runWorkGroup();
+
+    // The buffer is no longer needed once the edges are bucketed.
+    std::vector<Edge>().swap(edgeBuffer);
+
+    forwardBuilder.sortBuckets(workGroup);
+    reverseBuilder.sortBuckets(workGroup);
+    runWorkGroup();
+
+    forwardBuilder.packOffsets(workGroup, adjOffsets, adjTargets, adjLabels);
+    reverseBuilder.packOffsets(workGroup, reverseAdjOffsets, reverseAdjTargets, reverseAdjLabels);
+    runWorkGroup();
+
+    forwardBuilder.writeEdges(workGroup, adjOffsets, adjTargets, adjLabels);
+    reverseBuilder.writeEdges(workGroup, reverseAdjOffsets, reverseAdjTargets, reverseAdjLabels);
+    runWorkGroup();
+
+    if (labelGrouped) {
+        workGroup.emplace_back([this](uint32_t) {
+            buildLabelRuns(adjOffsets, adjLabels, adjRunOffsets, adjRunLabels, adjRunStarts);
+        });
+
+        workGroup.emplace_back([this](uint32_t) {
+            buildLabelRuns(reverseAdjOffsets, reverseAdjLabels, reverseAdjRunOffsets, reverseAdjRunLabels,
+                           reverseAdjRunStarts);
+        });
+
+        runWorkGroup();
+    }
+
+    edgeCount = adjTargets.size();
+    updateAdjacency();
+}
+
+void LabeledEdgeGraph::groupByLabel() {
+    if (labelGrouped) {
+        return;
+    }
+
+    detach();
+    labelGrouped = true;
+
+    if (!edgeBuffer.empty()) {
+        // The label runs are built once the buffered edges are packed.
+        return;
+    }
+
+    adjOffsets.resize(vertexCount + 1);
+    reverseAdjOffsets.resize(vertexCount + 1);
+
+    sortByLabel(adjOffsets, adjTargets, adjLabels);
+    sortByLabel(reverseAdjOffsets, reverseAdjTargets, reverseAdjLabels);
+
+    buildLabelRuns(adjOffsets, adjLabels, adjRunOffsets, adjRunLabels, adjRunStarts);
+    buildLabelRuns(reverseAdjOffsets, reverseAdjLabels, reverseAdjRunOffsets, reverseAdjRunLabels,
+                   reverseAdjRunStarts);
+
+    updateAdjacency();
+}
+
+void LabeledEdgeGraph::mapAdjacency(std::shared_ptr<const MappedFile> file, size_t fileSize, size_t vertices,
+                                    size_t labels, size_t edges, bool grouped, const Adjacency &forwardAdjacency,
+                                    const Adjacency &reverseAdjacency) {
+    std::vector<Edge>().swap(edgeBuffer);
+
+    std::vector<uint32_t>().swap(adjOffsets);
+    std::vector<Vertex>().swap(adjTargets);
+    std::vector<Label>().swap(adjLabels);
+    std::vector<uint32_t>().swap(reverseAdjOffsets);
+    std::vector<Vertex>().swap(reverseAdjTargets);
+    std::vector<Label>().swap(reverseAdjLabels);
+
+    std::vector<uint32_t>().swap(adjRunOffsets);
+    std::vector<Label>().swap(adjRunLabels);
+    std::vector<uint32_t>().swap(adjRunStarts);
+    std::vector<uint32_t>().swap(reverseAdjRunOffsets);
+    std::vector<Label>().swap(reverseAdjRunLabels);
+    std::vector<uint32_t>().swap(reverseAdjRunStarts);
+
+    mapping = std::move(file);
+    mappedBytes = fileSize;
+
+    vertexCount = vertices;
+    labelCount = labels;
+    edgeCount = edges;
+    labelGrouped = grouped;
+
+    forward = forwardAdjacency;
+    reverse = reverseAdjacency;
+}
+
+void LabeledEdgeGraph::updateAdjacency() {
+    forward.offsets = adjOffsets.data();
+    forward.targets = adjTargets.data();
+    forward.labels = adjLabels.data();
+    forward.runOffsets = adjRunOffsets.data();
+    forward.runLabels = adjRunLabels.data();
+    forward.runStarts = adjRunStarts.data();
+
+    reverse.offsets = reverseAdjOffsets.data();
+    reverse.targets = reverseAdjTargets.data();
+    reverse.labels = reverseAdjLabels.data();
+    reverse.runOffsets = reverseAdjRunOffsets.data();
+    reverse.runLabels = reverseAdjRunLabels.data();
+    reverse.runStarts = reverseAdjRunStarts.data();
+}
+
+void LabeledEdgeGraph::detach() {
+    if (mapping == nullptr) {
+        return;
+    }
+
+    adjOffsets.assign(forward.offsets, forward.offsets + vertexCount + 1);
+    adjTargets.assign(forward.targets, forward.targets + edgeCount);
+    adjLabels.assign(forward.labels, forward.labels + edgeCount);
+
+    reverseAdjOffsets.assign(reverse.offsets, reverse.offsets + vertexCount + 1);
+    reverseAdjTargets.assign(reverse.targets, reverse.targets + edgeCount);
+    reverseAdjLabels.assign(reverse.labels, reverse.labels + edgeCount);
+
+    if (labelGrouped) {
+        auto runCount = forward.runOffsets[vertexCount];
+        auto reverseRunCount = reverse.runOffsets[vertexCount];
+
+        adjRunOffsets.assign(forward.runOffsets, forward.runOffsets + vertexCount + 1);
+        adjRunLabels.assign(forward.runLabels, forward.runLabels + runCount);
+        adjRunStarts.assign(forward.runStarts, forward.runStarts + runCount + 1);
+
+        reverseAdjRunOffsets.assign(reverse.runOffsets, reverse.runOffsets + vertexCount + 1);
+        reverseAdjRunLabels.assign(reverse.runLabels, reverse.runLabels + reverseRunCount);
+        reverseAdjRunStarts.assign(reverse.runStarts, reverse.runStarts + reverseRunCount + 1);
+    }
+
+    mapping.reset();
+    mappedBytes = 0;
+
+    updateAdjacency();
+}
+
+void LabeledEdgeGraph::sortByLabel(const std::vector<uint32_t> &offsets, std::vector<Vertex> &targets,
+                                   std::vector<Label> &labels) {
+    std::vector<std::pair<Label, Vertex>> edges;
+
+    for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+        auto start = offsets[vertex];
+        auto end = offsets[vertex + 1];
+
+        if (end - start < 2) {
+            continue;
+        }
+
+        edges.clear();
+
+        for (auto i = start; i < end; i++) {
+            edges.emplace_back(labels[i], targets[i]);
+        }
+
+        std::sort(edges.begin(), edges.end());
+
+        for (auto i = start; i < end; i++) {
+            labels[i] = edges[i - start].first;
+            targets[i] = edges[i - start].second;
+        }
+    }
+}
+
+void LabeledEdgeGraph::buildLabelRuns(const std::vector<uint32_t> &offsets, const std::vector<Label> &labels,
+                                      std::vector<uint32_t> &runOffsets, std::vector<Label> &runLabels,
+                                      std::vector<uint32_t> &runStarts) {
+    runOffsets.resize(vertexCount + 1);
+    runLabels.clear();
+    runStarts.clear();
+
+    for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+        runOffsets[vertex] = uint32_t(runLabels.size());
+
+        for (auto i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+            if (i == offsets[vertex] || labels[i] != labels[i - 1]) {
+                runLabels.emplace_back(labels[i]);
+                runStarts.emplace_back(i);
+            }
+        }
+    }
+
+    runOffsets[vertexCount] = uint32_t(runLabels.size());
+
+    // The end of a run is the start of the next one, the sentinel closes the last run.
+    runStarts.emplace_back(uint32_t(labels.size()));
+
+    runLabels.shrink_to_fit();
+    runStarts.shrink_to_fit();
+}
 
 std::ostream &operator <<(std::ostream &out, const LabeledEdgeGraph &graph) {
     out << "G = (V=" << graph.getVertexCount() << ", E=" << graph.getEdgeCount() << ", L=" << graph.getLabelCount()
@@ -80,22 +482,7 @@ std::ostream &printLabelDistribution(std::ostream &out, const LabeledEdgeGraph &
 }
 
 static inline size_t calculateDegree(const LabeledEdgeGraph &graph, Vertex vertex) {
-    auto totalIncoming = 0u;
-    auto totalOutgoing = 0u;
-
-    auto it = graph.getConnected(vertex);
-
-    while (it.next()) {
-        totalOutgoing++;
-    }
-
-    auto revIt = graph.getReverseConnected(vertex);
-
-    while (revIt.next()) {
-        totalIncoming++;
-    }
-
-    return totalIncoming + totalOutgoing;
+    return graph.getConnected(vertex).size() + graph.getReverseConnected(vertex).size();
 }
 
 void vertexDistribution(const LabeledEdgeGraph &graph, std::vector<std::pair<uint32_t, Vertex>> &order) {
@@ -2,23 +2,29 @@
 
 #include "PerLabelGraph.hpp"
 
-#define LABELED_EDGE_GRAPH_LABEL_SORTED 0
+class MappedFile;
 
+/**
+ * @brief iterates over the edges stored in the range [startIndex, endIndex) of a compressed adjacency array.
+ * The current edge is materialized into a small cached edge, such that consumers can keep using the edge interface.
+ */
 class LabeledEdgeGraphIterator {
 private:
-    const std::vector<Edge> &edges;
+    const Vertex *targets;
+    const Label *labels;
 
-    size_t numTotal;
     uint32_t startIndex;
+    uint32_t endIndex;
     uint32_t currentIndex;
-    uint32_t source;
+
+    Edge edge;
 
     bool started = false;
 
 public:
-    LabeledEdgeGraphIterator(const std::vector<Edge> &edges, uint32_t currentIndex, size_t numTotal,
-                             uint32_t source) : edges(edges), currentIndex(currentIndex), startIndex(currentIndex),
-                                                source(source), numTotal(numTotal) { }
+    LabeledEdgeGraphIterator(const Vertex *targets, const Label *labels, uint32_t startIndex, uint32_t endIndex,
+                             Vertex source) : targets(targets), labels(labels), startIndex(startIndex),
+                                              endIndex(endIndex), currentIndex(startIndex), edge(source, 0, 0) { }
 
     [[nodiscard]]bool next() {
         if (started) {
@@ -27,11 +33,17 @@ public:
             started = true;
         }
 
-        return isValid();
+        if (currentIndex >= endIndex) {
+            return false;
+        }
+
+        edge.target = targets[currentIndex];
+        edge.label = labels[currentIndex];
+        return true;
     }
 
     [[nodiscard]]bool isValid() const {
-        return currentIndex < edges.size() && edges[currentIndex].source == source;
+        return currentIndex < endIndex;
     }
 
     void reset() {
@@ -40,101 +52,110 @@ public:
     }
 
     [[nodiscard]] size_t size() const {
-        return numTotal;
+        return endIndex - startIndex;
     }
 
-    const Edge &operator [](uint32_t index) const {
-        return edges[startIndex + index];
+    Edge operator [](uint32_t index) const {
+        return Edge(edge.source, targets[startIndex + index], labels[startIndex + index]);
     }
 
     const Edge &operator *() const {
-        return edges[currentIndex];
+        return edge;
     }
 
     const Edge *operator ->() const {
-        return &edges[currentIndex];
+        return &edge;
     }
 };
 
 class LabeledEdgeGraphLabelIterator {
 private:
-    const std::vector<Edge> &edges;
+    const Vertex *targets;
+    const Label *labels;
+
     uint32_t currentIndex;
+    uint32_t endIndex;
+
+    Edge edge;
 
     bool started = false;
-    uint32_t source;
-    uint32_t label;
 
 public:
-    LabeledEdgeGraphLabelIterator(const std::vector<Edge> &edges, uint32_t currentIndex, uint32_t source,
-                                  uint32_t label) : edges(edges), currentIndex(currentIndex), source(source),
-                                                    label(label) { }
+    LabeledEdgeGraphLabelIterator(const Vertex *targets, const Label *labels, uint32_t startIndex, uint32_t endIndex,
+                                  Vertex source, Label label) : targets(targets), labels(labels),
+                                                                currentIndex(startIndex), endIndex(endIndex),
+                                                                edge(source, 0, label) { }
 
     [[nodiscard]]bool next() {
-#if LABELED_EDGE_GRAPH_LABEL_SORTED == 1
         if (started) {
             ++currentIndex;
         } else {
             started = true;
         }
 
-        while (currentIndex < edges.size() && edges[currentIndex].source == source) {
-            if (edges[currentIndex].label < label) {
-                ++currentIndex;
-                continue;
-            }
-
-            if (edges[currentIndex].label > label) {
-                return false;
-            }
-
-            return true;
-        }
-
-        return false;
-#else
-        if (started) {
+        while (currentIndex < endIndex && labels[currentIndex] != edge.label) {
             ++currentIndex;
-        } else {
-            started = true;
         }
 
-        while (currentIndex < edges.size() && edges[currentIndex].source == source &&
-               edges[currentIndex].label != label) {
-            ++currentIndex;
+        if (currentIndex >= endIndex) {
+            return false;
         }
 
-        return isValid();
-#endif
+        edge.target = targets[currentIndex];
+        return true;
     }
 
     [[nodiscard]]bool isValid() const {
-        return currentIndex < edges.size() && edges[currentIndex].source == source &&
-               edges[currentIndex].label == label;
+        return currentIndex < endIndex && labels[currentIndex] == edge.label;
     }
 
     const Edge &operator *() const {
-        return edges[currentIndex];
+        return edge;
     }
 
     const Edge *operator ->() const {
-        return &edges[currentIndex];
+        return &edge;
     }
 };
 
+/**
+ * @brief iterates over the edges whose label is part of the label set.
+ * If the graph is grouped by label the iterator walks the label runs of the vertex, skipping whole runs at once.
+ */
 class LabeledEdgeGraphLabelSetIterator {
 private:
-    const std::vector<Edge> &edges;
+    const Vertex *targets;
+    const Label *labels;
+
+    const Label *runLabels;
+    const uint32_t *runStarts;
+
     uint32_t currentIndex;
+    uint32_t endIndex;
 
-    bool started = false;
-    uint32_t source;
+    uint32_t currentRun;
+    uint32_t endRun;
+    uint32_t runEndIndex;
+
+    Edge edge;
     const LabelSet &labelSet;
 
+    bool started = false;
+
 public:
-    LabeledEdgeGraphLabelSetIterator(const std::vector<Edge> &edges, uint32_t currentIndex, uint32_t source,
-                                     const LabelSet &labelSet) : edges(edges), currentIndex(currentIndex),
-                                                                 source(source), labelSet(labelSet) { }
+    LabeledEdgeGraphLabelSetIterator(const Vertex *targets, const Label *labels, uint32_t startIndex,
+                                     uint32_t endIndex, Vertex source, const LabelSet &labelSet,
+                                     const Label *runLabels = nullptr, const uint32_t *runStarts = nullptr,
+                                     uint32_t startRun = 0, uint32_t endRun = 0) : targets(targets), labels(labels),
+                                                                                   runLabels(runLabels),
+                                                                                   runStarts(runStarts),
+                                                                                   currentIndex(startIndex),
+                                                                                   endIndex(endIndex),
+                                                                                   currentRun(startRun),
+                                                                                   endRun(endRun),
+                                                                                   runEndIndex(startIndex),
+                                                                                   edge(source, 0, 0),
+                                                                                   labelSet(labelSet) { }
 
     [[nodiscard]]bool next() {
         if (started) {
@@ -143,38 +164,150 @@ public:
             started = true;
         }
 
-        while (currentIndex < edges.size() && edges[currentIndex].source == source &&
-               !labelSet[edges[currentIndex].label]) {
-            ++currentIndex;
+        if (runLabels == nullptr) {
+            while (currentIndex < endIndex && !labelSet[labels[currentIndex]]) {
+                ++currentIndex;
+            }
+        } else if (currentIndex >= runEndIndex) {
+            while (currentRun < endRun && !labelSet[runLabels[currentRun]]) {
+                ++currentRun;
+            }
+
+            if (currentRun >= endRun) {
+                currentIndex = endIndex;
+                return false;
+            }
+
+            currentIndex = runStarts[currentRun];
+            runEndIndex = runStarts[currentRun + 1];
+            ++currentRun;
+        }
+
+        if (currentIndex >= endIndex) {
+            return false;
         }
 
-        return isValid();
+        edge.target = targets[currentIndex];
+        edge.label = labels[currentIndex];
+        return true;
     }
 
     [[nodiscard]]bool isValid() const {
-        return currentIndex < edges.size() && edges[currentIndex].source == source &&
-               labelSet[edges[currentIndex].label];
+        return currentIndex < endIndex && labelSet[labels[currentIndex]];
     }
 
     const Edge &operator *() const {
-        return edges[currentIndex];
+        return edge;
     }
 
     const Edge *operator ->() const {
-        return &edges[currentIndex];
+        return &edge;
     }
 };
 
+/**
+ * @brief a labeled graph stored in compressed sparse row form, for both the forward and the reverse direction.
+ * Edges are buffered by addEdge, optimize sorts and de-duplicates them and packs them into the offset, target and
+ * label arrays. Afterwards the buffer is released, such that only 8 bytes per edge per direction remain resident.
+ *
+ * If the graph is grouped by label, the edges of every vertex are ordered by label and a per vertex directory of
+ * label runs is kept. The label and label set iterators then jump directly to the edges of the requested labels.
+ *
+ * All reads go through the adjacency views, which point either into the arrays owned by the graph or into a mapped
+ * binary graph file. A mapped graph is copied into owned arrays only once it is modified.
+ */
 class LabeledEdgeGraph {
+public:
+    /**
+     * @brief the compressed arrays of one direction. The run arrays are only set if the graph is grouped by label.
+     */
+    struct Adjacency {
+        const uint32_t *offsets = nullptr;
+        const Vertex *targets = nullptr;
+        const Label *labels = nullptr;
+
+        const uint32_t *runOffsets = nullptr;
+        const Label *runLabels = nullptr;
+        const uint32_t *runStarts = nullptr;
+    };
+
 private:
-    std::vector<Edge> adj;
-    std::vector<Edge> reverseAdj;
+    std::vector<Edge> edgeBuffer;
+
+    std::vector<uint32_t> adjOffsets;
+    std::vector<Vertex> adjTargets;
+    std::vector<Label> adjLabels;
 
-    std::vector<uint32_t> adjStartLookup;
-    std::vector<uint32_t> reverseAdjStartLookup;
+    std::vector<uint32_t> reverseAdjOffsets;
+    std::vector<Vertex> reverseAdjTargets;
+    std::vector<Label> reverseAdjLabels;
+
+    // Label run directory, only filled if the graph is grouped by label.
+    std::vector<uint32_t> adjRunOffsets;
+    std::vector<Label> adjRunLabels;
+    std::vector<uint32_t> adjRunStarts;
+
+    std::vector<uint32_t> reverseAdjRunOffsets;
+    std::vector<Label> reverseAdjRunLabels;
+    std::vector<uint32_t> reverseAdjRunStarts;
+
+    Adjacency forward;
+    Adjacency reverse;
+
+    // Keeps the mapped file alive while the adjacency views point into it.
+    std::shared_ptr<const MappedFile> mapping;
+    size_t mappedBytes = 0;
 
     size_t vertexCount = 0;
     size_t labelCount = 0;
+    size_t edgeCount = 0;
+
+    bool labelGrouped = false;
+
+    /**
+     * @brief points the adjacency views at the owned arrays.
+     */
+    void updateAdjacency();
+
+    /**
+     * @brief copies the arrays of a mapped graph into owned arrays, such that they can be modified.
+     */
+    void detach();
+
+    void sortByLabel(const std::vector<uint32_t> &offsets, std::vector<Vertex> &targets, std::vector<Label> &labels);
+
+    void buildLabelRuns(const std::vector<uint32_t> &offsets, const std::vector<Label> &labels,
+                        std::vector<uint32_t> &runOffsets, std::vector<Label> &runLabels,
+                        std::vector<uint32_t> &runStarts);
+
+    [[nodiscard]] static LabeledEdgeGraphLabelIterator findLabelRun(const Adjacency &adjacency, Vertex source,
+                                                                    Label label) {
+        auto first = adjacency.runLabels + adjacency.runOffsets[source];
+        auto last = adjacency.runLabels + adjacency.runOffsets[source + 1];
+        auto run = std::lower_bound(first, last, label);
+
+        if (run == last || *run != label) {
+            return LabeledEdgeGraphLabelIterator(adjacency.targets, adjacency.labels, adjacency.offsets[source + 1],
+                                                 adjacency.offsets[source + 1], source, label);
+        }
+
+        auto runIndex = uint32_t(run - adjacency.runLabels);
+        return LabeledEdgeGraphLabelIterator(adjacency.targets, adjacency.labels, adjacency.runStarts[runIndex],
+                                             adjacency.runStarts[runIndex + 1], source, label);
+    }
+
+    [[nodiscard]] static LabeledEdgeGraphLabelSetIterator findLabelRuns(const Adjacency &adjacency, bool grouped,
+                                                                        Vertex source, const LabelSet &labelSet) {
+        if (grouped) {
+            return LabeledEdgeGraphLabelSetIterator(adjacency.targets, adjacency.labels, adjacency.offsets[source],
+                                                    adjacency.offsets[source + 1], source, labelSet,
+                                                    adjacency.runLabels, adjacency.runStarts,
+                                                    adjacency.runOffsets[source], adjacency.runOffsets[source + 1]);
+        }
+
+        return LabeledEdgeGraphLabelSetIterator(adjacency.targets, adjacency.labels, adjacency.offsets[source],
+                                                adjacency.offsets[source + 1], source, labelSet);
+    }
 
 public:
     LabeledEdgeGraph() = default;
@@ -185,15 +318,37 @@ public:
     LabeledEdgeGraph &operator =(const LabeledEdgeGraph &) = delete;
     LabeledEdgeGraph &operator =(LabeledEdgeGraph &&) = default;
 
+    /**
+     * @brief sizes the graph and reserves room for the given number of edges.
+     * The packed adjacency uses 32-bit offsets, so a graph holds at most 2^32 - 1 edges per direction;
+     * optimize reports a fatal error for larger graphs.
+     */
     void setSizes(uint32_t vertices, uint32_t labels, uint32_t edges) {
-        adjStartLookup.resize(vertices);
-        reverseAdjStartLookup.resize(vertices);
+        adjOffsets.resize(vertices + 1);
+        reverseAdjOffsets.resize(vertices + 1);
 
-        this->adj.reserve(edges);
-        this->reverseAdj.reserve(edges);
+        this->edgeBuffer.reserve(edges);
 
         this->vertexCount = vertices;
         this->labelCount = labels;
+
+        updateAdjacency();
+    }
+
+    /**
+     * @brief points the graph at arrays stored in a mapped file, which must hold optimized edges.
+     * The file is kept alive by the graph, the arrays are not copied.
+     */
+    void mapAdjacency(std::shared_ptr<const MappedFile> file, size_t fileSize, size_t vertices, size_t labels,
+                      size_t edges, bool grouped, const Adjacency &forwardAdjacency,
+                      const Adjacency &reverseAdjacency);
+
+    [[nodiscard]] const Adjacency &getAdjacency() const {
+        return forward;
+    }
+
+    [[nodiscard]] const Adjacency &getReverseAdjacency() const {
+        return reverse;
     }
 
     [[nodiscard]] size_t getVertexCount() const {
@@ -205,179 +360,94 @@ public:
     }
 
     [[nodiscard]] size_t getEdgeCount() const {
-        return adj.size();
+        return edgeCount + edgeBuffer.size();
     }
 
     [[nodiscard]] size_t getEdgeCount(Label label) const {
-        auto count = 0ul;
+        return size_t(std::count(forward.labels, forward.labels + edgeCount, label));
+    }
 
-        for (auto &edge : adj) {
-            if (edge.label == label) {
-                count++;
-            }
-        }
+    [[nodiscard]] bool isLabelGrouped() const {
+        return labelGrouped;
+    }
+
+    [[nodiscard]] size_t getSizeInBytes() const {
+        auto size = sizeof(LabeledEdgeGraph);
 
-        return count;
+        size += edgeBuffer.capacity() * sizeof(Edge);
+        size += (adjOffsets.capacity() + reverseAdjOffsets.capacity()) * sizeof(uint32_t);
+        size += (adjTargets.capacity() + reverseAdjTargets.capacity()) * sizeof(Vertex);
+        size += (adjLabels.capacity() + reverseAdjLabels.capacity()) * sizeof(Label);
+
+        size += (adjRunOffsets.capacity() + reverseAdjRunOffsets.capacity()) * sizeof(uint32_t);
+        size += (adjRunLabels.capacity() + reverseAdjRunLabels.capacity()) * sizeof(Label);
+        size += (adjRunStarts.capacity() + reverseAdjRunStarts.capacity()) * sizeof(uint32_t);
+
+        return size + mappedBytes;
     }
 
     void addEdge(Vertex source, Vertex target, Label label) {
-        adj.emplace_back(source, target, label);
-        reverseAdj.emplace_back(target, source, label);
+        edgeBuffer.emplace_back(source, target, label);
     }
 
-    [[nodiscard]] LabeledEdgeGraphIterator getConnected(Vertex source) const {
-        if (source == vertexCount - 1) {
-            return LabeledEdgeGraphIterator(adj, adjStartLookup[source], getEdgeCount() - adjStartLookup[source],
-                                            source);
+    /**
+     * @brief buffers all edges at once, the vector is taken over if no edges were buffered yet.
+     */
+    void addEdges(std::vector<Edge> &&edges) {
+        if (edgeBuffer.empty()) {
+            edgeBuffer = std::move(edges);
+        } else {
+            edgeBuffer.insert(edgeBuffer.end(), edges.begin(), edges.end());
         }
+    }
 
-        return LabeledEdgeGraphIterator(adj, adjStartLookup[source],
-                                        adjStartLookup[source + 1] - adjStartLookup[source], source);
+    [[nodiscard]] LabeledEdgeGraphIterator getConnected(Vertex source) const {
+        return LabeledEdgeGraphIterator(forward.targets, forward.labels, forward.offsets[source],
+                                        forward.offsets[source + 1], source);
     }
 
     [[nodiscard]] LabeledEdgeGraphLabelIterator getConnected(Vertex source, uint32_t label) const {
-        return LabeledEdgeGraphLabelIterator(adj, adjStartLookup[source], source, label);
+        if (labelGrouped) {
+            return findLabelRun(forward, source, label);
+        }
+
+        return LabeledEdgeGraphLabelIterator(forward.targets, forward.labels, forward.offsets[source],
+                                             forward.offsets[source + 1], source, label);
     }
 
     [[nodiscard]] LabeledEdgeGraphLabelSetIterator getConnected(Vertex source, const LabelSet &labelSet) const {
-        return LabeledEdgeGraphLabelSetIterator(adj, adjStartLookup[source], source, labelSet);
+        return findLabelRuns(forward, labelGrouped, source, labelSet);
     }
 
     [[nodiscard]] LabeledEdgeGraphIterator getReverseConnected(Vertex source) const {
-        if (source == vertexCount - 1) {
-            return LabeledEdgeGraphIterator(reverseAdj, reverseAdjStartLookup[source],
-                                            getEdgeCount() - reverseAdjStartLookup[source], source);
-        }
-
-        return LabeledEdgeGraphIterator(reverseAdj, reverseAdjStartLookup[source],
-                                        reverseAdjStartLookup[source + 1] - reverseAdjStartLookup[source], source);
+        return LabeledEdgeGraphIterator(reverse.targets, reverse.labels, reverse.offsets[source],
+                                        reverse.offsets[source + 1], source);
     }
 
     [[nodiscard]] LabeledEdgeGraphLabelIterator getReverseConnected(Vertex source, uint32_t label) const {
-        return LabeledEdgeGraphLabelIterator(reverseAdj, reverseAdjStartLookup[source], source, label);
+        if (labelGrouped) {
+            return findLabelRun(reverse, source, label);
+        }
+
+        return LabeledEdgeGraphLabelIterator(reverse.targets, reverse.labels, reverse.offsets[source],
+                                             reverse.offsets[source + 1], source, label);
     }
 
     [[nodiscard]] LabeledEdgeGraphLabelSetIterator getReverseConnected(Vertex source, const LabelSet &labelSet) const {
-        return LabeledEdgeGraphLabelSetIterator(reverseAdj, reverseAdjStartLookup[source], source, labelSet);
+        return findLabelRuns(reverse, labelGrouped, source, labelSet);
     }
 
-    void optimize() {
-        struct source_target_label_pred {
-            // First sort by source then by target and finally on label.
-            constexpr bool operator ()(Edge const &left, Edge const &right) const {
-                if (left.source < right.source) {
-                    return true;
-                }
-
-                if (left.source > right.source) {
-                    return false;
-                }
-
-                if (left.target < right.target) {
-                    return true;
-                }
-
-                if (left.target > right.target) {
-                    return false;
-                }
-
-                return left.label < right.label;
-            }
-        };
-
-        struct source_label_target_pred {
-            // First sort by source then by label and finally on target.
-            constexpr bool operator ()(Edge const &left, Edge const &right) const {
-                if (left.source < right.source) {
-                    return true;
-                }
-
-                if (left.source > right.source) {
-                    return false;
-                }
-
-                if (left.label < right.label) {
-                    return true;
-                }
-
-                if (left.label > right.label) {
-                    return false;
-                }
-
-                return left.target < right.target;
-            }
-        };
-
-        struct source_eq {
-            // First sort by source then by target and finally on label.
-            constexpr bool operator ()(Edge const &left, Edge const &right) const {
-                return left.source == right.source && left.target == right.target && left.label == right.label;
-            }
-        };
-
-#if LABELED_EDGE_GRAPH_LABEL_SORTED == 1
-        std::sort(adj.begin(), adj.end(), source_label_target_pred());
-#else
-        std::sort(adj.begin(), adj.end(), source_target_label_pred());
-#endif
-
-        auto last = std::unique(adj.begin(), adj.end(), source_eq());
-        adj.erase(last, adj.end());
-        adj.shrink_to_fit();
-
-        auto currentSource = 0u;
-        auto currentPointer = 0u;
-
-        adjStartLookup[currentSource] = currentPointer;
-
-        for (auto &edge : adj) {
-            auto source = edge.source;
-
-            while (source >= currentSource) {
-                adjStartLookup[currentSource] = currentPointer;
-                currentSource++;
-            }
-
-            currentPointer++;
-        }
-
-        while (currentSource < vertexCount) {
-            adjStartLookup[currentSource] = currentPointer;
-            currentSource++;
-        }
-
-
-#if LABELED_EDGE_GRAPH_LABEL_SORTED == 1
-        std::sort(reverseAdj.begin(), reverseAdj.end(), source_label_target_pred());
-#else
-        std::sort(reverseAdj.begin(), reverseAdj.end(), source_target_label_pred());
-#endif
-
-        last = std::unique(reverseAdj.begin(), reverseAdj.end(), source_eq());
-        reverseAdj.erase(last, reverseAdj.end());
-        reverseAdj.shrink_to_fit();
-
-        currentSource = 0;
-        currentPointer = 0;
-
-        reverseAdjStartLookup[currentSource] = currentPointer;
-
-        for (auto &edge : reverseAdj) {
-            auto source = edge.source;
-
-            while (source >= currentSource) {
-                reverseAdjStartLookup[currentSource] = currentPointer;
-                currentSource++;
-            }
-
-            currentPointer++;
-        }
-
-        while (currentSource < vertexCount) {
-            reverseAdjStartLookup[currentSource] = currentPointer;
-            currentSource++;
-        }
-    }
+    /**
+     * @brief sorts and de-duplicates all buffered edges and packs them into the compressed layout.
+     * Edges added after a previous call are merged with the already packed edges.
+     */
+    void optimize();
+
+    /**
+     * @brief orders the edges of every vertex by label and builds the label run directory.
+     * Can be called before or after optimize, later calls to optimize keep the graph grouped.
+     */
+    void groupByLabel();
 };
 
 void labelDistribution(const LabeledEdgeGraph &labeledGraph, std::vector<std::pair<uint32_t, Label>> &distribution);
@@ -0,0 +1,73 @@
+#include "PackedLCRQuerySet.hpp"
+
+PackedLCRQuerySet::PackedLCRQuerySet(const LCRQuerySet &queries) {
+    std::vector<Vertex> sourceArray;
+    std::vector<Vertex> targetArray;
+    std::vector<uint64_t> labelOffsetArray;
+    std::vector<Label> labelArray;
+
+    sourceArray.reserve(queries.size());
+    targetArray.reserve(queries.size());
+    labelOffsetArray.reserve(queries.size() + 1);
+    labelOffsetArray.emplace_back(0);
+
+    for (auto &query : queries) {
+        sourceArray.emplace_back(query.source);
+        targetArray.emplace_back(query.target);
+
+        if (query.labelSet.empty()) {
+            labelArray.insert(labelArray.end(), query.labels.begin(), query.labels.end());
+        } else {
+            for (Label label = 0; label < query.labelSet.size(); label++) {
+                if (query.labelSet[label]) {
+                    labelArray.emplace_back(label);
+                }
+            }
+        }
+
+        labelOffsetArray.emplace_back(labelArray.size());
+    }
+
+    for (auto label : labelArray) {
+        labelCount = std::max(labelCount, size_t(label) + 1);
+    }
+
+    sources.assign(std::move(sourceArray));
+    targets.assign(std::move(targetArray));
+    labelOffsets.assign(std::move(labelOffsetArray));
+    labels.assign(std::move(labelArray));
+}
+
+void PackedLCRQuerySet::map(const Vertex *sourceArray, const Vertex *targetArray, const uint64_t *labelOffsetArray,
+                            const Label *labelArray, size_t queryCount, size_t labels,
+                            const std::shared_ptr<const void> &file) {
+    sources.map(sourceArray, queryCount, file);
+    targets.map(targetArray, queryCount, file);
+    labelOffsets.map(labelOffsetArray, queryCount + 1, file);
+    this->labels.map(labelArray, labelOffsetArray[queryCount], file);
+
+    labelCount = labels;
+}
+
+void PackedLCRQuerySet::fill(size_t index, LCRQuery &query) const {
+    query.source = sources[index];
+    query.target = targets[index];
+    query.labels.assign(labelsBegin(index), labelsEnd(index));
+
+    query.labelSet.resize(labelCount);
+    query.labelSet.reset();
+
+    for (auto label : query.labels) {
+        query.labelSet[label] = true;
+    }
+}
+
+LCRQuerySet PackedLCRQuerySet::unpack() const {
+    LCRQuerySet queries(size());
+
+    for (auto i = 0u; i < size(); i++) {
+        fill(i, queries[i]);
+    }
+
+    return queries;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "graphs/Query.hpp"
+#include "dataStructures/MappedArray.hpp"
+
+/**
+ * @brief a set of lcr queries stored as arrays, instead of one LCRQuery with its own label set per query.
+ * The labels of all queries are stored back to back. The arrays either own their elements, or view them in a mapped
+ * binary query file.
+ */
+class PackedLCRQuerySet {
+private:
+    MappedArray<Vertex> sources;
+    MappedArray<Vertex> targets;
+    MappedArray<uint64_t> labelOffsets;
+    MappedArray<Label> labels;
+
+    size_t labelCount = 0;
+
+public:
+    PackedLCRQuerySet() = default;
+
+    /**
+     * @brief packs the queries, the labels are taken from the label set if the query was initialized.
+     */
+    explicit PackedLCRQuerySet(const LCRQuerySet &queries);
+
+    /**
+     * @brief views the arrays of a mapped file, which is kept alive as long as the set views it.
+     */
+    void map(const Vertex *sourceArray, const Vertex *targetArray, const uint64_t *labelOffsetArray,
+             const Label *labelArray, size_t queryCount, size_t labels, const std::shared_ptr<const void> &file);
+
+    [[nodiscard]] size_t size() const {
+        return sources.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return sources.empty();
+    }
+
+    [[nodiscard]] size_t getLabelCount() const {
+        return labelCount;
+    }
+
+    [[nodiscard]] const MappedArray<Vertex> &getSources() const {
+        return sources;
+    }
+
+    [[nodiscard]] const MappedArray<Vertex> &getTargets() const {
+        return targets;
+    }
+
+    [[nodiscard]] const MappedArray<uint64_t> &getLabelOffsets() const {
+        return labelOffsets;
+    }
+
+    [[nodiscard]] const MappedArray<Label> &getLabels() const {
+        return labels;
+    }
+
+    [[nodiscard]] Vertex getSource(size_t index) const {
+        return sources[index];
+    }
+
+    [[nodiscard]] Vertex getTarget(size_t index) const {
+        return targets[index];
+    }
+
+    [[nodiscard]] const Label *labelsBegin(size_t index) const {
+        return labels.data() + labelOffsets[index];
+    }
+
+    [[nodiscard]] const Label *labelsEnd(size_t index) const {
+        return labels.data() + labelOffsets[index + 1];
+    }
+
+    /**
+     * @brief overwrites the query with query index of the set, the memory of the query is reused.
+     */
+    void fill(size_t index, LCRQuery &query) const;
+
+    [[nodiscard]] LCRQuerySet unpack() const;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DiGraph.hpp"
+#include "VertexMapping.hpp"
 
 class SCCGraph {
 private:
@@ -9,6 +10,9 @@ private:
     std::vector<Vertex> vertexMapping;
     std::vector<std::vector<Vertex>> componentMapping;
 
+    // Replaces vertexMapping once the mapping is shared.
+    std::shared_ptr<const VertexMapping> sharedMapping;
+
     size_t componentCount = 0;
 
 public:
@@ -31,6 +35,12 @@ public:
         componentCount = this->componentGraph->getVertexCount();
     }
 
+    /**
+     * @brief a graph of which the component graph has been discarded, only the vertex mapping is kept.
+     */
+    explicit SCCGraph(size_t componentCount, std::vector<uint32_t> &&vertexMapping) : vertexMapping(
+            std::move(vertexMapping)), componentCount(componentCount) { }
+
     void clearComponentMapping() {
         componentMapping.clear();
         componentMapping.shrink_to_fit();
@@ -40,20 +50,50 @@ public:
         componentGraph = nullptr;
     }
 
+    /**
+     * @brief moves the vertex mapping into store, which shares it with identical mappings and compresses it.
+     */
+    void shareVertexMapping(VertexMappingStore &store) {
+        if (sharedMapping != nullptr) {
+            return;
+        }
+
+        sharedMapping = store.insert(std::move(vertexMapping));
+        std::vector<Vertex>().swap(vertexMapping);
+    }
+
+    /**
+     * @brief maps the vertices of an original graph through mapping to the vertices of this graph.
+     * Used when the graph that was condensed is itself a component graph, with mapping as its vertex mapping.
+     */
+    void composeVertexMapping(const std::vector<Vertex> &mapping) {
+        std::vector<Vertex> composed(mapping.size());
+
+        for (auto vertex = 0u; vertex < mapping.size(); vertex++) {
+            composed[vertex] = vertexMapping[mapping[vertex]];
+        }
+
+        vertexMapping = std::move(composed);
+    }
+
     [[nodiscard]] size_t getComponentCount() const {
         return componentCount;
     }
 
     [[nodiscard]] size_t getOriginalVertexCount() const {
-        return vertexMapping.size();
+        return sharedMapping == nullptr ? vertexMapping.size() : sharedMapping->size();
     }
 
     [[nodiscard]] size_t getSizeInBytes() const {
+        // A shared mapping is counted in equal parts by the graphs that share it.
+        auto mappingBytes = sharedMapping == nullptr ? vertexMapping.size() * sizeof(Vertex) :
+                            sharedMapping->getSizeInBytes() / sharedMapping.use_count();
+
         if (componentGraph == nullptr) {
-            return vertexMapping.size() * sizeof(Vertex);
+            return mappingBytes;
         }
 
-        return componentGraph->getSizeInBytes() + vertexMapping.size() * sizeof(Vertex);
+        return componentGraph->getSizeInBytes() + mappingBytes;
     }
 
     [[nodiscard]] bool hasComponentGraph() const { return componentGraph != nullptr; }
@@ -68,12 +108,23 @@ public:
         return componentMapping[componentIndex];
     }
 
+    [[nodiscard]] bool isVertexMappingShared() const { return sharedMapping != nullptr; }
+
+    // Note only present till the mapping is shared
+    [[nodiscard]] const std::vector<Vertex> &getVertexMapping() const {
+        return vertexMapping;
+    }
+
+    [[nodiscard]] const VertexMapping &getSharedVertexMapping() const {
+        return *sharedMapping;
+    }
+
     [[nodiscard]] uint32_t getComponentIndex(Vertex vertex) const {
-        return vertexMapping[vertex];
+        return sharedMapping == nullptr ? vertexMapping[vertex] : (*sharedMapping)[vertex];
     }
 
     [[nodiscard]] bool isSingleComponent(Vertex first) const {
-        uint32_t firstIndex = vertexMapping[first];
+        uint32_t firstIndex = getComponentIndex(first);
 
         if (componentMapping[firstIndex].size() != 1) {
             return false;
@@ -85,24 +136,24 @@ public:
     template<class ... Args>
     [[nodiscard]] bool isSingleComponent(Vertex first, Args ... args) const {
         const auto list = { args... };
-        uint32_t firstIndex = vertexMapping[first];
+        uint32_t firstIndex = getComponentIndex(first);
 
         if (componentMapping[firstIndex].size() != list.size() + 1) {
             return false;
         }
 
         return std::all_of(list.begin(), list.end(), [firstIndex, this](Vertex vertex) {
-            return firstIndex == this->vertexMapping[vertex];
+            return firstIndex == this->getComponentIndex(vertex);
         });
     }
 
     template<class ... Args>
     [[nodiscard]] bool areInSameComponent(Vertex first, Args ... args) const {
         const auto list = { args... };
-        uint32_t firstIndex = vertexMapping[first];
+        uint32_t firstIndex = getComponentIndex(first);
 
         return std::all_of(list.begin(), list.end(), [firstIndex, this](Vertex vertex) {
-            return firstIndex == this->vertexMapping[vertex];
+            return firstIndex == this->getComponentIndex(vertex);
         });
     }
 };
@@ -0,0 +1,96 @@
+#include "VertexMapping.hpp"
+
+VertexMapping::VertexMapping(std::vector<Vertex> &&mapping) : vertexCount(mapping.size()) {
+    size_t runCount = 0;
+
+    for (auto vertex = 0u; vertex < mapping.size(); vertex++) {
+        if (vertex == 0 || mapping[vertex] != mapping[vertex - 1] + 1) {
+            runCount++;
+        }
+    }
+
+    auto words = (mapping.size() + 63) / 64;
+    auto runBytes = words * (sizeof(uint64_t) + sizeof(uint32_t)) + runCount * sizeof(uint32_t);
+
+    if (mapping.empty() || runBytes * 2 > mapping.size() * sizeof(Vertex)) {
+        components = std::move(mapping);
+        return;
+    }
+
+    runStarts.resize(words);
+    runRanks.resize(words);
+    runOffsets.reserve(runCount);
+
+    for (auto vertex = 0u; vertex < mapping.size(); vertex++) {
+        if (vertex % 64 == 0) {
+            runRanks[vertex / 64] = uint32_t(runOffsets.size());
+        }
+
+        if (vertex == 0 || mapping[vertex] != mapping[vertex - 1] + 1) {
+            runStarts[vertex / 64] |= uint64_t(1) << (vertex % 64);
+            runOffsets.emplace_back(mapping[vertex] - vertex);
+        }
+    }
+}
+
+std::vector<Vertex> VertexMapping::decode() const {
+    if (!components.empty()) {
+        return components;
+    }
+
+    std::vector<Vertex> mapping(vertexCount);
+    auto run = runOffsets.begin();
+
+    for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+        if ((runStarts[vertex / 64] >> (vertex % 64)) & 1u) {
+            mapping[vertex] = vertex + *run++;
+        } else {
+            mapping[vertex] = mapping[vertex - 1] + 1;
+        }
+    }
+
+    return mapping;
+}
+
+bool VertexMapping::operator ==(const std::vector<Vertex> &mapping) const {
+    if (mapping.size() != vertexCount) {
+        return false;
+    }
+
+    if (!components.empty()) {
+        return components == mapping;
+    }
+
+    for (auto vertex = 0u; vertex < vertexCount; vertex++) {
+        if ((*this)[vertex] != mapping[vertex]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<const VertexMapping> VertexMappingStore::insert(std::vector<Vertex> &&mapping) {
+    uint64_t hash = mapping.size();
+
+    for (auto component : mapping) {
+        hash = (hash ^ component) * 0x100000001b3ull;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto range = mappings.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; it++) {
+        if (*it->second == mapping) {
+            return it->second;
+        }
+    }
+
+    // Encoding is the expensive part and does not touch the store.
+    lock.unlock();
+    auto stored = std::make_shared<const VertexMapping>(std::move(mapping));
+    lock.lock();
+
+    mappings.emplace(hash, stored);
+    return stored;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+/**
+ * @brief an immutable mapping of the vertices of a graph to the components of its condensation.
+ * Tarjan numbers the components in the order they are completed, so if most components are singletons, runs of
+ * consecutive vertices map to consecutive components. Such mappings are stored per run instead of per vertex: a bit
+ * marks the first vertex of every run, the rank of the bit of a vertex selects the offset of its run.
+ */
+class VertexMapping {
+private:
+    size_t vertexCount = 0;
+
+    // The component of every vertex, empty if the mapping is stored as runs.
+    std::vector<Vertex> components;
+
+    // A set bit for the first vertex of every run.
+    std::vector<uint64_t> runStarts;
+
+    // The number of runs that start before every word of runStarts.
+    std::vector<uint32_t> runRanks;
+
+    // The component minus the vertex of every run, modulo 2^32.
+    std::vector<uint32_t> runOffsets;
+
+public:
+    /**
+     * @brief stores mapping as runs if that takes at most half of the memory, otherwise takes it over as is.
+     */
+    explicit VertexMapping(std::vector<Vertex> &&mapping);
+
+    [[nodiscard]] Vertex operator [](Vertex vertex) const {
+        if (!components.empty()) {
+            return components[vertex];
+        }
+
+        auto word = vertex / 64;
+        auto bits = runStarts[word] & (~uint64_t(0) >> (63 - vertex % 64));
+
+        return vertex + runOffsets[runRanks[word] + popCount(bits) - 1];
+    }
+
+    [[nodiscard]] size_t size() const {
+        return vertexCount;
+    }
+
+    [[nodiscard]] bool isStoredAsRuns() const {
+        return components.empty() && vertexCount > 0;
+    }
+
+    [[nodiscard]] size_t getSizeInBytes() const {
+        return components.size() * sizeof(Vertex) + runStarts.size() * sizeof(uint64_t) +
+               runRanks.size() * sizeof(uint32_t) + runOffsets.size() * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief the component of every vertex.
+     */
+    [[nodiscard]] std::vector<Vertex> decode() const;
+
+    [[nodiscard]] bool operator ==(const std::vector<Vertex> &mapping) const;
+
+private:
+    [[nodiscard]] static uint32_t popCount(uint64_t word) {
+#ifdef __GNUC__
+        return uint32_t(__builtin_popcountll(word));
+#else
+        return uint32_t(std::bitset<64>(word).count());
+#endif
+    }
+};
+
+/**
+ * @brief deduplicates the vertex mappings of condensations, identical mappings are stored once.
+ * Safe to use from multiple threads, identical mappings that are inserted at the same time may both be stored.
+ */
+class VertexMappingStore {
+private:
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, std::shared_ptr<const VertexMapping>> mappings;
+
+public:
+    /**
+     * @brief returns the stored mapping that is identical to mapping, or stores mapping if there is none.
+     */
+    std::shared_ptr<const VertexMapping> insert(std::vector<Vertex> &&mapping);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @brief layout of the binary graph format, which stores the optimized arrays of a LabeledEdgeGraph.
+ *
+ * The header is followed by the forward offsets, targets and labels and then the same three arrays for the reverse
+ * direction. If the graph is grouped by label, the run offsets, labels and starts of both directions follow.
+ * Every array starts at a multiple of 8 bytes, such that the arrays can be used directly from a mapped file.
+ */
+struct BinaryGraphHeader {
+    static constexpr char expectedMagic[8] = { 'L', 'C', 'R', 'G', 'R', 'A', 'P', 'H' };
+    static constexpr uint32_t currentVersion = 1;
+
+    // Set for every file written by the BinaryGraphWriter, the reader also accepts ungrouped graphs.
+    static constexpr uint32_t labelGroupedFlag = 1u;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+
+    uint64_t vertexCount;
+    uint64_t labelCount;
+    uint64_t edgeCount;
+
+    uint64_t runCount;
+    uint64_t reverseRunCount;
+
+    [[nodiscard]] bool isValid() const {
+        return std::equal(magic, magic + 8, expectedMagic) && version == currentVersion;
+    }
+
+    [[nodiscard]] bool isLabelGrouped() const {
+        return (flags & labelGroupedFlag) != 0;
+    }
+
+    /**
+     * @brief rounds the size of an array up to the alignment of the arrays in the file.
+     */
+    [[nodiscard]] static uint64_t alignedSize(uint64_t bytes) {
+        return (bytes + 7) & ~uint64_t(7);
+    }
+
+    /**
+     * @brief the number of bytes of the file, including the header.
+     */
+    [[nodiscard]] uint64_t fileSize() const {
+        auto offsetsSize = alignedSize((vertexCount + 1) * sizeof(uint32_t));
+        auto edgesSize = alignedSize(edgeCount * sizeof(Vertex)) + alignedSize(edgeCount * sizeof(Label));
+
+        auto size = alignedSize(sizeof(BinaryGraphHeader)) + 2 * (offsetsSize + edgesSize);
+
+        if (isLabelGrouped()) {
+            size += 2 * offsetsSize;
+            size += alignedSize(runCount * sizeof(Label)) + alignedSize((runCount + 1) * sizeof(uint32_t));
+            size += alignedSize(reverseRunCount * sizeof(Label)) +
+                    alignedSize((reverseRunCount + 1) * sizeof(uint32_t));
+        }
+
+        return size;
+    }
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * @brief layout of the binary query format, which stores a query set as arrays.
+ *
+ * The header is followed by the sources, the targets, the label offsets and the labels of the queries. The labels of
+ * query i are stored in [labelOffsets[i], labelOffsets[i + 1]), reachability queries have no labels. Every array
+ * starts at a multiple of 8 bytes, such that the arrays can be used directly from a mapped file.
+ */
+struct BinaryQueryHeader {
+    static constexpr char expectedMagic[8] = { 'L', 'C', 'R', 'Q', 'U', 'E', 'R', 'Y' };
+    static constexpr uint32_t currentVersion = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+
+    uint64_t queryCount;
+    uint64_t labelCount;
+    uint64_t labelEntryCount;
+
+    [[nodiscard]] bool isValid() const {
+        return std::equal(magic, magic + 8, expectedMagic) && version == currentVersion;
+    }
+
+    /**
+     * @brief rounds the size of an array up to the alignment of the arrays in the file.
+     */
+    [[nodiscard]] static uint64_t alignedSize(uint64_t bytes) {
+        return (bytes + 7) & ~uint64_t(7);
+    }
+
+    /**
+     * @brief the number of bytes of the file, including the header.
+     */
+    [[nodiscard]] uint64_t fileSize() const {
+        return alignedSize(sizeof(BinaryQueryHeader)) + 2 * alignedSize(queryCount * sizeof(Vertex)) +
+               alignedSize((queryCount + 1) * sizeof(uint64_t)) + alignedSize(labelEntryCount * sizeof(Label));
+    }
+};
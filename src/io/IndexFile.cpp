@@ -0,0 +1,280 @@
+#include "IndexFile.hpp"
+#include "graphs/SCCGraph.hpp"
+#include "graphs/LabeledEdgeGraph.hpp"
+#include "utility/MappedFile.hpp"
+#include "dataStructures/BloomLabels.hpp"
+
+static uint64_t mixEdge(uint64_t source, uint64_t target, uint64_t label) {
+    // Splitmix64 finalizer, such that summing the hashes of the edges does not cancel out.
+    uint64_t hash = ((source << 32u) | target) + (label + 1) * 0x9e3779b97f4a7c15ull;
+    hash = (hash ^ (hash >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27u)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31u);
+}
+
+uint64_t graphFingerprint(const LabeledEdgeGraph &graph) {
+    uint64_t fingerprint = 0;
+
+    for (auto source = 0u; source < graph.getVertexCount(); source++) {
+        auto it = graph.getConnected(source);
+
+        while (it.next()) {
+            fingerprint += mixEdge(source, it->target, it->label);
+        }
+    }
+
+    return fingerprint;
+}
+
+uint64_t graphFingerprint(const DiGraph &graph) {
+    uint64_t fingerprint = 0;
+
+    for (auto source = 0u; source < graph.getVertexCount(); source++) {
+        for (auto target : graph.getConnected(source)) {
+            fingerprint += mixEdge(source, target, 0);
+        }
+    }
+
+    return fingerprint;
+}
+
+IndexWriter::IndexWriter(const std::string &filePath) : file(filePath, std::ios::binary | std::ios::trunc) { }
+
+void IndexWriter::writeBytes(const char *data, uint64_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+
+    file.write(data, std::streamsize(bytes));
+    position += bytes;
+}
+
+void IndexWriter::align() {
+    static const char padding[8] = { };
+
+    writeBytes(padding, ((position + 7) & ~uint64_t(7)) - position);
+}
+
+void IndexWriter::writeHeader(const IndexFileHeader &header, const std::string &name) {
+    write(header);
+    write(name);
+}
+
+void IndexWriter::write(const std::string &value) {
+    write(value.data(), value.size());
+}
+
+void IndexWriter::write(const LabelSet &labelSet) {
+    write(uint64_t(labelSet.size()));
+    write(labelSet.data(), labelSet.num_blocks());
+}
+
+void IndexWriter::write(const boost::dynamic_bitset<> &bits) {
+    std::vector<boost::dynamic_bitset<>::block_type> blocks(bits.num_blocks());
+    boost::to_block_range(bits, blocks.begin());
+
+    write(uint64_t(bits.size()));
+    write(blocks);
+}
+
+void IndexWriter::write(const std::vector<bool> &bits) {
+    boost::dynamic_bitset<> packed(bits.size());
+
+    for (auto i = 0u; i < bits.size(); i++) {
+        packed[i] = bits[i];
+    }
+
+    write(packed);
+}
+
+void IndexWriter::write(const BloomLabels &labels) {
+    write(labels.getWords());
+    write(labels.data(), labels.size());
+}
+
+void IndexWriter::write(const std::vector<std::vector<std::pair<Vertex, LabelSet>>> &entries) {
+    // All label sets of an index have the same size, thus their blocks are stored as one array.
+    uint64_t labelBits = 0;
+    std::vector<std::vector<Vertex>> vertices(entries.size());
+    std::vector<LabelSet::block_type> blocks;
+
+    for (auto i = 0u; i < entries.size(); i++) {
+        for (auto &entry : entries[i]) {
+            labelBits = entry.second.size();
+            vertices[i].emplace_back(entry.first);
+            blocks.insert(blocks.end(), entry.second.data(), entry.second.data() + entry.second.num_blocks());
+        }
+    }
+
+    write(labelBits);
+    write(vertices);
+    write(blocks);
+}
+
+void IndexWriter::write(const SCCGraph &graph) {
+    write(uint64_t(graph.getComponentCount()));
+
+    if (graph.isVertexMappingShared()) {
+        write(graph.getSharedVertexMapping().decode());
+    } else {
+        write(graph.getVertexMapping());
+    }
+
+    write(uint8_t(graph.hasComponentGraph()));
+
+    if (graph.hasComponentGraph()) {
+        auto &componentGraph = graph.getComponentGraph();
+        std::vector<std::vector<Vertex>> adjacency(componentGraph.getVertexCount());
+
+        for (auto component = 0u; component < componentGraph.getVertexCount(); component++) {
+            adjacency[component] = componentGraph.getConnected(component);
+        }
+
+        write(adjacency);
+    }
+}
+
+IndexReader::IndexReader(std::shared_ptr<const MappedFile> mappedFile) : file(std::move(mappedFile)),
+                                                                         data(file->getData()),
+                                                                         size(file->getSize()) { }
+
+const char *IndexReader::readBytes(uint64_t bytes) {
+    if (bytes > size - position) {
+        std::cerr << "Index file is truncated!" << std::fatal;
+    }
+
+    auto *bytesRead = data + position;
+    position += bytes;
+    return bytesRead;
+}
+
+void IndexReader::align() {
+    position = std::min(size, (position + 7) & ~uint64_t(7));
+}
+
+void IndexReader::readHeader(IndexFileHeader &header, std::string &name) {
+    if (size < sizeof(IndexFileHeader)) {
+        std::cerr << "Invalid index header!" << std::fatal;
+    }
+
+    header = read<IndexFileHeader>();
+
+    if (!header.isValid()) {
+        std::cerr << "Invalid index header!" << std::fatal;
+    }
+
+    read(name);
+}
+
+void IndexReader::read(std::string &value) {
+    uint64_t count;
+    auto *array = readArray<char>(count);
+    value.assign(array, count);
+}
+
+void IndexReader::read(LabelSet &labelSet) {
+    auto bits = read<uint64_t>();
+
+    uint64_t count;
+    auto *blocks = readArray<LabelSet::block_type>(count);
+
+    labelSet = LabelSet(bits);
+
+    if (count != labelSet.num_blocks()) {
+        std::cerr << "Index file is corrupt!" << std::fatal;
+    }
+
+    std::copy(blocks, blocks + count, labelSet.data());
+}
+
+void IndexReader::read(boost::dynamic_bitset<> &bits) {
+    auto bitCount = read<uint64_t>();
+
+    std::vector<boost::dynamic_bitset<>::block_type> blocks;
+    read(blocks);
+
+    bits.clear();
+    bits.append(blocks.begin(), blocks.end());
+    bits.resize(bitCount);
+}
+
+void IndexReader::read(std::vector<bool> &bits) {
+    boost::dynamic_bitset<> packed;
+    read(packed);
+
+    bits.resize(packed.size());
+
+    for (auto i = 0u; i < packed.size(); i++) {
+        bits[i] = packed[i];
+    }
+}
+
+void IndexReader::read(BloomLabels &labels) {
+    auto words = read<uint32_t>();
+
+    uint64_t count;
+    auto *array = readArray<uint32_t>(count);
+
+    if (words == 0 ? count != 0 : count % words != 0) {
+        std::cerr << "Index file is corrupt!" << std::fatal;
+    }
+
+    // The rows are copied, as the arrays in the file are not aligned for the vector kernels.
+    labels.resize(words == 0 ? 0 : count / words, words);
+    std::copy(array, array + count, labels[0]);
+}
+
+void IndexReader::read(std::unique_ptr<SCCGraph> &graph) {
+    auto componentCount = read<uint64_t>();
+
+    std::vector<Vertex> vertexMapping;
+    read(vertexMapping);
+
+    if (read<uint8_t>() == 0) {
+        graph = std::make_unique<SCCGraph>(componentCount, std::move(vertexMapping));
+        return;
+    }
+
+    std::vector<std::vector<Vertex>> adjacency;
+    read(adjacency);
+
+    auto componentGraph = std::make_unique<DiGraph>();
+    componentGraph->setVertices(adjacency.size());
+
+    for (auto component = 0u; component < adjacency.size(); component++) {
+        componentGraph->addEdgesNoChecks(component, adjacency[component]);
+    }
+
+    graph = std::make_unique<SCCGraph>(std::move(componentGraph), std::move(vertexMapping));
+}
+
+void IndexReader::read(std::vector<std::vector<std::pair<Vertex, LabelSet>>> &entries) {
+    auto labelBits = read<uint64_t>();
+
+    std::vector<std::vector<Vertex>> vertices;
+    std::vector<LabelSet::block_type> blocks;
+
+    read(vertices);
+    read(blocks);
+
+    LabelSet labelSet(labelBits);
+    auto words = labelSet.num_blocks();
+    auto *block = blocks.data();
+
+    entries.resize(vertices.size());
+
+    for (auto i = 0u; i < vertices.size(); i++) {
+        entries[i].clear();
+        entries[i].reserve(vertices[i].size());
+
+        for (auto vertex : vertices[i]) {
+            if (block + words > blocks.data() + blocks.size()) {
+                std::cerr << "Index file is corrupt!" << std::fatal;
+            }
+
+            std::copy(block, block + words, labelSet.data());
+            entries[i].emplace_back(vertex, labelSet);
+            block += words;
+        }
+    }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "graphs/Definitions.hpp"
+#include "dataStructures/MappedArray.hpp"
+
+class MappedFile;
+class BloomLabels;
+
+/**
+ * @brief header of a persisted index.
+ *
+ * The header is followed by the name of the index, which encodes its parameters, and then the data of the index.
+ * The fingerprint identifies the graph the index was trained on, such that an index is never loaded for a different
+ * graph. Arrays start at a multiple of 8 bytes, such that they can be used directly from a mapped file.
+ */
+struct IndexFileHeader {
+    static constexpr char expectedMagic[8] = { 'L', 'C', 'R', 'I', 'N', 'D', 'E', 'X' };
+    static constexpr uint32_t currentVersion = 3;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+
+    uint64_t vertexCount;
+    uint64_t labelCount;
+    uint64_t edgeCount;
+    uint64_t fingerprint;
+
+    [[nodiscard]] bool isValid() const {
+        return std::equal(magic, magic + 8, expectedMagic) && version == currentVersion;
+    }
+};
+
+/**
+ * @brief hash over the edges of the graph, independent of the order in which the edges are stored.
+ */
+uint64_t graphFingerprint(const LabeledEdgeGraph &graph);
+uint64_t graphFingerprint(const DiGraph &graph);
+
+/**
+ * @brief writes the data of an index to a file.
+ * Vectors are written as their size followed by their elements, nested vectors are flattened into offsets and
+ * elements. Elements of vectors are written as is, thus they must be plain data.
+ */
+class IndexWriter {
+private:
+    std::ofstream file;
+    uint64_t position = 0;
+
+    void writeBytes(const char *data, uint64_t bytes);
+    void align();
+
+public:
+    explicit IndexWriter(const std::string &filePath);
+
+    [[nodiscard]] bool fail() const {
+        return file.fail();
+    }
+
+    void writeHeader(const IndexFileHeader &header, const std::string &name);
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be written directly");
+        writeBytes(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void write(const T *data, uint64_t count) {
+        write(count);
+        align();
+        writeBytes(reinterpret_cast<const char *>(data), count * sizeof(T));
+        align();
+    }
+
+    template<typename T>
+    void write(const std::vector<T> &values) {
+        write(values.data(), values.size());
+    }
+
+    template<typename T>
+    void write(const std::vector<std::vector<T>> &values) {
+        std::vector<uint64_t> offsets(values.size() + 1, 0);
+
+        for (auto i = 0u; i < values.size(); i++) {
+            offsets[i + 1] = offsets[i] + values[i].size();
+        }
+
+        write(offsets);
+        write(offsets.back());
+        align();
+
+        for (auto &inner : values) {
+            writeBytes(reinterpret_cast<const char *>(inner.data()), inner.size() * sizeof(T));
+        }
+
+        align();
+    }
+
+    void write(const std::string &value);
+    void write(const LabelSet &labelSet);
+    void write(const boost::dynamic_bitset<> &bits);
+    void write(const std::vector<bool> &bits);
+    void write(const BloomLabels &labels);
+    void write(const std::vector<std::vector<std::pair<Vertex, LabelSet>>> &entries);
+
+    /**
+     * @brief writes the vertex mapping and, if it was kept, the component graph.
+     * The vertices of the components are not written.
+     */
+    void write(const SCCGraph &graph);
+};
+
+/**
+ * @brief reads the data of an index from a mapped file, in the order it was written by the IndexWriter.
+ * Mapped arrays view their elements in the file, all other values are copied.
+ */
+class IndexReader {
+private:
+    std::shared_ptr<const MappedFile> file;
+    const char *data;
+    uint64_t size;
+    uint64_t position = 0;
+
+    const char *readBytes(uint64_t bytes);
+    void align();
+
+    template<typename T>
+    const T *readArray(uint64_t &count) {
+        count = read<uint64_t>();
+        align();
+
+        if (count > (size - position) / sizeof(T)) {
+            std::cerr << "Index file is truncated!" << std::fatal;
+        }
+
+        auto *array = reinterpret_cast<const T *>(readBytes(count * sizeof(T)));
+        align();
+
+        return array;
+    }
+
+public:
+    explicit IndexReader(std::shared_ptr<const MappedFile> mappedFile);
+
+    void readHeader(IndexFileHeader &header, std::string &name);
+
+    [[nodiscard]] bool atEnd() const {
+        return position == size;
+    }
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be read directly");
+        T value;
+        auto *bytes = readBytes(sizeof(T));
+        std::copy(bytes, bytes + sizeof(T), reinterpret_cast<char *>(&value));
+        return value;
+    }
+
+    template<typename T>
+    void read(T &value) {
+        value = read<T>();
+    }
+
+    template<typename T>
+    void read(std::vector<T> &values) {
+        uint64_t count;
+        auto *array = readArray<T>(count);
+        values.assign(array, array + count);
+    }
+
+    template<typename T>
+    void read(MappedArray<T> &values) {
+        uint64_t count;
+        auto *array = readArray<T>(count);
+        values.map(array, count, file);
+    }
+
+    template<typename T>
+    void read(std::vector<std::vector<T>> &values) {
+        std::vector<uint64_t> offsets;
+        read(offsets);
+
+        uint64_t count;
+        auto *array = readArray<T>(count);
+
+        if (offsets.empty() || offsets.back() != count) {
+            std::cerr << "Index file is corrupt!" << std::fatal;
+        }
+
+        // Every slice ends where the next one starts, thus the offsets can not go backwards.
+        for (auto i = 1u; i < offsets.size(); i++) {
+            if (offsets[i] < offsets[i - 1]) {
+                std::cerr << "Index file is corrupt!" << std::fatal;
+            }
+        }
+
+        values.resize(offsets.size() - 1);
+
+        for (auto i = 0u; i < values.size(); i++) {
+            values[i].assign(array + offsets[i], array + offsets[i + 1]);
+        }
+    }
+
+    void read(std::string &value);
+    void read(LabelSet &labelSet);
+    void read(boost::dynamic_bitset<> &bits);
+    void read(std::vector<bool> &bits);
+    void read(BloomLabels &labels);
+    void read(std::vector<std::vector<std::pair<Vertex, LabelSet>>> &entries);
+    void read(std::unique_ptr<SCCGraph> &graph);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graphs/Query.hpp"
+#include "graphs/PackedLCRQuerySet.hpp"
 
 class QueryReader {
 public:
@@ -18,5 +19,12 @@ public:
     virtual std::unique_ptr<ReachQuerySet> readQueries(const std::string &filePath) = 0;
     virtual std::unique_ptr<LCRQuerySet> readLabeledQueries(const std::string &filePath) = 0;
 
+    /**
+     * @brief reads the queries as arrays, readers of binary files view the file instead of copying it.
+     */
+    virtual std::unique_ptr<PackedLCRQuerySet> readPackedLabeledQueries(const std::string &filePath) {
+        return std::make_unique<PackedLCRQuerySet>(*readLabeledQueries(filePath));
+    }
+
     static std::unique_ptr<QueryReader> createQueryReader();
 };
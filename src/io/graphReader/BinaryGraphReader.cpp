@@ -0,0 +1,190 @@
+#include "BinaryGraphReader.hpp"
+#include "io/BinaryGraphFormat.hpp"
+#include "utility/MappedFile.hpp"
+
+/**
+ * @brief returns a pointer to the next array in the file, and moves the position past it.
+ */
+template<typename T>
+static const T *nextArray(const char *data, uint64_t &position, uint64_t count) {
+    auto *array = reinterpret_cast<const T *>(data + position);
+    position += BinaryGraphHeader::alignedSize(count * sizeof(T));
+    return array;
+}
+
+/**
+ * @brief checks that the arrays of one direction only refer to edges, vertices and labels within the graph.
+ */
+static bool isValidAdjacency(const LabeledEdgeGraph::Adjacency &adjacency, const BinaryGraphHeader &header,
+                             uint64_t runCount) {
+    auto vertexCount = header.vertexCount;
+    auto edgeCount = header.edgeCount;
+
+    if (adjacency.offsets[0] != 0 || adjacency.offsets[vertexCount] != edgeCount) {
+        return false;
+    }
+
+    for (uint64_t vertex = 0; vertex < vertexCount; vertex++) {
+        if (adjacency.offsets[vertex] > adjacency.offsets[vertex + 1]) {
+            return false;
+        }
+    }
+
+    for (uint64_t edge = 0; edge < edgeCount; edge++) {
+        if (adjacency.targets[edge] >= vertexCount || adjacency.labels[edge] >= header.labelCount) {
+            return false;
+        }
+    }
+
+    if (!header.isLabelGrouped()) {
+        return true;
+    }
+
+    if (adjacency.runOffsets[0] != 0 || adjacency.runOffsets[vertexCount] != runCount ||
+        adjacency.runStarts[runCount] != edgeCount) {
+        return false;
+    }
+
+    // The runs of a vertex cover its edges, in ascending order of their labels.
+    for (uint64_t vertex = 0; vertex < vertexCount; vertex++) {
+        auto firstRun = adjacency.runOffsets[vertex];
+        auto lastRun = adjacency.runOffsets[vertex + 1];
+
+        if (firstRun > lastRun || adjacency.runStarts[firstRun] != adjacency.offsets[vertex]) {
+            return false;
+        }
+
+        for (auto run = firstRun; run < lastRun; run++) {
+            auto label = adjacency.runLabels[run];
+
+            if (adjacency.runStarts[run] >= adjacency.runStarts[run + 1] || label >= header.labelCount ||
+                (run != firstRun && label <= adjacency.runLabels[run - 1])) {
+                return false;
+            }
+
+            for (auto edge = adjacency.runStarts[run]; edge < adjacency.runStarts[run + 1]; edge++) {
+                if (adjacency.labels[edge] != label) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<LabeledEdgeGraph> BinaryGraphReader::readLabeledEdgeGraph(const std::string &filePath) {
+    auto file = MappedFile::open(filePath);
+
+    if (file == nullptr) {
+        std::cerr << "Failed to open file: " << filePath << std::fatal;
+        return nullptr;
+    }
+
+    BinaryGraphHeader header { };
+
+    if (file->getSize() >= sizeof(BinaryGraphHeader)) {
+        std::copy(file->getData(), file->getData() + sizeof(BinaryGraphHeader), reinterpret_cast<char *>(&header));
+    }
+
+    if (!header.isValid()) {
+        std::cerr << "Invalid binary graph header! File: " << filePath << std::fatal;
+    }
+
+    // Offsets, run starts and vertices are stored in 32 bits.
+    auto maxCount = uint64_t(std::numeric_limits<uint32_t>::max());
+
+    if (header.vertexCount > maxCount || header.edgeCount > maxCount || header.runCount > maxCount ||
+        header.reverseRunCount > maxCount) {
+        std::cerr << "Binary graph file is too large! File: " << filePath << std::fatal;
+    }
+
+    if (header.fileSize() != file->getSize()) {
+        std::cerr << "Binary graph file is truncated! File: " << filePath << std::fatal;
+    }
+
+    auto *data = file->getData();
+    auto position = BinaryGraphHeader::alignedSize(sizeof(BinaryGraphHeader));
+
+    LabeledEdgeGraph::Adjacency forward;
+    LabeledEdgeGraph::Adjacency reverse;
+
+    for (auto *adjacency : { &forward, &reverse }) {
+        adjacency->offsets = nextArray<uint32_t>(data, position, header.vertexCount + 1);
+        adjacency->targets = nextArray<Vertex>(data, position, header.edgeCount);
+        adjacency->labels = nextArray<Label>(data, position, header.edgeCount);
+    }
+
+    if (header.isLabelGrouped()) {
+        forward.runOffsets = nextArray<uint32_t>(data, position, header.vertexCount + 1);
+        forward.runLabels = nextArray<Label>(data, position, header.runCount);
+        forward.runStarts = nextArray<uint32_t>(data, position, header.runCount + 1);
+
+        reverse.runOffsets = nextArray<uint32_t>(data, position, header.vertexCount + 1);
+        reverse.runLabels = nextArray<Label>(data, position, header.reverseRunCount);
+        reverse.runStarts = nextArray<uint32_t>(data, position, header.reverseRunCount + 1);
+    }
+
+    if (!isValidAdjacency(forward, header, header.runCount) ||
+        !isValidAdjacency(reverse, header, header.reverseRunCount)) {
+        std::cerr << "Binary graph file is corrupt! File: " << filePath << std::fatal;
+    }
+
+    auto graph = std::make_unique<LabeledEdgeGraph>();
+    graph->mapAdjacency(file, file->getSize(), header.vertexCount, header.labelCount, header.edgeCount,
+                        header.isLabelGrouped(), forward, reverse);
+
+    return graph;
+}
+
+std::unique_ptr<DiGraph> BinaryGraphReader::readGraph(const std::string &filePath) {
+    auto labeledGraph = readLabeledEdgeGraph(filePath);
+
+    auto graph = std::make_unique<DiGraph>();
+    graph->setVertices(labeledGraph->getVertexCount());
+
+    for (auto source = 0u; source < labeledGraph->getVertexCount(); source++) {
+        auto it = labeledGraph->getConnected(source);
+
+        while (it.next()) {
+            graph->addEdge(source, it->target);
+        }
+    }
+
+    return graph;
+}
+
+std::unique_ptr<PerLabelGraph> BinaryGraphReader::readPerLabelGraph(const std::string &filePath) {
+    auto labeledGraph = readLabeledEdgeGraph(filePath);
+
+    auto graph = std::make_unique<PerLabelGraph>();
+    graph->setSizes(uint32_t(labeledGraph->getVertexCount()), uint32_t(labeledGraph->getLabelCount()));
+
+    for (auto source = 0u; source < labeledGraph->getVertexCount(); source++) {
+        auto it = labeledGraph->getConnected(source);
+
+        while (it.next()) {
+            graph->addEdge(source, it->target, it->label);
+        }
+    }
+
+    return graph;
+}
+
+std::unique_ptr<LabeledGraph> BinaryGraphReader::readLabeledGraph(const std::string &filePath) {
+    auto labeledGraph = readLabeledEdgeGraph(filePath);
+
+    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
+    edges.reserve(labeledGraph->getEdgeCount());
+
+    for (auto source = 0u; source < labeledGraph->getVertexCount(); source++) {
+        auto it = labeledGraph->getConnected(source);
+
+        while (it.next()) {
+            edges.emplace_back(source, it->target, it->label);
+        }
+    }
+
+    return createLabeledGraph(edges, uint32_t(labeledGraph->getVertexCount()),
+                              uint32_t(labeledGraph->getLabelCount()));
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "io/GraphReader.hpp"
+
+/**
+ * @brief reads graphs in the binary graph format.
+ * A LabeledEdgeGraph is mapped into memory and uses the arrays in the file directly, without parsing or copying.
+ */
+class BinaryGraphReader : public GraphReader {
+private:
+    inline static const std::string fileType = ".lcrg";
+public:
+    const std::string &fileName() override {
+        return fileType;
+    }
+
+    std::unique_ptr<DiGraph> readGraph(const std::string &filePath) override;
+
+    std::unique_ptr<PerLabelGraph> readPerLabelGraph(const std::string &filePath) override;
+    std::unique_ptr<LabeledGraph> readLabeledGraph(const std::string& filePath) override;
+    std::unique_ptr<LabeledEdgeGraph> readLabeledEdgeGraph(const std::string &filePath) override;
+};
@@ -0,0 +1,201 @@
+#include "ChunkedEdgeParser.hpp"
+#include "utility/MappedFile.hpp"
+#include "threading/ThreadPool.hpp"
+
+#include <charconv>
+
+namespace {
+    // Smaller files are not worth splitting, the threads would mostly wait on each other.
+    constexpr size_t minChunkBytes = 1u << 20u;
+
+    /**
+     * @brief the edges of one chunk, together with the largest vertex and label seen in it.
+     */
+    struct Chunk {
+        const char *begin;
+        const char *end;
+
+        std::vector<Edge> edges;
+        uint32_t vertexCount = 0;
+        uint32_t labelCount = 0;
+
+        // Points at the first line that could not be parsed, if any.
+        const char *invalidLine = nullptr;
+    };
+
+    bool isBlank(char character) {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    bool parseNumber(const char *&position, const char *end, uint32_t &value) {
+        while (position != end && isBlank(*position)) {
+            position++;
+        }
+
+        auto result = std::from_chars(position, end, value);
+        position = result.ptr;
+
+        return result.ec == std::errc();
+    }
+
+    void parseChunk(Chunk &chunk, EdgeLineLayout layout) {
+        auto *position = chunk.begin;
+
+        // Every line holds around 16 characters, reserving for that avoids most of the regrowth.
+        chunk.edges.reserve(size_t(chunk.end - chunk.begin) / 16);
+
+        while (position != chunk.end) {
+            auto *lineBegin = position;
+            auto *lineEnd = std::find(position, chunk.end, '\n');
+
+            auto *blank = lineBegin;
+
+            while (blank != lineEnd && isBlank(*blank)) {
+                blank++;
+            }
+
+            position = lineEnd == chunk.end ? lineEnd : lineEnd + 1;
+
+            if (blank == lineEnd) {
+                continue;
+            }
+
+            uint32_t values[3];
+            auto *cursor = lineBegin;
+
+            if (!parseNumber(cursor, lineEnd, values[0]) || !parseNumber(cursor, lineEnd, values[1]) ||
+                !parseNumber(cursor, lineEnd, values[2])) {
+                chunk.invalidLine = lineBegin;
+                return;
+            }
+
+            Edge edge;
+            edge.source = values[0];
+
+            if (layout == EdgeLineLayout::SourceLabelTarget) {
+                edge.label = values[1];
+                edge.target = values[2];
+            } else {
+                edge.target = values[1];
+                edge.label = values[2];
+            }
+
+            chunk.vertexCount = std::max(chunk.vertexCount, std::max(edge.source, edge.target) + 1);
+            chunk.labelCount = std::max(chunk.labelCount, edge.label + 1);
+            chunk.edges.emplace_back(edge);
+        }
+    }
+
+    const char *parseHeader(const char *begin, const char *end, ParsedEdges &parsed) {
+        auto *lineEnd = std::find(begin, end, '\n');
+        auto *cursor = begin;
+
+        uint32_t edgeCount = 0;
+
+        auto valid = parseNumber(cursor, lineEnd, parsed.vertexCount) && cursor != lineEnd && *cursor++ == ',' &&
+                     parseNumber(cursor, lineEnd, edgeCount) && cursor != lineEnd && *cursor++ == ',' &&
+                     parseNumber(cursor, lineEnd, parsed.labelCount);
+
+        if (!valid) {
+            std::cerr << "Invalid graph header!" << std::fatal;
+        }
+
+        return lineEnd == end ? lineEnd : lineEnd + 1;
+    }
+
+    /**
+     * @brief splits the range in chunks of roughly the same size, every chunk ends directly after a newline.
+     */
+    std::vector<Chunk> splitChunks(const char *begin, const char *end, size_t maxChunks) {
+        auto bytes = size_t(end - begin);
+        auto chunkCount = std::max(size_t(1), std::min(maxChunks, bytes / minChunkBytes));
+
+        std::vector<Chunk> chunks;
+        auto *chunkBegin = begin;
+
+        for (auto i = 1u; i <= chunkCount && chunkBegin != end; i++) {
+            auto *chunkEnd = end;
+
+            if (i != chunkCount) {
+                chunkEnd = std::max(chunkBegin, begin + bytes * i / chunkCount);
+                chunkEnd = std::find(chunkEnd, end, '\n');
+                chunkEnd = chunkEnd == end ? end : chunkEnd + 1;
+            }
+
+            chunks.push_back(Chunk { chunkBegin, chunkEnd });
+            chunkBegin = chunkEnd;
+        }
+
+        return chunks;
+    }
+}
+
+ParsedEdges parseEdgesParallel(const std::string &filePath, EdgeLineLayout layout, bool hasHeader) {
+    auto file = MappedFile::open(filePath);
+
+    if (file == nullptr) {
+        std::cerr << "Could not open graph file: " << filePath << std::fatal;
+    }
+
+    ParsedEdges parsed;
+
+    auto *begin = file->getData();
+    auto *end = begin + file->getSize();
+
+    if (hasHeader) {
+        begin = parseHeader(begin, end, parsed);
+    }
+
+    auto &threadPool = getThreadPool();
+    auto chunks = splitChunks(begin, end, threadPool.getNumThreads() * 4);
+
+    std::vector<std::function<void(uint32_t id)>> workGroup;
+
+    for (auto &chunk : chunks) {
+        workGroup.emplace_back([&chunk, layout](uint32_t) {
+            parseChunk(chunk, layout);
+        });
+    }
+
+    threadPool.queueWorkGroup(workGroup)->waitTillCompleted();
+
+    // Place the chunks next to each other, the offsets keep the edges in file order.
+    std::vector<size_t> offsets(chunks.size() + 1, 0);
+
+    for (auto i = 0u; i < chunks.size(); i++) {
+        auto &chunk = chunks[i];
+
+        if (chunk.invalidLine != nullptr) {
+            auto lineLength = size_t(std::find(chunk.invalidLine, end, '\n') - chunk.invalidLine);
+            std::cerr << "Invalid graph edge: " << std::string_view(chunk.invalidLine, lineLength) << std::fatal;
+        }
+
+        offsets[i + 1] = offsets[i] + chunk.edges.size();
+
+        if (!hasHeader) {
+            parsed.vertexCount = std::max(parsed.vertexCount, chunk.vertexCount);
+            parsed.labelCount = std::max(parsed.labelCount, chunk.labelCount);
+        }
+    }
+
+    if (chunks.size() == 1) {
+        parsed.edges = std::move(chunks[0].edges);
+        return parsed;
+    }
+
+    parsed.edges.resize(offsets.back());
+    workGroup.clear();
+
+    for (auto i = 0u; i < chunks.size(); i++) {
+        workGroup.emplace_back([&, i](uint32_t) {
+            std::copy(chunks[i].edges.begin(), chunks[i].edges.end(), parsed.edges.begin() + offsets[i]);
+
+            chunks[i].edges.clear();
+            chunks[i].edges.shrink_to_fit();
+        });
+    }
+
+    threadPool.queueWorkGroup(workGroup)->waitTillCompleted();
+
+    return parsed;
+}
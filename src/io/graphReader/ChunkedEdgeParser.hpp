@@ -0,0 +1,32 @@
+#pragma once
+
+#include "graphs/Definitions.hpp"
+
+/**
+ * @brief the order of the numbers on an edge line, anything after the third number is ignored.
+ */
+enum class EdgeLineLayout {
+    // "source label target .", as written for .nt files.
+    SourceLabelTarget,
+    // "source target label", as written for .edge files.
+    SourceTargetLabel
+};
+
+/**
+ * @brief the edges of a graph file, in the order they appear in the file.
+ */
+struct ParsedEdges {
+    std::vector<Edge> edges;
+
+    // Taken from the header if the file has one, otherwise derived from the largest vertex and label.
+    uint32_t vertexCount = 0;
+    uint32_t labelCount = 0;
+};
+
+/**
+ * @brief parses the edges of a graph file in parallel.
+ * The file is mapped and split in newline aligned chunks, every chunk is scanned by a thread of the pool into its own
+ * buffer. The buffers are then copied, in file order, into one edge array.
+ * If hasHeader is set, the first line holds the "vertices,edges,labels" counts of the graph.
+ */
+ParsedEdges parseEdgesParallel(const std::string &filePath, EdgeLineLayout layout, bool hasHeader);
@@ -2,6 +2,7 @@
 #include "NTriplesGraphReader.hpp"
 #include "RdfGraphReader.hpp"
 #include "EdgeGraphReader.hpp"
+#include "BinaryGraphReader.hpp"
 
 inline static bool endsWith(std::string const &value, std::string const &ending) {
     if (ending.size() > value.size()) {
@@ -68,6 +69,7 @@ std::unique_ptr<GraphReader> GraphReader::createGraphReader() {
     graphReaders.emplace_back(std::make_unique<NTriplesGraphReader>());
     graphReaders.emplace_back(std::make_unique<RdfGraphReader>());
     graphReaders.emplace_back(std::make_unique<EdgeGraphReader>());
+    graphReaders.emplace_back(std::make_unique<BinaryGraphReader>());
 
     return std::make_unique<CompositeGraphReader>(graphReaders);
 }
\ No newline at end of file
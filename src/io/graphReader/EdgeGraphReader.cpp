@@ -1,188 +1,58 @@
 #include "EdgeGraphReader.hpp"
+#include "ChunkedEdgeParser.hpp"
 
-static void readCounts(const std::string &filePath, uint32_t &vertexCount, uint32_t &labelCount, uint32_t &edgeCount) {
-    std::ifstream graphFile { filePath };
-
-    std::string line;
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    labelCount = 0;
-    vertexCount = 0;
-    edgeCount = 0;
-
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        firstPart = lineView.find_first_of(' ');
-        lastPart = lineView.find_last_of(' ');
-
-        Vertex source;
-        Label label;
-        Vertex target;
-
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + firstPart + 1);
-        label = std::stoul(lineView.data() + lastPart + 1);
-
-        vertexCount = std::max(vertexCount, std::max(source, target) + 1);
-        labelCount = std::max(labelCount, label + 1);
-        edgeCount++;
-    }
-}
-
-static void readCountsAndFill(const std::string &filePath, std::vector<std::tuple<Vertex, Vertex, Label>> &edges,
-                              uint32_t &vertexCount, uint32_t &labelCount) {
-    std::ifstream graphFile { filePath };
-
-    std::string line;
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    labelCount = 0;
-    vertexCount = 0;
-
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        firstPart = lineView.find_first_of(' ');
-        lastPart = lineView.find_last_of(' ');
-
-        Vertex source;
-        Label label;
-        Vertex target;
-
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + firstPart + 1);
-        label = std::stoul(lineView.data() + lastPart + 1);
-
-        vertexCount = std::max(vertexCount, std::max(source, target) + 1);
-        labelCount = std::max(labelCount, label + 1);
-
-        edges.emplace_back(source, label, target);
-    }
+static ParsedEdges parseEdges(const std::string &filePath) {
+    return parseEdgesParallel(filePath, EdgeLineLayout::SourceTargetLabel, false);
 }
 
 std::unique_ptr<DiGraph> EdgeGraphReader::readGraph(const std::string &filePath) {
-    std::ifstream graphFile { filePath };
-
-    std::string line;
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    uint32_t vertexCount;
-    uint32_t labelCount;
-    uint32_t edgeCount;
-
-    readCounts(filePath, vertexCount, labelCount, edgeCount);
+    auto parsed = parseEdges(filePath);
 
     auto graph = std::make_unique<DiGraph>();
-    graph->setVertices(vertexCount);
-
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        firstPart = lineView.find_first_of(' ');
-        lastPart = lineView.find_last_of(' ');
-
-        Vertex source;
-        Vertex target;
+    graph->setVertices(parsed.vertexCount);
 
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + firstPart + 1);
-
-        graph->addEdge(source, target);
+    for (auto &edge : parsed.edges) {
+        graph->addEdge(edge.source, edge.target);
     }
 
     return graph;
 }
 
-std::unique_ptr<LabeledGraph> EdgeGraphReader::readLabeledGraph(const std::string &filePath) {
-    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
-
-    uint32_t vertexCount = 0;
-    uint32_t labelCount = 0;
-
-    readCountsAndFill(filePath, edges, vertexCount, labelCount);
-    return createLabeledGraph(edges, vertexCount, labelCount);
-}
-
 std::unique_ptr<LabeledEdgeGraph> EdgeGraphReader::readLabeledEdgeGraph(const std::string &filePath) {
-    std::ifstream graphFile { filePath };
-
-    std::string line;
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    uint32_t vertexCount;
-    uint32_t labelCount;
-    uint32_t edgeCount;
+    auto parsed = parseEdges(filePath);
 
-    readCounts(filePath, vertexCount, labelCount, edgeCount);
+    auto labeledGraph = std::make_unique<LabeledEdgeGraph>();
+    labeledGraph->setSizes(parsed.vertexCount, parsed.labelCount, 0);
+    labeledGraph->addEdges(std::move(parsed.edges));
 
-    auto graph = std::make_unique<LabeledEdgeGraph>();
-    graph->setSizes(vertexCount, labelCount, edgeCount);
-
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        firstPart = lineView.find_first_of(' ');
-        lastPart = lineView.find_last_of(' ');
+    return labeledGraph;
+}
 
-        Vertex source;
-        Label label;
-        Vertex target;
+std::unique_ptr<LabeledGraph> EdgeGraphReader::readLabeledGraph(const std::string &filePath) {
+    auto parsed = parseEdges(filePath);
 
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + firstPart + 1);
-        label = std::stoul(lineView.data() + lastPart + 1);
+    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
+    edges.reserve(parsed.edges.size());
 
-        graph->addEdge(source, target, label);
+    for (auto &edge : parsed.edges) {
+        edges.emplace_back(edge.source, edge.target, edge.label);
     }
 
-    return graph;
+    parsed.edges.clear();
+    parsed.edges.shrink_to_fit();
+
+    return createLabeledGraph(edges, parsed.vertexCount, parsed.labelCount);
 }
 
 std::unique_ptr<PerLabelGraph> EdgeGraphReader::readPerLabelGraph(const std::string &filePath) {
-    std::ifstream graphFile { filePath };
-
-    std::string line;
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    uint32_t vertexCount;
-    uint32_t labelCount;
-    uint32_t edgeCount;
+    auto parsed = parseEdges(filePath);
 
-    readCounts(filePath, vertexCount, labelCount, edgeCount);
+    auto labeledGraph = std::make_unique<PerLabelGraph>();
+    labeledGraph->setSizes(parsed.vertexCount, parsed.labelCount);
 
-    auto graph = std::make_unique<PerLabelGraph>();
-    graph->setSizes(vertexCount, labelCount);
-
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        firstPart = lineView.find_first_of(' ');
-        lastPart = lineView.find_last_of(' ');
-
-        Vertex source;
-        Label label;
-        Vertex target;
-
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + firstPart + 1);
-        label = std::stoul(lineView.data() + lastPart + 1);
-
-        graph->addEdge(source, target, label);
+    for (auto &edge : parsed.edges) {
+        labeledGraph->addEdge(edge.source, edge.target, edge.label);
     }
 
-    return graph;
+    return labeledGraph;
 }
@@ -1,330 +1,175 @@
 #include "RdfGraphReader.hpp"
+#include "utility/MappedFile.hpp"
 
-std::unique_ptr<DiGraph> RdfGraphReader::readGraph(const std::string &filePath) {
-    std::string line;
-    std::ifstream graphFile { filePath };
+static bool isBlank(char character) {
+    return character == ' ' || character == '\t' || character == '\r';
+}
 
-    std::string_view lineView;
-    size_t index;
+/**
+ * @brief reads the next term of a triple: an IRI, a blank node or a literal together with its language or datatype.
+ * Returns an empty view if the line holds no more terms.
+ */
+static std::string_view nextTerm(const char *&position, const char *end) {
+    while (position != end && isBlank(*position)) {
+        position++;
+    }
 
-    std::string_view subject;
-    std::string_view object;
+    if (position == end || *position == '#') {
+        return { };
+    }
 
-    uint32_t currentIndex = 0;
-    std::unordered_map<std::string, Vertex> labelToIndex;
-    std::vector<std::pair<Vertex, Vertex>> edges;
+    auto *start = position;
 
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            subject = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            subject = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
+    if (*position == '<') {
+        position = std::find(position, end, '>');
+        position = position == end ? end : position + 1;
+    } else if (*position == '\"') {
+        // Skip escaped characters, such that an escaped quote does not close the literal.
+        for (position++; position != end && *position != '\"'; position++) {
+            if (*position == '\\' && position + 1 != end) {
+                position++;
+            }
         }
 
-        // For now skip predicate.
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            lineView = lineView.substr(index + 1);
-        }
+        position = position == end ? end : position + 1;
 
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            object = lineView.substr(0, index + 1);
-        } else {
-            index = lineView.find_first_of(' ');
-            object = lineView.substr(0, index);
+        if (position != end && *position == '@') {
+            while (position != end && !isBlank(*position) && *position != '.') {
+                position++;
+            }
+        } else if (end - position > 2 && position[0] == '^' && position[1] == '^') {
+            position = std::find(position, end, '>');
+            position = position == end ? end : position + 1;
         }
-
-        std::string subjectStr = { subject.data(), subject.size() };
-        std::string objectStr = { object.data(), object.size() };
-
-        if (labelToIndex.count(subjectStr) == 0) {
-            labelToIndex.emplace(subjectStr, currentIndex++);
+    } else {
+        while (position != end && !isBlank(*position)) {
+            position++;
         }
 
-        if (labelToIndex.count(objectStr) == 0) {
-            labelToIndex.emplace(objectStr, currentIndex++);
+        // The final dot of the triple may directly follow a blank node, the line ends after trailing blanks.
+        if (position == end && position - start > 1 && position[-1] == '.') {
+            position--;
         }
-
-        auto subjectIdx = labelToIndex[subjectStr];
-        auto objectIdx = labelToIndex[objectStr];
-
-        edges.emplace_back(subjectIdx, objectIdx);
     }
 
-    // Construct the graph.
-    auto graph = std::make_unique<DiGraph>();
-    graph->setVertices(currentIndex);
-
-    for (auto &edge : edges) {
-        graph->addEdge(edge.first, edge.second);
-    }
-
-    return graph;
+    return { start, size_t(position - start) };
 }
 
-std::unique_ptr<LabeledGraph> RdfGraphReader::readLabeledGraph(const std::string &filePath) {
-    std::string line;
-    std::ifstream graphFile { filePath };
-
-    std::string_view lineView;
-    size_t index;
-
-    std::string_view subject;
-    std::string_view predicate;
-    std::string_view object;
-
-    uint32_t currentIndex = 0;
-    uint32_t predicateIndex = 0;
+/**
+ * @brief streams the triples of the file, ids are assigned to the terms in the order they are first seen.
+ * The file is mapped, thus lines are never copied, only the first occurrence of every term is stored.
+ */
+template<typename Function>
+static void readTriples(const std::string &filePath, StringDictionary &vertices, StringDictionary &labels,
+                        Function onTriple) {
+    auto file = MappedFile::open(filePath);
+
+    if (file == nullptr) {
+        std::cerr << "Could not open graph file: " << filePath << std::fatal;
+    }
 
-    std::unordered_map<std::string, Vertex> labelToIndex;
-    std::unordered_map<std::string, Vertex> labelToLabel;
+    auto *position = file->getData();
+    auto *end = position + file->getSize();
 
-    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
-
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            subject = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            subject = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
-        }
+    while (position != end) {
+        auto *lineEnd = std::find(position, end, '\n');
+        auto *lineStart = position;
+        auto *termsEnd = lineEnd;
 
-        // For now skip predicate.
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            predicate = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            predicate = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
+        // Trailing blanks, such as the carriage return of a CRLF file, may sit between the final dot and the newline.
+        while (termsEnd != lineStart && isBlank(termsEnd[-1])) {
+            termsEnd--;
         }
 
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            object = lineView.substr(0, index + 1);
-        } else {
-            index = lineView.find_first_of(' ');
-            object = lineView.substr(0, index);
-        }
+        auto subject = nextTerm(position, termsEnd);
 
-        std::string subjectStr = { subject.data(), subject.size() };
-        std::string predicateStr = { predicate.data(), predicate.size() };
-        std::string objectStr = { object.data(), object.size() };
+        if (!subject.empty()) {
+            auto predicate = nextTerm(position, termsEnd);
+            auto object = nextTerm(position, termsEnd);
 
-        if (labelToIndex.count(subjectStr) == 0) {
-            labelToIndex.emplace(subjectStr, currentIndex++);
-        }
+            if (predicate.empty() || object.empty()) {
+                std::cerr << "Invalid rdf triple: " << std::string_view(lineStart, size_t(lineEnd - lineStart))
+                          << std::fatal;
+            }
 
-        if (labelToLabel.count(predicateStr) == 0) {
-            labelToLabel.emplace(predicateStr, predicateIndex++);
-        }
+            auto source = vertices.insert(subject);
+            auto label = labels.insert(predicate);
+            auto target = vertices.insert(object);
 
-        if (labelToIndex.count(objectStr) == 0) {
-            labelToIndex.emplace(objectStr, currentIndex++);
+            onTriple(source, target, label);
         }
 
-        auto source = labelToIndex[subjectStr];
-        auto label = labelToLabel[predicateStr];
-        auto target = labelToIndex[objectStr];
-
-        edges.emplace_back(source, target, label);
+        position = lineEnd == end ? end : lineEnd + 1;
     }
-
-    return createLabeledGraph(edges, labelToIndex.size(), labelToLabel.size());
 }
 
-std::unique_ptr<LabeledEdgeGraph> RdfGraphReader::readLabeledEdgeGraph(const std::string &filePath) {
-    std::string line;
-    std::ifstream graphFile { filePath };
-
-    std::string_view lineView;
-    size_t index;
-
-    std::string_view subject;
-    std::string_view predicate;
-    std::string_view object;
-
-    uint32_t currentIndex = 0;
-    uint32_t predicateIndex = 0;
-
-    std::unordered_map<std::string, Vertex> labelToIndex;
-    std::unordered_map<std::string, Vertex> labelToLabel;
-
-    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
-
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            subject = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            subject = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
-        }
-
-        // For now skip predicate.
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            predicate = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            predicate = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
-        }
-
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            object = lineView.substr(0, index + 1);
-        } else {
-            index = lineView.find_first_of(' ');
-            object = lineView.substr(0, index);
-        }
-
-        std::string subjectStr = { subject.data(), subject.size() };
-        std::string predicateStr = { predicate.data(), predicate.size() };
-        std::string objectStr = { object.data(), object.size() };
-
-        if (labelToIndex.count(subjectStr) == 0) {
-            labelToIndex.emplace(subjectStr, currentIndex++);
-        }
-
-        if (labelToLabel.count(predicateStr) == 0) {
-            labelToLabel.emplace(predicateStr, predicateIndex++);
-        }
-
-        if (labelToIndex.count(objectStr) == 0) {
-            labelToIndex.emplace(objectStr, currentIndex++);
-        }
+std::unique_ptr<DiGraph> RdfGraphReader::readGraph(const std::string &filePath) {
+    StringDictionary vertices;
+    StringDictionary labels;
 
-        auto source = labelToIndex[subjectStr];
-        auto label = labelToLabel[predicateStr];
-        auto target = labelToIndex[objectStr];
+    std::vector<std::pair<Vertex, Vertex>> edges;
 
-        edges.emplace_back(source, target, label);
-    }
+    readTriples(filePath, vertices, labels, [&edges](Vertex source, Vertex target, Label) {
+        edges.emplace_back(source, target);
+    });
 
-    auto graph = std::unique_ptr<LabeledEdgeGraph>();
-    graph->setSizes(labelToIndex.size(), labelToLabel.size(), edges.size());
+    // Construct the graph.
+    auto graph = std::make_unique<DiGraph>();
+    graph->setVertices(vertices.size());
 
     for (auto &edge : edges) {
-        graph->addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+        graph->addEdge(edge.first, edge.second);
     }
 
     return graph;
 }
 
-std::unique_ptr<PerLabelGraph> RdfGraphReader::readPerLabelGraph(const std::string &filePath) {
-    std::string line;
-    std::ifstream graphFile { filePath };
-
-    std::string_view lineView;
-    size_t index;
-
-    std::string_view subject;
-    std::string_view predicate;
-    std::string_view object;
-
-    uint32_t currentIndex = 0;
-    uint32_t predicateIndex = 0;
-
-    std::unordered_map<std::string, Vertex> labelToIndex;
-    std::unordered_map<std::string, Vertex> labelToLabel;
+std::unique_ptr<LabeledGraph> RdfGraphReader::readLabeledGraph(const std::string &filePath) {
+    StringDictionary vertices;
+    StringDictionary labels;
 
     std::vector<std::tuple<Vertex, Vertex, Label>> edges;
 
-    // parse edge data
-    while (std::getline(graphFile, line)) {
-        lineView = line;
-
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            subject = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            subject = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
-        }
+    readTriples(filePath, vertices, labels, [&edges](Vertex source, Vertex target, Label label) {
+        edges.emplace_back(source, target, label);
+    });
 
-        // For now skip predicate.
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            predicate = lineView.substr(0, index + 1);
-            lineView = lineView.substr(index + 2);
-        } else {
-            index = lineView.find_first_of(' ');
-            predicate = lineView.substr(0, index);
-            lineView = lineView.substr(index + 1);
-        }
+    return createLabeledGraph(edges, vertices.size(), labels.size());
+}
 
-        if (lineView[0] == '\"') {
-            // Find closing.
-            index = lineView.find_first_of('\"', 1);
-            object = lineView.substr(0, index + 1);
-        } else {
-            index = lineView.find_first_of(' ');
-            object = lineView.substr(0, index);
-        }
+std::unique_ptr<LabeledEdgeGraph> RdfGraphReader::readLabeledEdgeGraph(const std::string &filePath) {
+    StringDictionary vertices;
+    StringDictionary labels;
 
-        std::string subjectStr = { subject.data(), subject.size() };
-        std::string predicateStr = { predicate.data(), predicate.size() };
-        std::string objectStr = { object.data(), object.size() };
+    return readLabeledEdgeGraph(filePath, vertices, labels);
+}
 
-        if (labelToIndex.count(subjectStr) == 0) {
-            labelToIndex.emplace(subjectStr, currentIndex++);
-        }
+std::unique_ptr<LabeledEdgeGraph> RdfGraphReader::readLabeledEdgeGraph(const std::string &filePath,
+                                                                       StringDictionary &vertices,
+                                                                       StringDictionary &labels) {
+    auto graph = std::make_unique<LabeledEdgeGraph>();
 
-        if (labelToLabel.count(predicateStr) == 0) {
-            labelToLabel.emplace(predicateStr, predicateIndex++);
-        }
+    // The edges go straight into the buffer of the graph, the sizes are only known once all terms are seen.
+    readTriples(filePath, vertices, labels, [&graph](Vertex source, Vertex target, Label label) {
+        graph->addEdge(source, target, label);
+    });
 
-        if (labelToIndex.count(objectStr) == 0) {
-            labelToIndex.emplace(objectStr, currentIndex++);
-        }
+    graph->setSizes(vertices.size(), labels.size(), 0);
+    return graph;
+}
 
-        auto source = labelToIndex[subjectStr];
-        auto label = labelToLabel[predicateStr];
-        auto target = labelToIndex[objectStr];
+std::unique_ptr<PerLabelGraph> RdfGraphReader::readPerLabelGraph(const std::string &filePath) {
+    StringDictionary vertices;
+    StringDictionary labels;
 
+    std::vector<std::tuple<Vertex, Vertex, Label>> edges;
+
+    readTriples(filePath, vertices, labels, [&edges](Vertex source, Vertex target, Label label) {
         edges.emplace_back(source, target, label);
-    }
+    });
 
-    auto graph = std::unique_ptr<PerLabelGraph>();
-    graph->setSizes(labelToIndex.size(), labelToLabel.size());
+    auto graph = std::make_unique<PerLabelGraph>();
+    graph->setSizes(vertices.size(), labels.size());
 
     for (auto &edge : edges) {
         graph->addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "io/GraphReader.hpp"
+#include "dataStructures/StringDictionary.hpp"
 
 // RDF files are the same as .nt files.
 // However RDF files are writen with tags instead of ids.
@@ -17,4 +18,11 @@ public:
     std::unique_ptr<PerLabelGraph> readPerLabelGraph(const std::string &filePath) override;
     std::unique_ptr<LabeledGraph> readLabeledGraph(const std::string& filePath) override;
     std::unique_ptr<LabeledEdgeGraph> readLabeledEdgeGraph(const std::string &filePath) override;
+
+    /**
+     * @brief reads the graph in a single pass, the subjects and objects become vertices and the predicates labels.
+     * The dictionaries hold the term of every vertex and label id afterwards, such that they can be persisted.
+     */
+    std::unique_ptr<LabeledEdgeGraph> readLabeledEdgeGraph(const std::string &filePath, StringDictionary &vertices,
+                                                           StringDictionary &labels);
 };
@@ -0,0 +1,134 @@
+#include "BinaryGraphWriter.hpp"
+#include "io/BinaryGraphFormat.hpp"
+
+template<typename T>
+static void writeArray(std::ofstream &graphFile, const T *data, uint64_t count) {
+    static const char padding[8] = { };
+
+    auto bytes = count * sizeof(T);
+
+    if (bytes != 0) {
+        graphFile.write(reinterpret_cast<const char *>(data), std::streamsize(bytes));
+    }
+
+    graphFile.write(padding, std::streamsize(BinaryGraphHeader::alignedSize(bytes) - bytes));
+}
+
+bool BinaryGraphWriter::writeGraph(const DiGraph &graph, const std::string &filePath) {
+    LabeledEdgeGraph labeledGraph;
+    labeledGraph.setSizes(uint32_t(graph.getVertexCount()), 1, uint32_t(graph.getEdgeCount()));
+
+    for (auto source = 0u; source < graph.getVertexCount(); source++) {
+        for (auto target : graph.getConnected(source)) {
+            labeledGraph.addEdge(source, target, 0);
+        }
+    }
+
+    labeledGraph.groupByLabel();
+    labeledGraph.optimize();
+    return writeLabeledGraph(labeledGraph, filePath);
+}
+
+bool BinaryGraphWriter::writeLabeledGraph(const PerLabelGraph &graph, const std::string &filePath) {
+    LabeledEdgeGraph labeledGraph;
+    labeledGraph.setSizes(graph.getVertexCount(), graph.getLabelCount(), graph.getEdgeCount());
+
+    for (auto label = 0u; label < graph.getLabelCount(); label++) {
+        for (auto source = 0u; source < graph.getVertexCount(); source++) {
+            for (auto target : graph.getConnected(source, label)) {
+                labeledGraph.addEdge(source, target, label);
+            }
+        }
+    }
+
+    labeledGraph.groupByLabel();
+    labeledGraph.optimize();
+    return writeLabeledGraph(labeledGraph, filePath);
+}
+
+bool BinaryGraphWriter::writeLabeledGraph(const LabeledGraph &graph, const std::string &filePath) {
+    LabeledEdgeGraph labeledGraph;
+    labeledGraph.setSizes(uint32_t(graph.getVertexCount()), uint32_t(graph.getLabelCount()),
+                          uint32_t(graph.getEdgeCount()));
+
+    for (auto source = 0u; source < graph.getVertexCount(); source++) {
+        for (auto &target : graph.getConnected(source)) {
+            for (auto label = 0u; label < target.second.size(); label++) {
+                if (target.second[label]) {
+                    labeledGraph.addEdge(source, target.first, label);
+                }
+            }
+        }
+    }
+
+    labeledGraph.groupByLabel();
+    labeledGraph.optimize();
+    return writeLabeledGraph(labeledGraph, filePath);
+}
+
+bool BinaryGraphWriter::writeLabeledGraph(const LabeledEdgeGraph &graph, const std::string &filePath) {
+    // The query runners group graphs by label, storing them grouped keeps the mapped arrays usable as is.
+    if (!graph.isLabelGrouped()) {
+        LabeledEdgeGraph groupedGraph;
+        groupedGraph.setSizes(uint32_t(graph.getVertexCount()), uint32_t(graph.getLabelCount()),
+                              uint32_t(graph.getEdgeCount()));
+        groupedGraph.groupByLabel();
+
+        for (auto source = 0u; source < graph.getVertexCount(); source++) {
+            auto it = graph.getConnected(source);
+
+            while (it.next()) {
+                groupedGraph.addEdge(source, it->target, it->label);
+            }
+        }
+
+        groupedGraph.optimize();
+        return writeLabeledGraph(groupedGraph, filePath);
+    }
+
+    std::ofstream graphFile { filePath, std::ios::binary };
+
+    if (graphFile.fail()) {
+        std::cerr << "Failed to open file: " << filePath << " for write" << std::fatal;
+        return false;
+    }
+
+    auto &forward = graph.getAdjacency();
+    auto &reverse = graph.getReverseAdjacency();
+
+    BinaryGraphHeader header { };
+    std::copy(BinaryGraphHeader::expectedMagic, BinaryGraphHeader::expectedMagic + 8, header.magic);
+    header.version = BinaryGraphHeader::currentVersion;
+    header.flags = graph.isLabelGrouped() ? BinaryGraphHeader::labelGroupedFlag : 0u;
+
+    // Only the packed edges are written, the graph is expected to be optimized.
+    header.vertexCount = graph.getVertexCount();
+    header.labelCount = graph.getLabelCount();
+    header.edgeCount = graph.getVertexCount() == 0 ? 0 : forward.offsets[graph.getVertexCount()];
+
+    if (graph.isLabelGrouped()) {
+        header.runCount = forward.runOffsets[graph.getVertexCount()];
+        header.reverseRunCount = reverse.runOffsets[graph.getVertexCount()];
+    }
+
+    writeArray(graphFile, &header, 1);
+
+    for (auto *adjacency : { &forward, &reverse }) {
+        writeArray(graphFile, adjacency->offsets, header.vertexCount + 1);
+        writeArray(graphFile, adjacency->targets, header.edgeCount);
+        writeArray(graphFile, adjacency->labels, header.edgeCount);
+    }
+
+    if (graph.isLabelGrouped()) {
+        writeArray(graphFile, forward.runOffsets, header.vertexCount + 1);
+        writeArray(graphFile, forward.runLabels, header.runCount);
+        writeArray(graphFile, forward.runStarts, header.runCount + 1);
+
+        writeArray(graphFile, reverse.runOffsets, header.vertexCount + 1);
+        writeArray(graphFile, reverse.runLabels, header.reverseRunCount);
+        writeArray(graphFile, reverse.runStarts, header.reverseRunCount + 1);
+    }
+
+    std::flush(graphFile);
+    return !graphFile.fail();
+}
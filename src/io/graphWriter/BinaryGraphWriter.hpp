@@ -0,0 +1,22 @@
+#pragma once
+
+#include "io/GraphWriter.hpp"
+
+/**
+ * @brief writes graphs in the binary graph format, which can be mapped into memory directly when read.
+ * Graphs are always stored as a LabeledEdgeGraph grouped by label, other graphs are converted first.
+ */
+class BinaryGraphWriter : public GraphWriter {
+private:
+    inline static const std::string fileType = ".lcrg";
+public:
+    const std::string &fileName() override {
+        return fileType;
+    }
+
+    bool writeGraph(const DiGraph& graph, const std::string& filePath) override;
+
+    bool writeLabeledGraph(const PerLabelGraph& graph, const std::string& filePath) override;
+    bool writeLabeledGraph(const LabeledGraph& graph, const std::string& filePath) override;
+    bool writeLabeledGraph(const LabeledEdgeGraph& graph, const std::string& filePath) override;
+};
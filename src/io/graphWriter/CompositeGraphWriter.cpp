@@ -2,6 +2,7 @@
 #include "NTriplesGraphWriter.hpp"
 #include "DotGraphWriter.hpp"
 #include "EdgeGraphWriter.hpp"
+#include "BinaryGraphWriter.hpp"
 
 inline static bool endsWith(std::string const &value, std::string const &ending) {
     if (ending.size() > value.size()) {
@@ -76,6 +77,7 @@ std::unique_ptr<GraphWriter> GraphWriter::createGraphWriter() {
     graphWriters.emplace_back(std::make_unique<NTriplesGraphWriter>());
     graphWriters.emplace_back(std::make_unique<DotGraphWriter>());
     graphWriters.emplace_back(std::make_unique<EdgeGraphWriter>());
+    graphWriters.emplace_back(std::make_unique<BinaryGraphWriter>());
 
     return std::make_unique<CompositeGraphWriter>(graphWriters);
 }
\ No newline at end of file
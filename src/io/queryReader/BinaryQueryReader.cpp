@@ -0,0 +1,70 @@
+#include "BinaryQueryReader.hpp"
+#include "io/BinaryQueryFormat.hpp"
+#include "utility/MappedFile.hpp"
+
+/**
+ * @brief returns a pointer to the next array in the file, and moves the position past it.
+ */
+template<typename T>
+static const T *nextArray(const char *data, uint64_t &position, uint64_t count) {
+    auto *array = reinterpret_cast<const T *>(data + position);
+    position += BinaryQueryHeader::alignedSize(count * sizeof(T));
+    return array;
+}
+
+std::unique_ptr<PackedLCRQuerySet> BinaryQueryReader::readPackedLabeledQueries(const std::string &filePath) {
+    auto file = MappedFile::open(filePath);
+
+    if (file == nullptr) {
+        std::cerr << "Failed to open file: " << filePath << std::fatal;
+        return nullptr;
+    }
+
+    BinaryQueryHeader header { };
+
+    if (file->getSize() >= sizeof(BinaryQueryHeader)) {
+        std::copy(file->getData(), file->getData() + sizeof(BinaryQueryHeader), reinterpret_cast<char *>(&header));
+    }
+
+    if (!header.isValid()) {
+        std::cerr << "Invalid binary query header! File: " << filePath << std::fatal;
+    }
+
+    if (header.fileSize() != file->getSize()) {
+        std::cerr << "Binary query file is truncated! File: " << filePath << std::fatal;
+    }
+
+    auto *data = file->getData();
+    auto position = BinaryQueryHeader::alignedSize(sizeof(BinaryQueryHeader));
+
+    auto *sources = nextArray<Vertex>(data, position, header.queryCount);
+    auto *targets = nextArray<Vertex>(data, position, header.queryCount);
+    auto *labelOffsets = nextArray<uint64_t>(data, position, header.queryCount + 1);
+    auto *labels = nextArray<Label>(data, position, header.labelEntryCount);
+
+    if (labelOffsets[header.queryCount] != header.labelEntryCount) {
+        std::cerr << "Binary query file is corrupt! File: " << filePath << std::fatal;
+    }
+
+    auto queries = std::make_unique<PackedLCRQuerySet>();
+    queries->map(sources, targets, labelOffsets, labels, header.queryCount, header.labelCount, file);
+
+    return queries;
+}
+
+std::unique_ptr<ReachQuerySet> BinaryQueryReader::readQueries(const std::string &filePath) {
+    auto packedQueries = readPackedLabeledQueries(filePath);
+    auto querySet = std::make_unique<ReachQuerySet>();
+
+    querySet->reserve(packedQueries->size());
+
+    for (auto i = 0u; i < packedQueries->size(); i++) {
+        querySet->emplace_back(packedQueries->getSource(i), packedQueries->getTarget(i));
+    }
+
+    return querySet;
+}
+
+std::unique_ptr<LCRQuerySet> BinaryQueryReader::readLabeledQueries(const std::string &filePath) {
+    return std::make_unique<LCRQuerySet>(readPackedLabeledQueries(filePath)->unpack());
+}
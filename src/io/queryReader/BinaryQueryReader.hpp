@@ -0,0 +1,19 @@
+#pragma once
+
+#include "io/QueryReader.hpp"
+
+/**
+ * @brief reads query files written by the BinaryQueryWriter, the packed query sets view the mapped file.
+ */
+class BinaryQueryReader : public QueryReader {
+private:
+    inline static const std::string fileType = ".lcrq";
+public:
+    const std::string &fileName() override {
+        return fileType;
+    }
+
+    std::unique_ptr<ReachQuerySet> readQueries(const std::string &filePath) override;
+    std::unique_ptr<LCRQuerySet> readLabeledQueries(const std::string &filePath) override;
+    std::unique_ptr<PackedLCRQuerySet> readPackedLabeledQueries(const std::string &filePath) override;
+};
@@ -1,80 +1,85 @@
 #include "CSVQueryReader.hpp"
+#include "utility/MappedFile.hpp"
 
-std::unique_ptr<ReachQuerySet> CSVQueryReader::readQueries(const std::string &filePath) {
-    std::string line;
-    std::ifstream queriesFile { filePath };
-
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
-
-    auto querySet = std::make_unique<ReachQuerySet>();
+#include <charconv>
 
-    while (std::getline(queriesFile, line)) {
-        lineView = line;
+/**
+ * @brief calls onQuery for every "source,label+label+...,target" line of the file.
+ * The file is mapped and scanned with from_chars, the labels are appended to a vector that is reused between lines.
+ */
+template<typename Function>
+static void readLines(const std::string &filePath, Function onQuery) {
+    auto file = MappedFile::open(filePath);
 
-        firstPart = lineView.find_first_of(',');
-        lastPart = lineView.find_last_of(',');
-
-        Vertex source;
-        Vertex target;
+    if (file == nullptr) {
+        std::cerr << "Failed to read queries! Could not open file: " << filePath << std::fatal;
+    }
 
-        source = std::stoul(lineView.data());
-        target = std::stoul(lineView.data() + lastPart + 1);
+    auto *position = file->getData();
+    auto *end = position + file->getSize();
 
-        querySet->emplace_back(source, target);
-    }
+    std::vector<Label> labels;
 
-    return querySet;
-}
+    while (position != end) {
+        auto *lineStart = position;
+        auto *lineEnd = std::find(position, end, '\n');
 
-std::unique_ptr<LCRQuerySet> CSVQueryReader::readLabeledQueries(const std::string &filePath) {
-    std::string line;
-    std::ifstream queriesFile { filePath };
+        position = lineEnd == end ? end : lineEnd + 1;
 
-    std::string_view lineView;
-    size_t firstPart;
-    size_t lastPart;
+        if (lineStart == lineEnd || (lineEnd - lineStart == 1 && *lineStart == '\r')) {
+            continue;
+        }
 
-    auto querySet = std::make_unique<LCRQuerySet>();
+        Vertex source = 0;
+        Vertex target = 0;
 
-    while (std::getline(queriesFile, line)) {
-        lineView = line;
+        auto result = std::from_chars(lineStart, lineEnd, source);
+        auto *cursor = result.ptr;
+        auto valid = result.ec == std::errc() && cursor != lineEnd && *cursor++ == ',';
 
-        firstPart = lineView.find_first_of(',');
-        lastPart = lineView.find_last_of(',');
+        labels.clear();
 
-        Vertex source;
-        Label label;
-        std::vector<Label> labels;
-        Vertex target;
+        // Every label may be followed by a '+', the label list ends at the second ','.
+        while (valid && cursor != lineEnd && *cursor != ',') {
+            Label label;
+            result = std::from_chars(cursor, lineEnd, label);
+            cursor = result.ptr;
 
+            valid = result.ec == std::errc();
+            labels.emplace_back(label);
 
-        source = std::stoul(lineView.data());
+            if (valid && cursor != lineEnd && *cursor == '+') {
+                cursor++;
+            }
+        }
 
-        auto labelPart = lineView.substr(firstPart + 1, lastPart - firstPart - 1);
+        valid = valid && cursor != lineEnd && *cursor++ == ',' &&
+                std::from_chars(cursor, lineEnd, target).ec == std::errc();
 
-        if (labelPart.back() == '+') {
-            labelPart = labelPart.substr(0, labelPart.size() - 1);
+        if (!valid) {
+            std::cerr << "Invalid query: " << std::string_view(lineStart, size_t(lineEnd - lineStart)) << std::fatal;
         }
 
-        auto lastPos = labelPart.find('+');
+        onQuery(source, target, labels);
+    }
+}
 
-        while (lastPos != std::string_view::npos) {
-            label = std::stoul(labelPart.data());
-            labels.emplace_back(label);
+std::unique_ptr<ReachQuerySet> CSVQueryReader::readQueries(const std::string &filePath) {
+    auto querySet = std::make_unique<ReachQuerySet>();
 
-            labelPart = labelPart.substr(lastPos + 1);
-            lastPos = labelPart.find('+');
-        }
+    readLines(filePath, [&querySet](Vertex source, Vertex target, const std::vector<Label> &) {
+        querySet->emplace_back(source, target);
+    });
 
-        label = std::stoul(labelPart.data());
-        labels.emplace_back(label);
+    return querySet;
+}
 
-        target = std::stoul(lineView.data() + lastPart + 1);
+std::unique_ptr<LCRQuerySet> CSVQueryReader::readLabeledQueries(const std::string &filePath) {
+    auto querySet = std::make_unique<LCRQuerySet>();
 
+    readLines(filePath, [&querySet](Vertex source, Vertex target, const std::vector<Label> &labels) {
         querySet->emplace_back(source, target, labels);
-    }
+    });
 
     return querySet;
 }
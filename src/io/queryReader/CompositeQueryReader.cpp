@@ -1,5 +1,6 @@
 #include "CompositeQueryReader.hpp"
 #include "CSVQueryReader.hpp"
+#include "BinaryQueryReader.hpp"
 
 inline static bool endsWith(std::string const &value, std::string const &ending) {
     if (ending.size() > value.size()) {
@@ -31,9 +32,21 @@ std::unique_ptr<LCRQuerySet> CompositeQueryReader::readLabeledQueries(const std:
     return nullptr;
 }
 
+std::unique_ptr<PackedLCRQuerySet> CompositeQueryReader::readPackedLabeledQueries(const std::string &filePath) {
+    for (auto &reader : this->readers) {
+        if (endsWith(filePath, reader->fileName())) {
+            return reader->readPackedLabeledQueries(filePath);
+        }
+    }
+
+    std::cerr << "Failed to read queries! No matching queryReader for file extension! path: " << filePath << std::fatal;
+    return nullptr;
+}
+
 std::unique_ptr<QueryReader> QueryReader::createQueryReader() {
     std::vector<std::unique_ptr<QueryReader>> graphReaders;
     graphReaders.emplace_back(std::make_unique<CSVQueryReader>());
+    graphReaders.emplace_back(std::make_unique<BinaryQueryReader>());
 
     return std::make_unique<CompositeQueryReader>(graphReaders);
 }
\ No newline at end of file
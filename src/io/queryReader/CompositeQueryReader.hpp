@@ -21,4 +21,5 @@ public:
 
     std::unique_ptr<ReachQuerySet> readQueries(const std::string &filePath) override;
     std::unique_ptr<LCRQuerySet> readLabeledQueries(const std::string &filePath) override;
+    std::unique_ptr<PackedLCRQuerySet> readPackedLabeledQueries(const std::string &filePath) override;
 };
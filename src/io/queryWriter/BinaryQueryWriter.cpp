@@ -0,0 +1,60 @@
+#include "BinaryQueryWriter.hpp"
+#include "io/BinaryQueryFormat.hpp"
+#include "graphs/PackedLCRQuerySet.hpp"
+
+template<typename T>
+static void writeArray(std::ofstream &queriesFile, const T *data, uint64_t count) {
+    static const char padding[8] = { };
+
+    auto bytes = count * sizeof(T);
+
+    if (bytes != 0) {
+        queriesFile.write(reinterpret_cast<const char *>(data), std::streamsize(bytes));
+    }
+
+    queriesFile.write(padding, std::streamsize(BinaryQueryHeader::alignedSize(bytes) - bytes));
+}
+
+static bool writePackedQueries(const PackedLCRQuerySet &queries, const std::string &filePath) {
+    std::ofstream queriesFile { filePath, std::ios::binary };
+
+    if (queriesFile.fail()) {
+        std::cerr << "Failed to write queries! Could not open file!" << std::fatal;
+    }
+
+    BinaryQueryHeader header { };
+    std::copy(BinaryQueryHeader::expectedMagic, BinaryQueryHeader::expectedMagic + 8, header.magic);
+    header.version = BinaryQueryHeader::currentVersion;
+
+    header.queryCount = queries.size();
+    header.labelCount = queries.getLabelCount();
+    header.labelEntryCount = queries.getLabels().size();
+
+    // A default constructed set has no label offsets, the file always holds the offset after the last query.
+    uint64_t noLabels = 0;
+    auto *labelOffsets = queries.getLabelOffsets().empty() ? &noLabels : queries.getLabelOffsets().data();
+
+    writeArray(queriesFile, &header, 1);
+    writeArray(queriesFile, queries.getSources().data(), header.queryCount);
+    writeArray(queriesFile, queries.getTargets().data(), header.queryCount);
+    writeArray(queriesFile, labelOffsets, header.queryCount + 1);
+    writeArray(queriesFile, queries.getLabels().data(), header.labelEntryCount);
+
+    std::flush(queriesFile);
+    return !queriesFile.fail();
+}
+
+bool BinaryQueryWriter::writeQueries(const ReachQuerySet &queries, const std::string &filePath) {
+    LCRQuerySet labeledQueries;
+    labeledQueries.reserve(queries.size());
+
+    for (auto &query : queries) {
+        labeledQueries.emplace_back(query.source, query.target, std::vector<Label>());
+    }
+
+    return writePackedQueries(PackedLCRQuerySet(labeledQueries), filePath);
+}
+
+bool BinaryQueryWriter::writeLabeledQueries(const LCRQuerySet &queries, const std::string &filePath) {
+    return writePackedQueries(PackedLCRQuerySet(queries), filePath);
+}
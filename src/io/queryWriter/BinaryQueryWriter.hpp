@@ -0,0 +1,18 @@
+#pragma once
+
+#include "io/QueryWriter.hpp"
+
+/**
+ * @brief writes queries in the binary query format, see BinaryQueryHeader.
+ */
+class BinaryQueryWriter : public QueryWriter {
+private:
+    inline static const std::string fileType = ".lcrq";
+public:
+    const std::string &fileName() override {
+        return fileType;
+    }
+
+    bool writeQueries(const ReachQuerySet &queries, const std::string &filePath) override;
+    bool writeLabeledQueries(const LCRQuerySet &queries, const std::string &filePath) override;
+};
@@ -1,5 +1,6 @@
 #include "CompositeQueryWriter.hpp"
 #include "CSVQueryWriter.hpp"
+#include "BinaryQueryWriter.hpp"
 
 inline static bool endsWith(std::string const &value, std::string const &ending) {
     if (ending.size() > value.size()) {
@@ -44,6 +45,7 @@ bool CompositeQueryWriter::writeLabeledQueries(const LCRQuerySet &queries, const
 std::unique_ptr<QueryWriter> QueryWriter::createQueryWriter() {
     std::vector<std::unique_ptr<QueryWriter>> graphWriters;
     graphWriters.emplace_back(std::make_unique<CSVQueryWriter>());
+    graphWriters.emplace_back(std::make_unique<BinaryQueryWriter>());
 
     return std::make_unique<CompositeQueryWriter>(graphWriters);
 }
\ No newline at end of file
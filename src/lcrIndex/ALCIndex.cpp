@@ -1,3 +1,4 @@
+#include "CombinationBuilder.hpp"
 #include "ALCIndex.hpp"
 
 namespace lcr {
@@ -14,8 +15,11 @@ namespace lcr {
 
         uint64_t expectedCount = (1ull << uint64_t(labelCount)) - 1;
 
-        indices.reserve(expectedCount);
-        sccGraphs.reserve(expectedCount);
+        CombinationBuilder builder(getGraph(), getMemoryBudget());
+
+        auto createIndex = [this]() {
+            return ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+        };
 
         while (!stack.empty()) {
             auto current = stack.front();
@@ -30,7 +34,7 @@ namespace lcr {
                     continue;
                 }
 
-                createIndex(labelSet);
+                builder.add(labelSet, createIndex, false);
                 continue;
             }
 
@@ -41,30 +45,23 @@ namespace lcr {
             stack.emplace(labelSet, i + 1);
             stack.emplace(next, i + 1);
         }
-    }
 
-    void ALCIndex::createIndex(const LabelSet &labelSet) {
-        auto &index = indices[labelSet];
-        index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+        builder.run();
 
-        auto &labeledGraph = getGraph();
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
-        sccGraphs[labelSet] = tarjanSCC(*graph);
-        auto& sccGraph = sccGraphs[labelSet];
-
-        index->setGraph(sccGraph.get());
+        indices.reserve(expectedCount);
+        sccGraphs.reserve(expectedCount);
 
-        index->train();
+        for (auto position = 0u; position < builder.getBuildCount(); position++) {
+            auto &build = builder.getBuild(position);
 
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
+            indices[build.labelSet] = std::move(build.index);
+            sccGraphs[build.labelSet] = std::move(build.sccGraph);
         }
     }
 
-    bool ALCIndex::query(const LCRQuery &query) {
+    bool ALCIndex::query(const LCRQuery &query, QueryContext &context) const {
         ReachQuery reachQuery(query.source, query.target);
-        return indices.at(query.labelSet)->query(reachQuery);
+        return indices.at(query.labelSet)->query(reachQuery, context);
     }
 
     size_t ALCIndex::indexSize() const {
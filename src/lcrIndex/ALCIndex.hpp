@@ -22,9 +22,7 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
-
-        void createIndex(const LabelSet &labelSet);
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
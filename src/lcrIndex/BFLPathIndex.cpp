@@ -2,7 +2,7 @@
 #include "BFLPathIndex.hpp"
 
 namespace lcr {
-    void BFLPathIndex::forwardBFS(const DiGraph &graph, Vertex source, std::vector<BloomFilter> &bloomFilters) {
+    void BFLPathIndex::forwardBFS(const DiGraph &graph, Vertex source, std::vector<BlockedBloomFilter> &bloomFilters) {
         boost::dynamic_bitset<> currentVisited(graph.getVertexCount());
 
         std::deque<Vertex> queue;
@@ -29,7 +29,7 @@ namespace lcr {
         }
     }
 
-    void BFLPathIndex::reverseBFS(const DiGraph &graph, Vertex source, std::vector<BloomFilter> &bloomFilters) {
+    void BFLPathIndex::reverseBFS(const DiGraph &graph, Vertex source, std::vector<BlockedBloomFilter> &bloomFilters) {
         boost::dynamic_bitset<> currentVisited(graph.getVertexCount());
 
         std::deque<Vertex> queue;
@@ -63,12 +63,12 @@ namespace lcr {
         auto &componentGraph = sccGraph->getComponentGraph();
 
         // Step 1: create bloom filter per component.
-        std::vector<BloomFilter> toBloomFilters(componentGraph.getVertexCount());
-        std::vector<BloomFilter> fromBloomFilters(componentGraph.getVertexCount());
+        std::vector<BlockedBloomFilter> toBloomFilters(componentGraph.getVertexCount());
+        std::vector<BlockedBloomFilter> fromBloomFilters(componentGraph.getVertexCount());
 
         for (auto component = 0u; component < componentGraph.getVertexCount(); component++) {
-            toBloomFilters[component].setup(labelBitSize);
-            fromBloomFilters[component].setup(labelBitSize);
+            toBloomFilters[component].setup(labelBitSize, hashCount);
+            fromBloomFilters[component].setup(labelBitSize, hashCount);
 
             for (auto vertex : sccGraph->getVerticesForComponent(component)) {
                 toBloomFilters[component].add(vertex);
@@ -100,7 +100,7 @@ namespace lcr {
                 auto &edge = *revIt;
 
                 if (fromFilters[vertex][edge.label].empty()) {
-                    fromFilters[vertex][edge.label].setup(labelBitSize);
+                    fromFilters[vertex][edge.label].setup(labelBitSize, hashCount);
                 }
 
                 fromFilters[vertex][edge.label] |= fromBloomFilters[sccGraph->getComponentIndex(edge.target)];
@@ -112,7 +112,7 @@ namespace lcr {
                 auto &edge = *it;
 
                 if (toFilters[vertex][edge.label].empty()) {
-                    toFilters[vertex][edge.label].setup(labelBitSize);
+                    toFilters[vertex][edge.label].setup(labelBitSize, hashCount);
                 }
 
                 toFilters[vertex][edge.label] |= toBloomFilters[sccGraph->getComponentIndex(edge.target)];
@@ -120,12 +120,12 @@ namespace lcr {
         }
     }
 
-    QueryResult BFLPathIndex::queryOnce(const LCRQuery &query) {
+    QueryResult BFLPathIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
-        auto sourcePos = boost::hash_value(source) % labelBitSize;
-        auto targetPos = boost::hash_value(target) % labelBitSize;
+        auto sourceProbe = BlockedBloomFilter::probe(source, labelBitSize, hashCount);
+        auto targetProbe = BlockedBloomFilter::probe(target, labelBitSize, hashCount);
 
         bool outgoingFound = false;
         bool incomingFound = false;
@@ -134,7 +134,7 @@ namespace lcr {
             if (!outgoingFound) {
                 auto itTo = toFilters[source].find(label);
 
-                if (itTo != toFilters[source].end() && itTo->second.containsAt(targetPos)) {
+                if (itTo != toFilters[source].end() && itTo->second.contains(targetProbe)) {
                     outgoingFound = true;
                 }
             }
@@ -142,7 +142,7 @@ namespace lcr {
             if (!incomingFound) {
                 auto itFrom = fromFilters[target].find(label);
 
-                if (itFrom != fromFilters[target].end() && itFrom->second.containsAt(sourcePos)) {
+                if (itFrom != fromFilters[target].end() && itFrom->second.contains(sourceProbe)) {
                     incomingFound = true;
                 }
             }
@@ -159,7 +159,7 @@ namespace lcr {
         return QR_MaybeReachable;
     }
 
-    bool BFLPathIndex::query(const LCRQuery &query) {
+    bool BFLPathIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -175,12 +175,15 @@ namespace lcr {
             return false;
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
 
-        auto targetPos = boost::hash_value(target) % labelBitSize;
+        auto targetProbe = BlockedBloomFilter::probe(target, labelBitSize, hashCount);
 
-        visited[source] = true;
+        visited.set(source);
         queue.emplace_back(source);
 
         while (!queue.empty()) {
@@ -190,13 +193,13 @@ namespace lcr {
             bool outgoingFound = false;
             bool incomingFound = false;
 
-            auto sourcePos = boost::hash_value(source) % labelBitSize;
+            auto sourceProbe = BlockedBloomFilter::probe(source, labelBitSize, hashCount);
 
             for (auto label : query.labels) {
                 if (!outgoingFound) {
                     auto itTo = toFilters[source].find(label);
 
-                    if (itTo != toFilters[source].end() && itTo->second.containsAt(targetPos)) {
+                    if (itTo != toFilters[source].end() && itTo->second.contains(targetProbe)) {
                         outgoingFound = true;
                     }
                 }
@@ -204,7 +207,7 @@ namespace lcr {
                 if (!incomingFound) {
                     auto itFrom = fromFilters[target].find(label);
 
-                    if (itFrom != fromFilters[target].end() && itFrom->second.containsAt(sourcePos)) {
+                    if (itFrom != fromFilters[target].end() && itFrom->second.contains(sourceProbe)) {
                         incomingFound = true;
                     }
                 }
@@ -232,7 +235,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
@@ -10,22 +10,23 @@ namespace lcr {
 
         uint32_t labelSize;
         uint32_t labelBitSize;
+        uint32_t hashCount;
 
-        std::vector<std::map<uint32_t, BloomFilter>> toFilters = { };
-        std::vector<std::map<uint32_t, BloomFilter>> fromFilters = { };
+        std::vector<std::map<uint32_t, BlockedBloomFilter>> toFilters = { };
+        std::vector<std::map<uint32_t, BlockedBloomFilter>> fromFilters = { };
 
     public:
-        explicit BFLPathIndex(uint32_t k) {
+        explicit BFLPathIndex(uint32_t k, uint32_t hashCount = 1) : hashCount(hashCount) {
             labelSize = k;
             labelBitSize = k * 32;
 
-            indexName = "Bloom Filter Path Labeling k=" + std::to_string(k);
+            indexName = "Bloom Filter Path Labeling k=" + std::to_string(k) + " h=" + std::to_string(hashCount);
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
-        virtual QueryResult queryOnce(const LCRQuery &q) override;
+        QueryResult queryOnce(const LCRQuery &q, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
 
@@ -34,7 +35,7 @@ namespace lcr {
         }
 
     private:
-        void forwardBFS(const DiGraph &graph, Vertex source, std::vector<BloomFilter>& bloomFilters);
-        void reverseBFS(const DiGraph &graph, Vertex source, std::vector<BloomFilter>& bloomFilters);
+        void forwardBFS(const DiGraph &graph, Vertex source, std::vector<BlockedBloomFilter>& bloomFilters);
+        void reverseBFS(const DiGraph &graph, Vertex source, std::vector<BlockedBloomFilter>& bloomFilters);
     };
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "BFSIndex.hpp"
 
 namespace lcr {
-    bool BFSIndex::query(const LCRQuery &query) {
+    bool BFSIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -17,10 +17,13 @@ namespace lcr {
             return false;
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
 
-        visited[source] = true;
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
+
+        visited.set(source);
         queue.emplace_back(source);
 
         while (!queue.empty()) {
@@ -41,7 +44,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
@@ -49,4 +52,12 @@ namespace lcr {
 
         return false;
     }
+
+    void BFSIndex::queryGroup(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                              QueryContext &context) const {
+        std::vector<uint32_t> unresolved(group.size());
+        std::iota(unresolved.begin(), unresolved.end(), 0u);
+
+        groupFallbackBFS(group, results, unresolved, context);
+    }
 }
\ No newline at end of file
@@ -9,9 +9,16 @@ namespace lcr {
 
     public:
         void train() override { }
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+
+        void queryGroup(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                        QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override { return 0; }
+
+        void serialize(IndexWriter &writer) const override { }
+        void deserialize(IndexReader &reader) override { }
+
         [[nodiscard]] const std::string &getName() const override { return indexName; }
     };
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include "BiBFSIndex.hpp"
+
+namespace lcr {
+    bool BiBFSIndex::query(const LCRQuery &query, QueryContext &context) const {
+        auto forward = context.acquire();
+        auto backward = context.acquire();
+
+        return labelConstrainedBiBFS(getGraph(), query.source, query.target, query.labelSet, *forward, *backward);
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Index.hpp"
+
+namespace lcr {
+    class BiBFSIndex : public Index {
+    private:
+        inline static const std::string indexName = "BiBFS";
+
+    public:
+        void train() override { }
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+
+        [[nodiscard]] size_t indexSize() const override { return 0; }
+
+        void serialize(IndexWriter &writer) const override { }
+        void deserialize(IndexReader &reader) override { }
+
+        [[nodiscard]] const std::string &getName() const override { return indexName; }
+    };
+}
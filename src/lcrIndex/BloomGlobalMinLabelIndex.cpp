@@ -110,7 +110,7 @@ namespace lcr {
         return true;
     }
 
-    bool BloomGlobalMinLabelIndex::query(const LCRQuery &query) {
+    bool BloomGlobalMinLabelIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -126,8 +126,11 @@ namespace lcr {
             return false;
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
         queue.emplace_back(source);
 
         while (!queue.empty()) {
@@ -153,7 +156,7 @@ namespace lcr {
                 continue;
             }
 
-            visited[source] = true;
+            visited.set(source);
 
             auto it = graph.getConnected(source);
 
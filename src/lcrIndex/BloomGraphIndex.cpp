@@ -15,7 +15,7 @@ namespace lcr {
         for (auto i = 0u; i < getGraph().getVertexCount(); i++) {
             auto vertex = order[i];
 
-            bloomFilters[vertex].setup(labelBitSize);
+            bloomFilters[vertex].setup(labelBitSize, hashCount);
 
             createIndexForVertex(queue, vertex, vertexLookup);
 
@@ -77,11 +77,31 @@ namespace lcr {
         }
 
         index.emplace_back(labelSet);
-        bloomFilters[vertex].addWithSuperSets(target, labelSet);
+        addWithSuperSets(bloomFilters[vertex], target, labelSet, 0);
         return true;
     }
 
-    bool BloomGraphIndex::query(const LCRQuery &query) {
+    void BloomGraphIndex::addWithSuperSets(BlockedBloomFilter &bloomFilter, Vertex target, const LabelSet &labelSet,
+                                           uint32_t next) {
+        auto hash = boost::hash_value(target);
+        boost::hash_combine(hash, labelSet.hash());
+
+        bloomFilter.add(hash);
+
+        for (; next < labelSet.size(); next++) {
+            if (labelSet[next]) {
+                continue;
+            }
+
+            LabelSet superSet(labelSet.size());
+            superSet |= labelSet;
+            superSet[next] = true;
+
+            addWithSuperSets(bloomFilter, target, superSet, next + 1);
+        }
+    }
+
+    bool BloomGraphIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -97,19 +117,24 @@ namespace lcr {
             return false;
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
         queue.emplace_back(source);
-        visited[source] = true;
+        visited.set(source);
 
         auto hash = boost::hash_value(target);
-        boost::hash_combine(hash, boost::hash_value(labelSet));
+        boost::hash_combine(hash, labelSet.hash());
+
+        auto probe = BlockedBloomFilter::probe(hash, labelBitSize, hashCount);
 
         while (!queue.empty()) {
             source = queue.front();
             queue.pop_front();
 
-            if (!bloomFilters[source].containsHash(hash)) {
+            if (!bloomFilters[source].contains(probe)) {
                 continue;
             }
 
@@ -127,7 +152,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
@@ -10,19 +10,20 @@ namespace lcr {
 
         uint32_t labelSize;
         uint32_t labelBitSize;
+        uint32_t hashCount;
 
-        std::vector<BloomFilter> bloomFilters;
+        std::vector<BlockedBloomFilter> bloomFilters;
 
     public:
-        explicit BloomGraphIndex(uint32_t k) {
+        explicit BloomGraphIndex(uint32_t k, uint32_t hashCount = 1) : hashCount(hashCount) {
             labelSize = k;
             labelBitSize = k * 32;
 
-            indexName = "Bloom Graph Labeling k=" + std::to_string(k);
+            indexName = "Bloom Graph Labeling k=" + std::to_string(k) + " h=" + std::to_string(hashCount);
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override {
@@ -34,5 +35,11 @@ namespace lcr {
 
         bool tryInsert(Vertex vertex, Vertex target, const LabelSet &labelSet,
                        std::vector<std::vector<LabelSet>> &vertexLookup);
+
+        /**
+         * @brief adds the target with the label set and all its super sets, starting at the label next.
+         */
+        static void addWithSuperSets(BlockedBloomFilter &bloomFilter, Vertex target, const LabelSet &labelSet,
+                                     uint32_t next);
     };
 }
\ No newline at end of file
@@ -22,7 +22,7 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override {
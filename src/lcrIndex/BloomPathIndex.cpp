@@ -32,7 +32,7 @@ namespace lcr {
                 auto &edge = *it;
 
                 if (toFilters[vertexOut][edge.label].empty()) {
-                    toFilters[vertexOut][edge.label].setup(labelBitSize);
+                    toFilters[vertexOut][edge.label].setup(labelBitSize, hashCount);
                 }
 
                 visited[vertexOut] = true;
@@ -49,7 +49,7 @@ namespace lcr {
                 auto &edge = *revIt;
 
                 if (fromFilters[vertexIn][edge.label].empty()) {
-                    fromFilters[vertexIn][edge.label].setup(labelBitSize);
+                    fromFilters[vertexIn][edge.label].setup(labelBitSize, hashCount);
                 }
 
                 visited[vertexIn] = true;
@@ -161,7 +161,7 @@ namespace lcr {
         fromFilters[vertex][label].add(source);
     }
 
-    bool BloomPathIndex::query(const LCRQuery &query) {
+    bool BloomPathIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -177,11 +177,17 @@ namespace lcr {
             return false;
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
         queue.emplace_back(source);
 
-        visited[source] = true;
+        visited.set(source);
+
+        // All filters have the same size, thus the bits of a vertex are computed once for all labels.
+        auto targetProbe = BlockedBloomFilter::probe(target, labelBitSize, hashCount);
 
         while (!queue.empty()) {
             source = queue.back();
@@ -190,12 +196,14 @@ namespace lcr {
             bool outgoingFound = false;
             bool incomingFound = false;
 
+            auto sourceProbe = BlockedBloomFilter::probe(source, labelBitSize, hashCount);
+
             for (auto label : query.labels) {
-                if (!toFilters[source][label].empty() && toFilters[source][label].contains(target)) {
+                if (!toFilters[source][label].empty() && toFilters[source][label].contains(targetProbe)) {
                     outgoingFound = true;
                 }
 
-                if (!fromFilters[target][label].empty() && fromFilters[target][label].contains(source)) {
+                if (!fromFilters[target][label].empty() && fromFilters[target][label].contains(sourceProbe)) {
                     incomingFound = true;
                 }
 
@@ -222,7 +230,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
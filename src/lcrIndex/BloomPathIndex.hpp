@@ -10,20 +10,21 @@ namespace lcr {
 
         uint32_t labelSize;
         uint32_t labelBitSize;
+        uint32_t hashCount;
 
-        std::vector<std::vector<BloomFilter>> toFilters;
-        std::vector<std::vector<BloomFilter>> fromFilters;
+        std::vector<std::vector<BlockedBloomFilter>> toFilters;
+        std::vector<std::vector<BlockedBloomFilter>> fromFilters;
 
     public:
-        explicit BloomPathIndex(uint32_t k) {
+        explicit BloomPathIndex(uint32_t k, uint32_t hashCount = 1) : hashCount(hashCount) {
             labelSize = k;
             labelBitSize = 32 * k;
 
-            indexName = "Bloom First Path Labeling k=" + std::to_string(k);
+            indexName = "Bloom First Path Labeling k=" + std::to_string(k) + " h=" + std::to_string(hashCount);
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override {
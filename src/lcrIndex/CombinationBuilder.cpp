@@ -0,0 +1,249 @@
+#include <threading/ThreadPool.hpp>
+#include "CombinationBuilder.hpp"
+
+namespace lcr {
+    CombinationBuilder::CombinationBuilder(const LabeledEdgeGraph &labeledGraph, size_t memoryBudget) : labeledGraph(
+            labeledGraph), memoryBudget(memoryBudget), labelEdgeCounts(labeledGraph) { }
+
+    size_t CombinationBuilder::add(const LabelSet &labelSet, IndexFactory createIndex, bool requireIncrease) {
+        auto &build = builds.emplace_back();
+        build.labelSet = labelSet;
+        build.createIndex = std::move(createIndex);
+        build.requireIncrease = requireIncrease;
+        build.estimatedBytes = estimateBytes(labelSet);
+
+        return builds.size() - 1;
+    }
+
+    size_t CombinationBuilder::estimateBytes(const LabelSet &labelSet) const {
+        // Both directions of the adjacency lists, at most every edge of the labels.
+        size_t graphBytes = size_t(labeledGraph.getVertexCount()) * 2 * sizeof(EdgeList);
+        graphBytes += labelEdgeCounts.countEdges(labelSet) * 2 * sizeof(Vertex);
+
+        // The component graph is at most as large as the merged graph, plus the mapping to the components.
+        return graphBytes * 2 + size_t(labeledGraph.getVertexCount()) * sizeof(Vertex);
+    }
+
+    size_t CombinationBuilder::estimateDerivedBytes(const Build &build) const {
+        auto &parent = builds[build.parent];
+        auto &components = parent.sccGraph->getComponentGraph();
+
+        // The component graph of the parent plus the added edges, which are collected first.
+        auto addedEdges = labelEdgeCounts.countEdges(build.labelSet - parent.labelSet);
+
+        size_t graphBytes = components.getVertexCount() * 2 * sizeof(EdgeList);
+        graphBytes += (components.getEdgeCount() + addedEdges) * 2 * sizeof(Vertex);
+        graphBytes += addedEdges * sizeof(std::pair<Vertex, Vertex>);
+
+        // Its component graph is at most as large, plus the mapping of both condensations.
+        return graphBytes * 2 + size_t(labeledGraph.getVertexCount()) * 2 * sizeof(Vertex);
+    }
+
+    void CombinationBuilder::run() {
+        if (builds.empty()) {
+            return;
+        }
+
+        // The levels of the lattice, by the number of labels of the builds.
+        std::map<size_t, std::vector<size_t>> levels;
+
+        for (auto position = 0u; position < builds.size(); position++) {
+            levels[builds[position].labelSet.count()].emplace_back(position);
+        }
+
+        // Component graphs of a level are kept till the next level is built, such that it can derive from them.
+        const std::vector<size_t> *previous = nullptr;
+
+        for (auto &level : levels) {
+            if (previous != nullptr) {
+                selectParents(*previous, level.second);
+            }
+
+            // The memory that is in use stays in use, including the component graphs kept as parents and the
+            // indexes of the previous levels. The builds of a level get what is left of the budget.
+            auto inUse = getCurrentPSS();
+            auto available = memoryBudget > inUse ? memoryBudget - inUse : 0;
+
+            runLevel(level.second, available);
+
+            if (previous != nullptr) {
+                releaseComponentGraphs(*previous);
+            }
+
+            previous = &level.second;
+        }
+
+        releaseComponentGraphs(*previous);
+    }
+
+    void CombinationBuilder::selectParents(const std::vector<size_t> &previous, const std::vector<size_t> &level) {
+        std::unordered_map<LabelSet, size_t> parents;
+        parents.reserve(previous.size());
+
+        for (auto position : previous) {
+            auto &build = builds[position];
+
+            if (build.sccGraph == nullptr || !build.sccGraph->hasComponentGraph()) {
+                continue;
+            }
+
+            // Deriving only pays off if the component graph is smaller than the graph, otherwise it is merged.
+            if (build.sccGraph->getComponentCount() * 10 > labeledGraph.getVertexCount() * 9) {
+                continue;
+            }
+
+            parents.emplace(build.labelSet, position);
+        }
+
+        if (parents.empty()) {
+            return;
+        }
+
+        // If the levels differ by a single label, the parents are found by leaving out one label at a time.
+        auto adjacent = builds[previous.front()].labelSet.count() + 1 == builds[level.front()].labelSet.count();
+
+        for (auto position : level) {
+            auto &build = builds[position];
+            auto fewestEdges = std::numeric_limits<size_t>::max();
+
+            auto consider = [&](size_t parent) {
+                auto edgeCount = labelEdgeCounts.countEdges(build.labelSet - builds[parent].labelSet);
+
+                if (edgeCount < fewestEdges) {
+                    fewestEdges = edgeCount;
+                    build.parent = parent;
+                }
+            };
+
+            if (adjacent) {
+                auto subset = build.labelSet;
+
+                for (auto label = 0u; label < subset.size(); label++) {
+                    if (!subset[label]) {
+                        continue;
+                    }
+
+                    subset.reset(label);
+                    auto parent = parents.find(subset);
+
+                    if (parent != parents.end()) {
+                        consider(parent->second);
+                    }
+
+                    subset.set(label);
+                }
+            } else {
+                for (auto parent : previous) {
+                    if (parents.count(builds[parent].labelSet) != 0 &&
+                        builds[parent].labelSet.is_subset_of(build.labelSet)) {
+                        consider(parent);
+                    }
+                }
+            }
+
+            if (build.parent != noParent) {
+                build.estimatedBytes = std::min(build.estimatedBytes, estimateDerivedBytes(build));
+            }
+        }
+    }
+
+    void CombinationBuilder::runLevel(std::vector<size_t> &level, size_t available) {
+        // The largest builds start first, such that a large build does not end up running alone at the end.
+        std::stable_sort(level.begin(), level.end(), [this](size_t left, size_t right) {
+            return builds[left].estimatedBytes > builds[right].estimatedBytes;
+        });
+
+        auto &threadPool = getThreadPool();
+        auto tasks = std::min<size_t>(threadPool.getNumThreads(), level.size());
+
+        std::atomic<size_t> next = 0;
+        std::vector<std::function<void(uint32_t id)>> workGroup;
+
+        budgetRetained = 0;
+
+        for (auto i = 0u; i < tasks; i++) {
+            workGroup.emplace_back([&](uint32_t) {
+                for (auto position = next++; position < level.size(); position = next++) {
+                    auto &build = builds[level[position]];
+
+                    acquireBudget(build.estimatedBytes, available);
+                    train(build);
+
+                    // The index and its component graph are kept, they take from the budget of the level.
+                    size_t retainedBytes = 0;
+
+                    if (build.index != nullptr) {
+                        retainedBytes = build.index->indexSize() + build.sccGraph->getSizeInBytes();
+                    }
+
+                    releaseBudget(build.estimatedBytes, retainedBytes);
+                }
+            });
+        }
+
+        threadPool.runWorkGroup(workGroup);
+    }
+
+    void CombinationBuilder::train(Build &build) {
+        MergedGraphStats stats;
+
+        if (build.parent != noParent) {
+            auto &parent = builds[build.parent];
+            build.sccGraph = deriveSCCGraph(labeledGraph, *parent.sccGraph, parent.labelSet, build.labelSet, stats);
+        } else {
+            auto graph = mergeGraphForLabels(labeledGraph, build.labelSet, stats);
+
+            if (!build.requireIncrease || std::abs(stats.increasePercentage) > 0) {
+                build.sccGraph = tarjanSCC(*graph);
+            }
+        }
+
+        // Only index the label set if it gives a significant win.
+        // Otherwise it will be found by a previous combination.
+        if (build.requireIncrease && std::abs(stats.increasePercentage) <= 0) {
+            build.sccGraph = nullptr;
+            return;
+        }
+
+        build.index = build.createIndex();
+        build.index->setGraph(build.sccGraph.get());
+
+        build.index->train();
+    }
+
+    void CombinationBuilder::releaseComponentGraphs(const std::vector<size_t> &level) {
+        for (auto position : level) {
+            auto &build = builds[position];
+
+            if (build.index == nullptr) {
+                continue;
+            }
+
+            if (build.index->canDiscardComponentGraph()) {
+                build.sccGraph->clearComponentGraph();
+            }
+
+            build.sccGraph->shareVertexMapping(mappings);
+        }
+    }
+
+    void CombinationBuilder::acquireBudget(size_t bytes, size_t available) {
+        std::unique_lock<std::mutex> lock(budgetMutex);
+
+        // A build that does not fit on its own still runs, but only when nothing else is running.
+        budgetReleased.wait(lock, [&] {
+            return budgetInUse == 0 || budgetRetained + budgetInUse + bytes <= available;
+        });
+
+        budgetInUse += bytes;
+    }
+
+    void CombinationBuilder::releaseBudget(size_t bytes, size_t retainedBytes) {
+        std::unique_lock<std::mutex> lock(budgetMutex);
+        budgetInUse -= bytes;
+        budgetRetained += retainedBytes;
+        lock.unlock();
+
+        budgetReleased.notify_all();
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <graphs/LabelEdgeCounts.hpp>
+#include <reachIndex/ReachabilityIndex.hpp>
+
+namespace lcr {
+    /**
+     * @brief trains the reachability indexes of label combinations, each on the graph merged over its label set.
+     * The builds are independent and run on the thread pool. Builds run concurrently only while the estimated
+     * memory of their merged graphs, together with the memory in use and the indexes built so far, fits in the memory
+     * budget.
+     * Builds run in lattice order, by the size of their label set. A build whose label set contains the label set of
+     * a build of the previous size derives its component graph from that build, instead of merging the labeled graph.
+     */
+    class CombinationBuilder {
+    public:
+        typedef std::function<std::unique_ptr<ReachabilityIndex>()> IndexFactory;
+
+        static constexpr size_t noParent = std::numeric_limits<size_t>::max();
+
+        struct Build {
+            LabelSet labelSet;
+            IndexFactory createIndex;
+
+            // Skip the label set if merging its labels adds no edges, a previous combination already covers it.
+            bool requireIncrease;
+            size_t estimatedBytes;
+
+            // The build the component graph is derived from, or noParent if the labeled graph is merged.
+            size_t parent = noParent;
+
+            // Empty if the build was skipped.
+            std::unique_ptr<ReachabilityIndex> index;
+            std::unique_ptr<SCCGraph> sccGraph;
+        };
+
+    private:
+        const LabeledEdgeGraph &labeledGraph;
+        size_t memoryBudget;
+
+        LabelEdgeCounts labelEdgeCounts;
+
+        std::vector<Build> builds;
+        VertexMappingStore mappings;
+
+        std::mutex budgetMutex;
+        std::condition_variable budgetReleased;
+        size_t budgetInUse = 0;
+
+        // The indexes built in the current level, which are not yet part of the memory in use of the level.
+        size_t budgetRetained = 0;
+
+    public:
+        CombinationBuilder(const LabeledEdgeGraph &labeledGraph, size_t memoryBudget);
+
+        /**
+         * @brief adds the build of a label set, returns the position of the build.
+         */
+        size_t add(const LabelSet &labelSet, IndexFactory createIndex, bool requireIncrease);
+
+        /**
+         * @brief runs all builds that were added and waits till they are finished.
+         */
+        void run();
+
+        [[nodiscard]] Build &getBuild(size_t position) {
+            return builds[position];
+        }
+
+        [[nodiscard]] size_t getBuildCount() const {
+            return builds.size();
+        }
+
+    private:
+        /**
+         * @brief an upper bound on the memory of the merged graph and its component graph, while building.
+         */
+        [[nodiscard]] size_t estimateBytes(const LabelSet &labelSet) const;
+
+        /**
+         * @brief an upper bound on the memory of deriving the component graph of build from its parent.
+         */
+        [[nodiscard]] size_t estimateDerivedBytes(const Build &build) const;
+
+        /**
+         * @brief picks the parent of every build of level out of the builds of previous.
+         * The parent is the build that leaves the fewest edges to add.
+         */
+        void selectParents(const std::vector<size_t> &previous, const std::vector<size_t> &level);
+
+        void runLevel(std::vector<size_t> &level, size_t available);
+        void train(Build &build);
+
+        /**
+         * @brief discards the component graphs of level that are no longer needed by their index or as a parent.
+         * The vertex mappings of level are shared, identical mappings are kept once.
+         */
+        void releaseComponentGraphs(const std::vector<size_t> &level);
+
+        void acquireBudget(size_t bytes, size_t available);
+
+        /**
+         * @brief releases the budget of a finished build, of which retainedBytes stay in use till the level is done.
+         */
+        void releaseBudget(size_t bytes, size_t retainedBytes);
+    };
+}
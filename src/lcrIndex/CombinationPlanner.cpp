@@ -0,0 +1,180 @@
+#include <threading/ThreadPool.hpp>
+#include "CombinationPlanner.hpp"
+
+namespace lcr {
+    CombinationPlanner::CombinationPlanner(const LabeledEdgeGraph &labeledGraph, uint32_t minLabels,
+                                           uint32_t maxLabels) : labeledGraph(labeledGraph), minLabels(minLabels),
+                                                                 maxLabels(maxLabels), labelEdgeCounts(labeledGraph) { }
+
+    size_t CombinationPlanner::estimateBytes(const LabelSet &labelSet) const {
+        auto elements = labeledGraph.getVertexCount() + labelEdgeCounts.countEdges(labelSet);
+
+        if (calibratedElements == 0) {
+            return elements * sizeof(Vertex);
+        }
+
+        return size_t(double(calibratedBytes) / double(calibratedElements) * double(elements));
+    }
+
+    void CombinationPlanner::calibrate(const LabelSet &labelSet, size_t indexBytes) {
+        auto edgeCount = labelEdgeCounts.countEdges(labelSet);
+
+        calibratedBytes += indexBytes;
+        calibratedElements += labeledGraph.getVertexCount() + edgeCount;
+        trainingEdges += edgeCount;
+    }
+
+    void CombinationPlanner::sample(const std::vector<Vertex> &sources, size_t sampleBytes) {
+        sample(sources, sampleBytes, std::min<size_t>(getThreadPool().getNumThreads(), minSampledSources));
+    }
+
+    void CombinationPlanner::sample(const std::vector<Vertex> &sources, size_t sampleBytes, size_t tasks) {
+        // Sampling costs no more than training the picked label sets may.
+        auto maxSampledSets = std::min(sampleBytes / sampledSetBytes, trainingEdges);
+        auto maxSourceSets = maxSampledSets / minSampledSources;
+
+        if (maxSourceSets == 0) {
+            return;
+        }
+
+        auto &threadPool = getThreadPool();
+        tasks = std::max<size_t>(tasks, 1);
+
+        std::vector<std::unordered_map<LabelSet, uint32_t>> taskCounts(tasks);
+        size_t sampledSets = 0;
+
+        for (size_t roundStart = 0; roundStart < sources.size() && sampledSets < maxSampledSets;
+             roundStart += minSampledSources) {
+            auto roundEnd = std::min(sources.size(), roundStart + minSampledSources);
+
+            std::atomic<size_t> next = roundStart;
+            std::atomic<size_t> roundSets = 0;
+            std::vector<std::function<void(uint32_t id)>> workGroup;
+
+            for (auto task = 0u; task < tasks; task++) {
+                workGroup.emplace_back([&, task](uint32_t) {
+                    std::stack<VertexLabelSet> stack;
+                    VertexLabelSetVisitedSet visited;
+
+                    for (auto position = next++; position < roundEnd; position = next++) {
+                        roundSets += sampleSource(sources[position], maxSourceSets, stack, visited, taskCounts[task]);
+                        visited.clear();
+                    }
+                });
+            }
+
+            threadPool.runWorkGroup(workGroup);
+            sampledSets += roundSets;
+
+            // The counts are sums, thus the order in which the tasks are merged does not matter.
+            for (auto &counts : taskCounts) {
+                for (auto &count : counts) {
+                    frequencies[count.first] += count.second;
+                }
+
+                counts.clear();
+            }
+        }
+    }
+
+    size_t CombinationPlanner::sampleSource(Vertex source, size_t maxSets, std::stack<VertexLabelSet> &stack,
+                                            VertexLabelSetVisitedSet &visited,
+                                            std::unordered_map<LabelSet, uint32_t> &counts) const {
+        auto labelCount = labeledGraph.getLabelCount();
+        size_t setCount = 0;
+
+        stack.emplace(source, labelCount);
+
+        while (!stack.empty()) {
+            auto current = std::move(stack.top());
+            stack.pop();
+
+            auto count = current.second.count();
+
+            if (!visited.emplace(current).second) {
+                continue;
+            }
+
+            if (count >= minLabels) {
+                counts[current.second]++;
+                setCount++;
+
+                if (setCount >= maxSets) {
+                    break;
+                }
+            }
+
+            if (count > maxLabels) {
+                continue;
+            }
+
+            auto it = labeledGraph.getConnected(current.first);
+
+            while (it.next()) {
+                auto &edge = *it;
+
+                LabelSet labelSet(labelCount);
+
+                labelSet[edge.label] = true;
+                labelSet |= current.second;
+
+                stack.emplace(edge.target, labelSet);
+            }
+        }
+
+        std::stack<VertexLabelSet>().swap(stack);
+        return setCount;
+    }
+
+    std::vector<LabelSet> CombinationPlanner::plan(size_t indexBytes) const {
+        struct Candidate {
+            double worthPerByte;
+            LabelSet labelSet;
+            size_t bytes;
+            size_t edges;
+        };
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(frequencies.size());
+
+        for (const auto &frequency : frequencies) {
+            auto &labelSet = frequency.first;
+
+            if (labelSet.all()) {
+                continue;
+            }
+
+            auto bytes = std::max<size_t>(estimateBytes(labelSet), 1);
+            auto worth = double(frequency.second) * double(labelSet.count());
+
+            candidates.push_back({ worth / double(bytes), labelSet, bytes, labelEdgeCounts.countEdges(labelSet) });
+        }
+
+        // Ties are broken by label set, such that the plan does not depend on the order of the frequencies.
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate &left, const Candidate &right) {
+            if (left.worthPerByte != right.worthPerByte) {
+                return left.worthPerByte > right.worthPerByte;
+            }
+
+            return left.labelSet < right.labelSet;
+        });
+
+        std::vector<LabelSet> picked;
+        size_t pickedBytes = 0;
+        size_t pickedEdges = 0;
+
+        // A label set that does not fit is skipped, a smaller one further down may still fit.
+        for (auto &candidate : candidates) {
+            if (pickedBytes + candidate.bytes > indexBytes || pickedEdges + candidate.edges > trainingEdges) {
+                continue;
+            }
+
+            pickedBytes += candidate.bytes;
+            pickedEdges += candidate.edges;
+
+            picked.emplace_back(candidate.labelSet);
+        }
+
+        return picked;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <graphs/LabelEdgeCounts.hpp>
+#include "Index.hpp"
+
+namespace lcr {
+    /**
+     * @brief picks the label combinations above k that are worth an index, within a memory and training budget.
+     * The workload is sampled by traversing the graph from its vertices of highest degree, every label set of a path
+     * with minLabels up to maxLabels labels counts as a query. A label set is worth the number of sampled paths it
+     * answers times its number of labels, it costs the estimated size of its index. The label sets are picked
+     * greedily by worth per byte.
+     */
+    class CombinationPlanner {
+    private:
+        // Every source counts at most this part of the sample, the sources are traversed in rounds of this size.
+        static constexpr size_t minSampledSources = 64;
+
+        // An entry in the visited set and in the frequencies, with the overhead of their hash nodes.
+        static constexpr size_t sampledSetBytes = 2 * (sizeof(VertexLabelSet) + 2 * sizeof(void *));
+
+        const LabeledEdgeGraph &labeledGraph;
+
+        uint32_t minLabels;
+        uint32_t maxLabels;
+
+        LabelEdgeCounts labelEdgeCounts;
+
+        // The indexes built so far, their size per vertex and edge estimates the size of a new index.
+        size_t calibratedBytes = 0;
+        size_t calibratedElements = 0;
+
+        // The edges merged for the indexes built so far, the picked label sets may merge as many.
+        size_t trainingEdges = 0;
+
+        std::unordered_map<LabelSet, uint32_t> frequencies;
+
+    public:
+        CombinationPlanner(const LabeledEdgeGraph &labeledGraph, uint32_t minLabels, uint32_t maxLabels);
+
+        /**
+         * @brief records an index that was built already, with indexBytes as its size including its component graph.
+         */
+        void calibrate(const LabelSet &labelSet, size_t indexBytes);
+
+        /**
+         * @brief counts the label sets of the paths from sources, in order, while the sample fits in sampleBytes.
+         * The sources of a round are traversed in parallel, the sample does not depend on the number of threads.
+         */
+        void sample(const std::vector<Vertex> &sources, size_t sampleBytes);
+
+        /**
+         * @brief samples as above, with the sources of a round divided over the given number of tasks.
+         */
+        void sample(const std::vector<Vertex> &sources, size_t sampleBytes, size_t tasks);
+
+        /**
+         * @brief the sampled label sets to index, best first, such that their indexes fit in indexBytes and they merge
+         * at most as many edges as the calibrated indexes.
+         */
+        [[nodiscard]] std::vector<LabelSet> plan(size_t indexBytes) const;
+
+        /**
+         * @brief the estimated size of the index of labelSet, including its component graph.
+         */
+        [[nodiscard]] size_t estimateBytes(const LabelSet &labelSet) const;
+
+        [[nodiscard]] size_t getCalibratedBytes() const {
+            return calibratedBytes;
+        }
+
+        [[nodiscard]] size_t getTrainingEdges() const {
+            return trainingEdges;
+        }
+
+    private:
+
+        /**
+         * @brief counts the label sets of the paths from source, till maxSets label sets of at least minLabels labels
+         * are counted.
+         */
+        size_t sampleSource(Vertex source, size_t maxSets, std::stack<VertexLabelSet> &stack,
+                            VertexLabelSetVisitedSet &visited, std::unordered_map<LabelSet, uint32_t> &counts) const;
+    };
+}
@@ -0,0 +1,15 @@
+#include "HybridBFSIndex.hpp"
+
+namespace lcr {
+    bool HybridBFSIndex::query(const LCRQuery &query, QueryContext &context) const {
+        auto &graph = getGraph();
+        auto forward = context.acquire();
+
+        if (!bidirectional) {
+            return labelConstrainedHybridBFS(graph, query.source, query.target, query.labelSet, *forward);
+        }
+
+        auto backward = context.acquire();
+        return labelConstrainedHybridBiBFS(graph, query.source, query.target, query.labelSet, *forward, *backward);
+    }
+}
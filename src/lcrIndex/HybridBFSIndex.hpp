@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Index.hpp"
+
+namespace lcr {
+    /**
+     * @brief answers queries with a direction optimizing label constrained BFS, without any index.
+     * When bidirectional, a backward search from the target is expanded alternately, meeting in the middle.
+     */
+    class HybridBFSIndex : public Index {
+    private:
+        bool bidirectional;
+        std::string indexName;
+
+    public:
+        explicit HybridBFSIndex(bool bidirectional) : bidirectional(bidirectional) {
+            indexName = bidirectional ? "Hybrid BiBFS a=14 b=24" : "Hybrid BFS a=14 b=24";
+        }
+
+        void train() override { }
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+
+        [[nodiscard]] size_t indexSize() const override { return 0; }
+
+        void serialize(IndexWriter &writer) const override { }
+        void deserialize(IndexReader &reader) override { }
+
+        [[nodiscard]] const std::string &getName() const override { return indexName; }
+    };
+}
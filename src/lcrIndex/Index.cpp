@@ -1,6 +1,9 @@
 #include <utility/Format.hpp>
+#include <utility/MappedFile.hpp>
 #include "Index.hpp"
 #include "BFSIndex.hpp"
+#include "BiBFSIndex.hpp"
+#include "HybridBFSIndex.hpp"
 #include "P2HIndex.hpp"
 #include "LandmarkPlusIndex.hpp"
 #include "BloomGraphIndex.hpp"
@@ -16,6 +19,23 @@
 #include "ScaleHarness.hpp"
 
 namespace lcr {
+    /**
+     * @brief the number of hash functions of the bloom filters, given as the optional parameter at position.
+     */
+    static uint32_t parseHashCount(const std::vector<std::string> &params, size_t position) {
+        if (params.size() <= position) {
+            return 1;
+        }
+
+        auto hashCount = uint32_t(std::stoll(params[position]));
+
+        if (hashCount == 0 || hashCount > 32) {
+            std::cerr << "Expected between 1 and 32 hash functions! Got: " << params[position] << std::fatal;
+        }
+
+        return hashCount;
+    }
+
     std::unique_ptr<Index> Index::create(const std::string &name, std::vector<std::string> &params) {
         std::string lowerCaseName;
         lowerCaseName.resize(name.size());
@@ -25,6 +45,18 @@ namespace lcr {
             return std::make_unique<BFSIndex>();
         }
 
+        if (lowerCaseName == "bibfs") {
+            return std::make_unique<BiBFSIndex>();
+        }
+
+        if (lowerCaseName == "hybrid-bfs") {
+            if (params.size() > 1 || (params.size() == 1 && params[0] != "bi")) {
+                std::cerr << "Expected no arguments or 'bi' as input! Name: " << name << std::fatal;
+            }
+
+            return std::make_unique<HybridBFSIndex>(params.size() == 1);
+        }
+
         if (lowerCaseName == "landmark-plus" || lowerCaseName == "li+") {
             if (params.size() > 2) {
                 std::cerr << "Expected at most 2 argument inputs! Name: " << name << std::fatal;
@@ -66,11 +98,11 @@ namespace lcr {
             uint32_t k = std::numeric_limits<uint32_t>::max();
 
             if (params.empty()) {
-                return std::make_unique<LWBFIndex>(i, j, k);
+                return std::make_unique<LWBFIndex>(i, j, k, 1);
             }
 
-            if (params.size() != 3) {
-                std::cerr << "Expected 0 or 3 arguments as input! Name: " << name << std::fatal;
+            if (params.size() != 3 && params.size() != 4) {
+                std::cerr << "Expected 0, 3 or 4 arguments as input! Name: " << name << std::fatal;
             }
 
             if (params[0] != "custom") {
@@ -85,31 +117,31 @@ namespace lcr {
                 k = uint32_t(std::stoll(params[2]));
             }
 
-            return std::make_unique<LWBFIndex>(i, j, k);
+            return std::make_unique<LWBFIndex>(i, j, k, parseHashCount(params, 3));
         }
 
         if (lowerCaseName == "bfl-path" || lowerCaseName == "bfflp") {
-            if (params.size() != 1) {
-                std::cerr << "Expected single argument input! Name: " << name << std::fatal;
+            if (params.empty() || params.size() > 2) {
+                std::cerr << "Expected <k> [<hashes>] arguments as input! Name: " << name << std::fatal;
             }
 
-            return std::make_unique<BFLPathIndex>(uint32_t(std::stoll(params[0])));
+            return std::make_unique<BFLPathIndex>(uint32_t(std::stoll(params[0])), parseHashCount(params, 1));
         }
 
         if (lowerCaseName == "bgi") {
-            if (params.size() != 1) {
-                std::cerr << "Expected single argument input! Name: " << name << std::fatal;
+            if (params.empty() || params.size() > 2) {
+                std::cerr << "Expected <k> [<hashes>] arguments as input! Name: " << name << std::fatal;
             }
 
-            return std::make_unique<BloomGraphIndex>(uint32_t(std::stoll(params[0])));
+            return std::make_unique<BloomGraphIndex>(uint32_t(std::stoll(params[0])), parseHashCount(params, 1));
         }
 
         if (lowerCaseName == "bpi") {
-            if (params.size() != 1) {
-                std::cerr << "Expected single argument input! Name: " << name << std::fatal;
+            if (params.empty() || params.size() > 2) {
+                std::cerr << "Expected <k> [<hashes>] arguments as input! Name: " << name << std::fatal;
             }
 
-            return std::make_unique<BloomPathIndex>(uint32_t(std::stoll(params[0])));
+            return std::make_unique<BloomPathIndex>(uint32_t(std::stoll(params[0])), parseHashCount(params, 1));
         }
 
         if (lowerCaseName == "bfi") {
@@ -213,7 +245,18 @@ namespace lcr {
                 return std::make_unique<P2HIndex>();
             }
 
-            return std::make_unique<P2HIndex>(std::stoul(params[0]));
+            auto parallel = params.back() == "parallel";
+            auto numParams = parallel ? params.size() - 1 : params.size();
+
+            if (numParams > 1) {
+                std::cerr << "Expected P2H [<w>] [parallel]! Name: " << name << std::fatal;
+            }
+
+            if (numParams == 0) {
+                return std::make_unique<P2HIndex>(12, parallel);
+            }
+
+            return std::make_unique<P2HIndex>(std::stoul(params[0]), parallel);
         }
 
         if (lowerCaseName == "scale-harness" || lowerCaseName == "sh") {
@@ -252,6 +295,167 @@ namespace lcr {
         return nullptr;
     }
 
+    void Index::save(const std::string &filePath) const {
+        auto &graph = getGraph();
+
+        IndexFileHeader header { };
+        std::copy(IndexFileHeader::expectedMagic, IndexFileHeader::expectedMagic + 8, header.magic);
+        header.version = IndexFileHeader::currentVersion;
+        header.vertexCount = graph.getVertexCount();
+        header.labelCount = graph.getLabelCount();
+        header.edgeCount = graph.getEdgeCount();
+        header.fingerprint = graphFingerprint(graph);
+
+        IndexWriter writer(filePath);
+        writer.writeHeader(header, getName());
+        serialize(writer);
+
+        if (writer.fail()) {
+            std::cerr << "Failed to write index file: " << filePath << std::fatal;
+        }
+    }
+
+    void Index::load(const std::string &filePath) {
+        auto file = MappedFile::open(filePath);
+
+        if (file == nullptr) {
+            std::cerr << "Failed to open file: " << filePath << std::fatal;
+        }
+
+        auto &graph = getGraph();
+
+        IndexReader reader(file);
+        IndexFileHeader header { };
+        std::string name;
+        reader.readHeader(header, name);
+
+        if (header.vertexCount != graph.getVertexCount() || header.labelCount != graph.getLabelCount() ||
+            header.edgeCount != graph.getEdgeCount() || header.fingerprint != graphFingerprint(graph)) {
+            std::cerr << "Index was trained on a different graph! File: " << filePath << std::fatal;
+        }
+
+        if (name != getName()) {
+            std::cerr << "Index file contains a different index! Expected: " << getName() << " found: " << name
+                      << std::fatal;
+        }
+
+        deserialize(reader);
+
+        if (!reader.atEnd()) {
+            std::cerr << "Index file is corrupt! File: " << filePath << std::fatal;
+        }
+    }
+
+    void Index::serialize(IndexWriter &writer) const {
+        std::cerr << "Index does not support persistence! Name: " << getName() << std::fatal;
+    }
+
+    void Index::deserialize(IndexReader &reader) {
+        std::cerr << "Index does not support persistence! Name: " << getName() << std::fatal;
+    }
+
+    bool Index::fallbackSearch(const LCRQuery &query, QueryContext &context) const {
+        auto &graph = getGraph();
+
+        auto source = query.source;
+        auto target = query.target;
+        auto &labels = query.labelSet;
+
+        auto scratch = context.acquire();
+
+        if (fallbackStrategy == FS_BiBFS) {
+            auto backward = context.acquire();
+            return labelConstrainedBiBFS(graph, source, target, labels, *scratch, *backward);
+        }
+
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
+
+        visited.set(source);
+        queue.emplace_back(source);
+
+        while (!queue.empty()) {
+            source = queue.front();
+            queue.pop_front();
+
+            auto it = graph.getConnected(source, labels);
+
+            while (it.next()) {
+                if (it->target == target) {
+                    return true;
+                }
+
+                if (visited.insert(it->target)) {
+                    queue.emplace_back(it->target);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void Index::groupFallbackBFS(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                                 const std::vector<uint32_t> &unresolved, QueryContext &context) const {
+        if (unresolved.empty()) {
+            return;
+        }
+
+        auto &graph = getGraph();
+        auto &labels = group.front()->labelSet;
+        auto source = group.front()->source;
+
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
+
+        // Mark the targets that are still to be found, such that the BFS can stop early.
+        auto targetScratch = context.acquire();
+        targetScratch->visited.reset(graph.getVertexCount());
+
+        auto &targets = targetScratch->visited;
+        auto remaining = 0u;
+
+        for (auto i : unresolved) {
+            if (targets.insert(group[i]->target)) {
+                remaining++;
+            }
+        }
+
+        visited.set(source);
+        queue.emplace_back(source);
+
+        if (targets[source]) {
+            remaining--;
+        }
+
+        while (!queue.empty() && remaining != 0) {
+            auto current = queue.front();
+            queue.pop_front();
+
+            auto it = graph.getConnected(current, labels);
+
+            while (it.next()) {
+                if (!visited.insert(it->target)) {
+                    continue;
+                }
+
+                queue.emplace_back(it->target);
+
+                if (targets[it->target]) {
+                    remaining--;
+                }
+            }
+        }
+
+        for (auto i : unresolved) {
+            results[i] = visited[group[i]->target] ? 1u : 0u;
+        }
+    }
+
     std::ostream &operator <<(std::ostream &out, const Index &index) {
         formatWidth(out, index.getName(), 50);
         out << "size: ";
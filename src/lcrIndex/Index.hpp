@@ -1,7 +1,9 @@
 #pragma once
 
 #include <dataStructures/BloomFilter.hpp>
+#include <dataStructures/QueryContext.hpp>
 #include <graphs/Query.hpp>
+#include <io/IndexFile.hpp>
 
 namespace lcr {
     struct VertexOriginEntry {
@@ -187,6 +189,13 @@ namespace lcr {
         QR_Reachable, QR_NotReachable, QR_MaybeReachable
     };
 
+    /**
+     * @brief the search used by indexes when their labels cannot answer a query.
+     */
+    enum FallbackStrategy {
+        FS_BFS, FS_BiBFS
+    };
+
     class Index {
     private:
         LabeledEdgeGraph *labeledGraph = nullptr;
@@ -194,6 +203,14 @@ namespace lcr {
         uint32_t labelCount;
         uint32_t vertexCount;
 
+        FallbackStrategy fallbackStrategy = FS_BFS;
+
+        // Zero when no budget was set, in which case the physical memory is the budget.
+        size_t memoryBudget = 0;
+
+        // Context for callers that query from a single thread.
+        QueryContext queryContext;
+
     public:
         Index() = default;
         virtual ~Index() = default;
@@ -205,14 +222,41 @@ namespace lcr {
         Index &operator =(Index &&) = default;
 
         virtual void train() = 0;
-        virtual bool query(const LCRQuery &query) = 0;
 
-        virtual QueryResult queryOnce(const LCRQuery &q) {
-            return query(q) ? QueryResult::QR_Reachable : QueryResult::QR_NotReachable;
+        /**
+         * @brief answers the query, safe to call concurrently as long as every thread uses its own context.
+         */
+        virtual bool query(const LCRQuery &query, QueryContext &context) const = 0;
+
+        virtual QueryResult queryOnce(const LCRQuery &q, QueryContext &context) const {
+            return query(q, context) ? QueryResult::QR_Reachable : QueryResult::QR_NotReachable;
+        }
+
+        virtual QueryResult queryOnceRecursive(const LCRQuery &q, QueryContext &context) const {
+            return queryOnce(q, context);
+        }
+
+        /**
+         * @brief answers a group of queries that share the same source and label set, one result per query.
+         * Indexes can override this to share work between the queries of the group, such as the fallback traversal.
+         */
+        virtual void queryGroup(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                                QueryContext &context) const {
+            for (auto i = 0u; i < group.size(); i++) {
+                results[i] = query(*group[i], context) ? 1u : 0u;
+            }
         }
 
-        virtual QueryResult queryOnceRecursive(const LCRQuery &q) {
-            return queryOnce(q);
+        bool query(const LCRQuery &q) {
+            return query(q, queryContext);
+        }
+
+        QueryResult queryOnce(const LCRQuery &q) {
+            return queryOnce(q, queryContext);
+        }
+
+        QueryResult queryOnceRecursive(const LCRQuery &q) {
+            return queryOnceRecursive(q, queryContext);
         }
 
         [[nodiscard]] virtual size_t indexSize() const = 0;
@@ -239,8 +283,78 @@ namespace lcr {
             return vertexCount;
         }
 
+        void setFallbackStrategy(FallbackStrategy strategy) {
+            fallbackStrategy = strategy;
+        }
+
+        [[nodiscard]] FallbackStrategy getFallbackStrategy() const {
+            return fallbackStrategy;
+        }
+
+        /**
+         * @brief limits the memory used while training, in bytes.
+         */
+        void setMemoryBudget(size_t bytes) {
+            memoryBudget = bytes;
+        }
+
+        /**
+         * @brief the memory that training may use in bytes, the physical memory if no budget was set.
+         */
+        [[nodiscard]] size_t getMemoryBudget() const {
+            return memoryBudget != 0 ? memoryBudget : getPhysicalMemory();
+        }
+
+        /**
+         * @brief writes the trained index to a file, such that it can be loaded instead of trained again.
+         */
+        void save(const std::string &filePath) const;
+
+        /**
+         * @brief loads an index written by save, instead of training it.
+         * The graph has to be set first, and has to be the graph the index was trained on.
+         */
+        void load(const std::string &filePath);
+
+        /**
+         * @brief writes the data of the trained index, indexes that contain other indexes also write those.
+         * By default an index cannot be persisted.
+         */
+        virtual void serialize(IndexWriter &writer) const;
+
+        /**
+         * @brief reads the data written by serialize, the graph of the index is set before reading.
+         */
+        virtual void deserialize(IndexReader &reader);
+
         static std::unique_ptr<Index> create(const std::string &name, std::vector<std::string> &params);
 
+    protected:
+        /**
+         * @brief the name of a nested reachability index in the name of its index, with its parameter if one is set.
+         */
+        static std::string nestedIndexName(const std::string &reachIndexName, uint32_t reachIndexOptionalParam) {
+            if (reachIndexOptionalParam == 0) {
+                return reachIndexName;
+            }
+
+            return reachIndexName + " " + std::to_string(reachIndexOptionalParam);
+        }
+
+        /**
+         * @brief answers the query with a label constrained search over the graph, as selected by the fallback strategy.
+         */
+        bool fallbackSearch(const LCRQuery &query, QueryContext &context) const;
+
+        /**
+         * @brief answers the unresolved queries of a group with one label constrained BFS from their shared source.
+         * The BFS stops as soon as all targets of the unresolved queries are found.
+         */
+        void groupFallbackBFS(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                              const std::vector<uint32_t> &unresolved, QueryContext &context) const;
+
+    public:
+
         template<class ... TArgs>
         static std::unique_ptr<Index> create(const std::string &name, TArgs &&... args) {
             std::vector<std::string> vector;
@@ -1,4 +1,5 @@
 #include <utility/CategorizedStepTimer.hpp>
+#include "CombinationBuilder.hpp"
 #include "KLCBFLIndex.hpp"
 
 namespace lcr {
@@ -6,22 +7,34 @@ namespace lcr {
         auto &perLabelGraph = getGraph();
         uint64_t labelCount = perLabelGraph.getLabelCount();
 
-        singleLabelIndices.resize(perLabelGraph.getLabelCount());
+        CombinationBuilder builder(perLabelGraph, getMemoryBudget());
+
+        auto createSingleIndex = []() {
+            return ReachabilityIndex::create("pll");
+        };
+
+        auto createIndex = []() {
+            return ReachabilityIndex::create("bfl-once", "4");
+        };
 
         for (auto label = 0u; label < perLabelGraph.getLabelCount(); label++) {
-            createSingleIndex(label);
+            LabelSet labelSet(labelCount);
+            labelSet[label] = true;
+
+            builder.add(labelSet, createSingleIndex, false);
         }
 
         std::queue<std::tuple<LabelSet, uint32_t, uint32_t>> queue;
         queue.emplace(labelCount, 0, 0);
 
-        auto expectedCount = calculateCombinationsUpToK(maxCombinations, labelCount);
-
-        std::vector<std::pair<uint32_t, Label>> numEdgesByLabel;
-        labelDistribution(perLabelGraph, numEdgesByLabel);
+        // The index of a combination is trained on the graph of all other labels.
+        auto addCombination = [&](const LabelSet &labelSet) {
+            if (labelSet.count() <= 1 || labelSet.all()) {
+                return;
+            }
 
-        indices.reserve(expectedCount);
-        sccGraphs.reserve(expectedCount);
+            builder.add(~labelSet, createIndex, true);
+        };
 
         while (!queue.empty()) {
             auto current = queue.front();
@@ -32,21 +45,8 @@ namespace lcr {
             auto count = std::get<2>(current);
 
             // Do something with combination
-            if (i >= labelCount) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet);
-                continue;
-            }
-
-            if (count == maxCombinations) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet);
+            if (i >= labelCount || count == maxCombinations) {
+                addCombination(labelSet);
                 continue;
             }
 
@@ -58,97 +58,51 @@ namespace lcr {
             queue.emplace(next, i + 1, count + 1);
         }
 
+        auto combinationsEnd = builder.getBuildCount();
+
         if (maxCombinations < labelCount) {
             LabelSet labelSet(labelCount);
             labelSet.set();
 
             // Create for all labels.
-            allIndex = ReachabilityIndex::create("PLL");
-
-            MergedGraphStats stats;
-            auto graph = mergeGraphForLabels(getGraph(), labelSet, stats);
-
-            allSccGraph = tarjanSCC(*graph);
-            allIndex->setGraph(allSccGraph.get());
-
-            allIndex->train();
-
-            if (allIndex->canDiscardComponentGraph()) {
-                allSccGraph->clearComponentGraph();
-            }
+            builder.add(labelSet, []() { return ReachabilityIndex::create("PLL"); }, false);
         }
-    }
-
-    void KLCBFLIndex::createSingleIndex(Label label) {
-        if (singleLabelIndices[label] != nullptr) {
-            // Already indexed.
-            return;
-        }
-
-        auto &labeledGraph = getGraph();
-
-        LabelSet labelSet(labeledGraph.getLabelCount());
-        labelSet[label] = true;
-
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
 
-        singleLabelIndices[label] = ReachabilityIndex::create("pll");
-        auto &index = singleLabelIndices[label];
+        builder.run();
 
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
+        // Take over the results in the order the builds were added.
+        singleLabelIndices.resize(labelCount);
+        sccGraphs.reserve(combinationsEnd);
 
-        index->setGraph(sccGraph.get());
+        for (auto label = 0u; label < labelCount; label++) {
+            auto &build = builder.getBuild(label);
 
-        index->train();
-
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
+            singleLabelIndices[label] = std::move(build.index);
+            sccGraphs.emplace_back(std::move(build.sccGraph));
         }
-    }
 
-    bool KLCBFLIndex::createIndex(const LabelSet &labelSet) {
-        if (labelSet.count() <= 1) {
-            return false;
-        }
+        indices.reserve(combinationsEnd - labelCount);
 
-        if (labelSet.all()) {
-            return false;
-        }
-
-        auto &labeledGraph = getGraph();
+        for (auto position = labelCount; position < combinationsEnd; position++) {
+            auto &build = builder.getBuild(position);
 
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, ~labelSet, stats);
+            if (build.index == nullptr) {
+                continue;
+            }
 
-        // Only index the label set if it gives a significant win.
-        // Otherwise it will be found by a previous combination.
-        if (std::abs(stats.increasePercentage) <= 0) {
-            return false;
+            indices.emplace_back(build.labelSet, std::move(build.index));
+            sccGraphs.emplace_back(std::move(build.sccGraph));
         }
 
-        auto &indexPair = indices.emplace_back();
-        auto &index = indexPair.second;
-
-        indexPair.first = ~labelSet;
-        index = ReachabilityIndex::create("bfl-once", "4");
-
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
-
-        index->setGraph(sccGraph.get());
-
-        index->train();
+        if (combinationsEnd < builder.getBuildCount()) {
+            auto &build = builder.getBuild(combinationsEnd);
 
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
+            allIndex = std::move(build.index);
+            allSccGraph = std::move(build.sccGraph);
         }
-
-        return true;
     }
 
-    bool KLCBFLIndex::query(const LCRQuery &query) {
+    bool KLCBFLIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -173,7 +127,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return true;
                 }
 
@@ -182,7 +136,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (allIndex != nullptr && !allIndex->query(reachQuery)) {
+        if (allIndex != nullptr && !allIndex->query(reachQuery, context)) {
             return false;
         }
 
@@ -193,7 +147,7 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return true;
             }
         }
@@ -203,11 +157,11 @@ namespace lcr {
 
         gatherReachIndexes(reachQuery, query.labelSet, reachIndexes);
 
-        // Use bfs and the reachIndexes to prune the search.
-        return defaultStrategy(query, reachIndexes);
+        // Prune with the reachIndexes, then fall back to the configured search.
+        return defaultStrategy(query, reachIndexes, context);
     }
 
-    QueryResult KLCBFLIndex::queryOnce(const LCRQuery &query) {
+    QueryResult KLCBFLIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -232,7 +186,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return QR_Reachable;
                 }
 
@@ -241,7 +195,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (allIndex != nullptr && !allIndex->query(reachQuery)) {
+        if (allIndex != nullptr && !allIndex->query(reachQuery, context)) {
             return QR_NotReachable;
         }
 
@@ -252,13 +206,13 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return QR_Reachable;
             }
         }
 
         for (auto &pair : indices) {
-            if (query.labelSet.is_subset_of(pair.first) && !pair.second->queryOnce(reachQuery)) {
+            if (query.labelSet.is_subset_of(pair.first) && !pair.second->queryOnce(reachQuery, context)) {
                 return QR_NotReachable;
             }
         }
@@ -268,7 +222,7 @@ namespace lcr {
     }
 
     void KLCBFLIndex::gatherReachIndexes(const ReachQuery &query, const LabelSet &labelSet,
-                                         std::vector<ReachabilityIndex *> &reachIndexes) {
+                                         std::vector<ReachabilityIndex *> &reachIndexes) const {
 
         uint32_t max = 2;
 
@@ -284,53 +238,64 @@ namespace lcr {
         }
     }
 
-    bool KLCBFLIndex::defaultStrategy(const LCRQuery &query, std::vector<ReachabilityIndex *> &reachIndexes) {
-        auto &graph = getGraph();
+    bool KLCBFLIndex::defaultStrategy(const LCRQuery &query, std::vector<ReachabilityIndex *> &reachIndexes,
+                                      QueryContext &context) const {
+        ReachQuery reachQuery(query.source, query.target);
 
-        auto source = query.source;
-        auto target = query.target;
-        auto &labels = query.labelSet;
+        // The reach indexes cover a superset of the labels, if one of them cannot reach the target neither can we.
+        for (auto &index : reachIndexes) {
+            if (!index->query(reachQuery, context)) {
+                return false;
+            }
+        }
 
-        // Default to BFS.
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
-        queue.emplace_back(source);
+        return fallbackSearch(query, context);
+    }
 
-        visited[source] = true;
+    void KLCBFLIndex::serialize(IndexWriter &writer) const {
+        writer.write(uint64_t(singleLabelIndices.size()));
 
-        while (!queue.empty()) {
-            source = queue.front();
-            queue.pop_front();
+        for (auto &index : singleLabelIndices) {
+            serializeNested(writer, *index);
+        }
 
-            ReachQuery reachQuery(source, target);
+        writer.write(uint64_t(indices.size()));
 
-            for (auto &index : reachIndexes) {
-                if (!index->queryOnce(reachQuery)) {
-                    continue;
-                }
-            }
+        for (auto &indexPair : indices) {
+            writer.write(indexPair.first);
+            serializeNested(writer, *indexPair.second);
+        }
 
-            auto it = graph.getConnected(source);
+        writer.write(uint8_t(allIndex != nullptr));
 
-            while (it.next()) {
-                auto &edge = *it;
+        if (allIndex != nullptr) {
+            serializeNested(writer, *allIndex);
+        }
+    }
 
-                if (!query.labelSet[edge.label]) {
-                    continue;
-                }
+    void KLCBFLIndex::deserialize(IndexReader &reader) {
+        VertexMappingStore mappings;
 
-                if (edge.target == target) {
-                    return true;
-                }
+        singleLabelIndices.resize(reader.read<uint64_t>());
 
-                if (!visited[edge.target]) {
-                    visited[edge.target] = true;
-                    queue.emplace_back(edge.target);
-                }
-            }
+        for (auto &index : singleLabelIndices) {
+            index = ReachabilityIndex::create("pll");
+            deserializeNested(reader, *index, sccGraphs.emplace_back(), mappings);
         }
 
-        return false;
+        indices.resize(reader.read<uint64_t>());
+
+        for (auto &indexPair : indices) {
+            reader.read(indexPair.first);
+
+            indexPair.second = ReachabilityIndex::create("bfl-once", "4");
+            deserializeNested(reader, *indexPair.second, sccGraphs.emplace_back(), mappings);
+        }
+
+        if (reader.read<uint8_t>() != 0) {
+            allIndex = ReachabilityIndex::create("PLL");
+            deserializeNested(reader, *allIndex, allSccGraph, mappings);
+        }
     }
 
     size_t KLCBFLIndex::indexSize() const {
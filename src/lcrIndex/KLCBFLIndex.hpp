@@ -20,10 +20,13 @@ namespace lcr {
         KLCBFLIndex(uint32_t k) : maxCombinations(k) { }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
-        QueryResult queryOnce(const LCRQuery& query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
+
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
 
         void setGraph(LabeledEdgeGraph *labeledGraph) override {
@@ -49,12 +52,10 @@ namespace lcr {
         }
 
     private:
-        void createSingleIndex(Label label);
-        bool createIndex(const LabelSet &labelSet);
-
-        bool defaultStrategy(const LCRQuery &query, std::vector<ReachabilityIndex *> &reachIndexes);
+        bool defaultStrategy(const LCRQuery &query, std::vector<ReachabilityIndex *> &reachIndexes,
+                             QueryContext &context) const;
 
         void gatherReachIndexes(const ReachQuery &query, const LabelSet &labelSet,
-                                std::vector<ReachabilityIndex *> &reachIndexes);
+                                std::vector<ReachabilityIndex *> &reachIndexes) const;
     };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <utility/CategorizedStepTimer.hpp>
+#include "CombinationPlanner.hpp"
 #include "KLCFreqIndex.hpp"
 
 namespace lcr {
@@ -6,24 +7,29 @@ namespace lcr {
         auto &labeledGraph = getGraph();
         uint64_t labelCount = labeledGraph.getLabelCount();
 
-        singleLabelIndices.resize(labeledGraph.getLabelCount());
+        CombinationBuilder builder(labeledGraph, getMemoryBudget());
+
+        auto createIndex = [this]() {
+            return ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+        };
 
         for (auto label = 0u; label < labeledGraph.getLabelCount(); label++) {
-            createSingleIndex(label);
+            LabelSet labelSet(labelCount);
+            labelSet[label] = true;
+
+            builder.add(labelSet, createIndex, false);
         }
 
         std::queue<std::tuple<LabelSet, uint32_t, uint32_t>> queue;
         queue.emplace(labelCount, 0, 0);
 
-        auto expectedCount = calculateCombinationsUpToK(maxCombinations, labelCount);
-
-        std::vector<std::pair<uint32_t, Label>> numEdgesByLabel;
-        labelDistribution(labeledGraph, numEdgesByLabel);
-
-        aboveLookup.reserve(maxAboveCombinations);
+        auto addCombination = [&](const LabelSet &labelSet) {
+            if (labelSet.count() <= 1 || labelSet.all()) {
+                return;
+            }
 
-        indices.reserve(expectedCount + maxAboveCombinations - labeledGraph.getLabelCount());
-        sccGraphs.reserve(expectedCount + maxAboveCombinations);
+            builder.add(labelSet, createIndex, true);
+        };
 
         while (!queue.empty()) {
             auto current = queue.front();
@@ -34,21 +40,8 @@ namespace lcr {
             auto count = std::get<2>(current);
 
             // Do something with combination
-            if (i >= labelCount) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet, false);
-                continue;
-            }
-
-            if (count == maxCombinations) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet, false);
+            if (i >= labelCount || count == maxCombinations) {
+                addCombination(labelSet);
                 continue;
             }
 
@@ -60,6 +53,35 @@ namespace lcr {
             queue.emplace(next, i + 1, count + 1);
         }
 
+        builder.run();
+
+        // Take over the results in the order the builds were added.
+        singleLabelIndices.resize(labelCount);
+        sccGraphs.reserve(builder.getBuildCount());
+
+        auto minLabels = std::max(minLabelsAboveCombinations, maxCombinations + 1);
+        CombinationPlanner planner(labeledGraph, minLabels, maxLabelsAboveCombinations);
+
+        for (auto label = 0u; label < labelCount; label++) {
+            auto &build = builder.getBuild(label);
+            planner.calibrate(build.labelSet, build.index->indexSize() + build.sccGraph->getSizeInBytes());
+
+            singleLabelIndices[label] = std::move(build.index);
+            sccGraphs.emplace_back(std::move(build.sccGraph));
+        }
+
+        indices.reserve(builder.getBuildCount() - labelCount);
+
+        for (auto position = labelCount; position < builder.getBuildCount(); position++) {
+            auto &build = builder.getBuild(position);
+
+            if (build.index != nullptr) {
+                planner.calibrate(build.labelSet, build.index->indexSize() + build.sccGraph->getSizeInBytes());
+            }
+
+            addIndex(build, false);
+        }
+
         if (maxCombinations < labelCount) {
             LabelSet labelSet(labelCount);
             labelSet.set();
@@ -79,173 +101,57 @@ namespace lcr {
                 allSccGraph->clearComponentGraph();
             }
 
-            std::vector<Vertex> order;
-            vertexOrderByDegree(*graph, order);
-
-            std::stack<VertexLabelSet> vertexQueue;
-            VertexLabelSetVisitedSet visited;
-            std::unordered_map<LabelSet, uint32_t> frequencyMap;
-            uint32_t totalSetCount = 0;
-
-            for (auto ordered : order) {
-                uint32_t setCount = 0;
-                countFrequencies(vertexQueue, ordered, visited, frequencyMap, setCount);
-
-                totalSetCount += setCount;
-
-                if (totalSetCount > maxTotalSetCount) {
-                    break;
-                }
+            if (maxLabelsAboveCombinations < minLabels) {
+                return;
             }
 
-            std::vector<std::pair<float, LabelSet>> sorted;
-            sorted.reserve(frequencyMap.size());
-
-            for (const auto &pair : frequencyMap) {
-                if (pair.first.count() <= maxCombinations) {
-                    continue;
-                }
-
-                sorted.emplace_back(float(pair.second) * float(pair.first.count()), pair.first);
-            }
-
-            std::sort(sorted.begin(), sorted.end(), std::greater<>());
-
-            for (auto i = 0; i < maxAboveCombinations && i < sorted.size(); i++) {
-                auto &best = sorted[i];
-
-                createIndex(best.second, true);
-            }
-        }
-    }
-
-    void
-    KLCFreqIndex::countFrequencies(std::stack<VertexLabelSet> &queue, Vertex vertex, VertexLabelSetVisitedSet &visited,
-                                   std::unordered_map<LabelSet, uint32_t> &frequencyMap, uint32_t &setCount) {
-        auto &graph = getGraph();
-
-        queue.emplace(vertex, graph.getLabelCount());
-        VertexLabelSet current(vertex, graph.getLabelCount());
-
-        while (!queue.empty()) {
-            current = queue.top();
-            queue.pop();
-
-            auto pair = std::make_pair<>(current.first, current.second);
-
-            if (visited.count(pair) != 0) {
-                continue;
-            }
-
-            auto count = current.second.count();
-            visited.emplace(current.first, current.second);
-
-            if (count >= minLabelsAboveCombinations) {
-                auto ptr = frequencyMap.find(current.second);
+            std::vector<Vertex> order;
+            vertexOrderByDegree(*graph, order);
+            graph = nullptr;
 
-                if (ptr != frequencyMap.end()) {
-                    ptr->second++;
-                } else {
-                    frequencyMap.emplace(current.second, 1);
-                }
+            // A quarter of the memory budget that is left goes to the sample, half to the above combinations. In use
+            // are the labeled graph, the vertex order and every index built so far with its component graph, the
+            // calibrated bytes hold the single label and combination indexes. The budget is the configured limit,
+            // thus the plan does not depend on what else runs.
+            auto inUse = labeledGraph.getSizeInBytes() + order.capacity() * sizeof(Vertex) +
+                         planner.getCalibratedBytes() + allIndex->indexSize() + allSccGraph->getSizeInBytes();
+            auto available = getMemoryBudget() > inUse ? getMemoryBudget() - inUse : 0;
 
-                setCount++;
+            planner.sample(order, available / 4);
+            auto plan = planner.plan(available / 2);
 
-                if (setCount > maxPerVertexSetCount) {
-                    return;
-                }
-            }
+            CombinationBuilder aboveBuilder(labeledGraph, getMemoryBudget());
 
-            if (count > maxLabelsAboveCombinations) {
-                continue;
+            for (auto &aboveLabelSet : plan) {
+                aboveBuilder.add(aboveLabelSet, createIndex, true);
             }
 
-            auto it = graph.getConnected(current.first);
-
-            while (it.next()) {
-                auto &edge = *it;
-
-                LabelSet labelSet(graph.getLabelCount());
+            aboveBuilder.run();
 
-                labelSet[edge.label] = true;
-                labelSet |= current.second;
+            sccGraphs.reserve(sccGraphs.size() + aboveBuilder.getBuildCount());
+            aboveLookup.reserve(aboveBuilder.getBuildCount());
 
-                queue.emplace(edge.target, labelSet);
+            for (auto position = 0u; position < aboveBuilder.getBuildCount(); position++) {
+                addIndex(aboveBuilder.getBuild(position), true);
             }
         }
     }
 
-    void KLCFreqIndex::createSingleIndex(Label label) {
-        if (singleLabelIndices[label] != nullptr) {
-            // Already indexed.
+    void KLCFreqIndex::addIndex(CombinationBuilder::Build &build, bool isAbove) {
+        if (build.index == nullptr) {
             return;
         }
 
-        auto &labeledGraph = getGraph();
-
-        LabelSet labelSet(labeledGraph.getLabelCount());
-        labelSet[label] = true;
-
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
-
-        singleLabelIndices[label] = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
-        auto &index = singleLabelIndices[label];
-
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
-
-        index->setGraph(sccGraph.get());
-
-        index->train();
-
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
-        }
-    }
-
-    bool KLCFreqIndex::createIndex(const LabelSet &labelSet, bool isAbove) {
-        if (labelSet.count() <= 1) {
-            return false;
-        }
-
-        if (labelSet.all()) {
-            return false;
-        }
-
-        auto &labeledGraph = getGraph();
-
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
-
-        // Only index the label set if it gives a significant win.
-        // Otherwise it will be found by a previous combination.
-        if (std::abs(stats.increasePercentage) <= 0) {
-            return false;
-        }
-
-        auto &index = indices[labelSet];
-        index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
-
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
-
-        index->setGraph(sccGraph.get());
-
-        index->train();
-
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
-        }
+        auto &index = indices[build.labelSet];
+        index = std::move(build.index);
+        sccGraphs.emplace_back(std::move(build.sccGraph));
 
         if (isAbove) {
-            aboveLookup.emplace_back(labelSet, index.get());
+            aboveLookup.emplace_back(build.labelSet, index.get());
         }
-
-        return true;
     }
 
-    bool KLCFreqIndex::query(const LCRQuery &query) {
+    bool KLCFreqIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -264,7 +170,7 @@ namespace lcr {
 
         // If there is an exact match, use that index.
         if (reachIndex != indices.end() && reachIndex->second->getName()[0] != 'B') {
-            return reachIndex->second->query(reachQuery);
+            return reachIndex->second->query(reachQuery, context);
         } else if (query.labels.size() == 1) {
             // Otherwise if it is a single label, query the single label indices.
             for (auto label = 0u; label < labels.size(); label++) {
@@ -272,7 +178,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return true;
                 }
 
@@ -281,7 +187,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (!allIndex->query(reachQuery)) {
+        if (!allIndex->query(reachQuery, context)) {
             return false;
         }
 
@@ -292,13 +198,13 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return true;
             }
         }
 
         // Go over all combinations that could match.
-        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels)) {
+        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels, context)) {
             return true;
         }
 
@@ -306,15 +212,15 @@ namespace lcr {
         ReachabilityIndex *bestBound = allIndex.get();
 
         // If it is 1 then there exists an above combination that did not reach
-        if (queryAboveCombinations(reachQuery, query.labelSet, bestBound) == -1) {
+        if (queryAboveCombinations(reachQuery, query.labelSet, bestBound, context) == -1) {
             return false;
         }
 
         // Fall back to default strategy.
-        return defaultStrategy(query, bestBound);
+        return defaultStrategy(query, bestBound, context);
     }
 
-    QueryResult KLCFreqIndex::queryOnce(const LCRQuery &query) {
+    QueryResult KLCFreqIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -333,7 +239,7 @@ namespace lcr {
 
         // If there is an exact match, use that index.
         if (reachIndex != indices.end() && reachIndex->second->getName()[0] != 'B') {
-            return reachIndex->second->query(reachQuery) ? QR_Reachable : QR_NotReachable;
+            return reachIndex->second->query(reachQuery, context) ? QR_Reachable : QR_NotReachable;
         } else if (query.labels.size() == 1) {
             // Otherwise if it is a single label, query the single label indices.
             for (auto label = 0u; label < labels.size(); label++) {
@@ -341,7 +247,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return QR_Reachable;
                 }
 
@@ -350,7 +256,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (!allIndex->query(reachQuery)) {
+        if (!allIndex->query(reachQuery, context)) {
             return QR_NotReachable;
         }
 
@@ -361,13 +267,13 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return QR_Reachable;
             }
         }
 
         // Go over all combinations that could match.
-        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels)) {
+        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels, context)) {
             return QR_Reachable;
         }
 
@@ -375,7 +281,7 @@ namespace lcr {
         ReachabilityIndex *bestBound = allIndex.get();
 
         // If it is 1 then there exists an above combination that did not reach
-        if (queryAboveCombinations(reachQuery, query.labelSet, bestBound) == -1) {
+        if (queryAboveCombinations(reachQuery, query.labelSet, bestBound, context) == -1) {
             return QR_NotReachable;
         }
 
@@ -384,18 +290,18 @@ namespace lcr {
     }
 
     bool KLCFreqIndex::queryBelowCombinations(const ReachQuery &query, const LabelSet &labelSet,
-                                              const std::vector<Label> &labels) {
+                                              const std::vector<Label> &labels, QueryContext &context) const {
         LabelSet toCheckSet(getLabelCount());
-        return queryForCombination(query, toCheckSet, labels, 0, labels.size() - 1, 0);
+        return queryForCombination(query, toCheckSet, labels, 0, labels.size() - 1, 0, context);
     }
 
     int8_t KLCFreqIndex::queryAboveCombinations(const ReachQuery &query, const LabelSet &labelSet,
-                                                ReachabilityIndex *&bestBound) {
+                                                ReachabilityIndex *&bestBound, QueryContext &context) const {
         uint32_t bestCount = getLabelCount();
 
         for (auto &indexPair : aboveLookup) {
             if (labelSet.is_subset_of(indexPair.first)) {
-                if (!indexPair.second->queryOnce(query)) {
+                if (!indexPair.second->queryOnce(query, context)) {
                     return -1;
                 } else {
                     auto count = indexPair.first.count();
@@ -413,12 +319,12 @@ namespace lcr {
 
     bool KLCFreqIndex::queryForCombination(const ReachQuery &reachQuery, LabelSet &labelSet,
                                            const std::vector<Label> &labels, uint32_t start, uint32_t end,
-                                           uint32_t index) {
+                                           uint32_t index, QueryContext &context) const {
         if (index == maxCombinations) {
             auto reachIndexIt = indices.find(labelSet);
 
             if (reachIndexIt != indices.end()) {
-                return reachIndexIt->second->query(reachQuery);
+                return reachIndexIt->second->query(reachQuery, context);
             }
 
             // Nothing found here.
@@ -428,7 +334,7 @@ namespace lcr {
         for (uint32_t i = start; i <= end && end - i + 1 >= maxCombinations - index; i++) {
             labelSet[labels[i]] = true;
 
-            if (queryForCombination(reachQuery, labelSet, labels, i + 1, end, index + 1)) {
+            if (queryForCombination(reachQuery, labelSet, labels, i + 1, end, index + 1, context)) {
                 return true;
             }
 
@@ -438,7 +344,8 @@ namespace lcr {
         return false;
     }
 
-    bool KLCFreqIndex::defaultStrategy(const LCRQuery &query, ReachabilityIndex *&bestBound) {
+    bool KLCFreqIndex::defaultStrategy(const LCRQuery &query, ReachabilityIndex *&bestBound,
+                                       QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -446,12 +353,15 @@ namespace lcr {
         auto &labels = query.labelSet;
 
         // Default to BFS.
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
 
         queue.emplace_back(source);
 
-        visited[source] = true;
+        visited.set(source);
 
         while (!queue.empty()) {
             source = queue.front();
@@ -459,7 +369,7 @@ namespace lcr {
 
             ReachQuery reachQuery(source, target);
 
-            if (!bestBound->queryOnce(reachQuery)) {
+            if (!bestBound->queryOnce(reachQuery, context)) {
                 continue;
             }
 
@@ -477,7 +387,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
@@ -486,6 +396,76 @@ namespace lcr {
         return false;
     }
 
+    void KLCFreqIndex::serialize(IndexWriter &writer) const {
+        writer.write(uint64_t(singleLabelIndices.size()));
+
+        for (auto &index : singleLabelIndices) {
+            serializeNested(writer, *index);
+        }
+
+        writer.write(uint64_t(indices.size()));
+
+        for (auto &indexPair : indices) {
+            writer.write(indexPair.first);
+            serializeNested(writer, *indexPair.second);
+        }
+
+        // The above combinations point into the indices, thus only their label sets are stored.
+        writer.write(uint64_t(aboveLookup.size()));
+
+        for (auto &indexPair : aboveLookup) {
+            writer.write(indexPair.first);
+        }
+
+        writer.write(uint8_t(allIndex != nullptr));
+
+        if (allIndex != nullptr) {
+            serializeNested(writer, *allIndex);
+        }
+    }
+
+    void KLCFreqIndex::deserialize(IndexReader &reader) {
+        VertexMappingStore mappings;
+
+        singleLabelIndices.resize(reader.read<uint64_t>());
+
+        for (auto &index : singleLabelIndices) {
+            index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+            deserializeNested(reader, *index, sccGraphs.emplace_back(), mappings);
+        }
+
+        auto count = reader.read<uint64_t>();
+        indices.reserve(count);
+
+        for (auto i = 0u; i < count; i++) {
+            LabelSet labelSet;
+            reader.read(labelSet);
+
+            auto &index = indices[labelSet];
+            index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+            deserializeNested(reader, *index, sccGraphs.emplace_back(), mappings);
+        }
+
+        aboveLookup.resize(reader.read<uint64_t>());
+
+        for (auto &indexPair : aboveLookup) {
+            reader.read(indexPair.first);
+
+            auto it = indices.find(indexPair.first);
+
+            if (it == indices.end()) {
+                std::cerr << "Index file is corrupt! Name: " << indexName << std::fatal;
+            }
+
+            indexPair.second = it->second.get();
+        }
+
+        if (reader.read<uint8_t>() != 0) {
+            allIndex = ReachabilityIndex::create("BFL", "4");
+            deserializeNested(reader, *allIndex, allSccGraph, mappings);
+        }
+    }
+
     size_t KLCFreqIndex::indexSize() const {
         size_t size = 0u;
 
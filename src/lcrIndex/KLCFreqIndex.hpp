@@ -3,6 +3,7 @@
 #include <reachIndex/ReachabilityIndex.hpp>
 #include <reachIndex/BFLIndex.hpp>
 #include <utility>
+#include "CombinationBuilder.hpp"
 #include "Index.hpp"
 
 namespace lcr {
@@ -12,10 +13,6 @@ namespace lcr {
 
         uint32_t maxCombinations;
 
-        uint32_t maxAboveCombinations = 0u;
-        uint32_t maxPerVertexSetCount = 0u;
-        uint32_t maxTotalSetCount = 0u;
-
         uint32_t minLabelsAboveCombinations = 0u;
         uint32_t maxLabelsAboveCombinations = 0u;
 
@@ -39,17 +36,21 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
-        QueryResult queryOnce(const LCRQuery& query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
+
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
 
         void setGraph(LabeledEdgeGraph *labeledGraph) override {
             Index::setGraph(labeledGraph);
+            auto nestedName = " (" + nestedIndexName(reachIndexName, reachIndexOptionalParam) + ")";
 
             if (maxCombinations != std::numeric_limits<uint32_t>::max()) {
-                indexName = "KLCF k=" + std::to_string(maxCombinations) + " (" + reachIndexName + ")";
+                indexName = "KLCF k=" + std::to_string(maxCombinations) + nestedName;
 
                 return;
             }
@@ -59,7 +60,7 @@ namespace lcr {
             if (labelCount <= 4) {
                 // For very small label counts, just do everything
                 maxCombinations = labelCount;
-                indexName = "KLCF k=" + std::to_string(maxCombinations) + " (" + reachIndexName + ")";
+                indexName = "KLCF k=" + std::to_string(maxCombinations) + nestedName;
                 return;
             }
 
@@ -70,31 +71,25 @@ namespace lcr {
             maxLabelsAboveCombinations = std::min<uint32_t>(std::max<uint32_t>(9u, labelCount / 2u),
                                                             std::max<uint32_t>(labelCount, 7u) - 2u);
 
-            maxAboveCombinations = std::min<uint64_t>(1000ull, calculateCombinationsUpToK(maxCombinations, labelCount));
-
             indexName = "KLCF k=" + std::to_string(maxCombinations) + " k_min=" +
                         std::to_string(minLabelsAboveCombinations) + " k_max=" +
-                        std::to_string(maxLabelsAboveCombinations) + " above=" + std::to_string(maxAboveCombinations) +
-                        " (" + reachIndexName + ")";
-
-            maxPerVertexSetCount = 100'000;
-            maxTotalSetCount = 5'000'000;
+                        std::to_string(maxLabelsAboveCombinations) + nestedName;
         }
 
     private:
-        void createSingleIndex(Label label);
-        bool createIndex(const LabelSet &labelSet, bool isAbove);
-
-        bool defaultStrategy(const LCRQuery &query, ReachabilityIndex *&bestBound);
+        /**
+         * @brief takes over the index of a combination build, unless the build was skipped.
+         */
+        void addIndex(CombinationBuilder::Build &build, bool isAbove);
 
-        bool
-        queryBelowCombinations(const ReachQuery &query, const LabelSet &labelSet, const std::vector<Label> &labels);
-        int8_t queryAboveCombinations(const ReachQuery &query, const LabelSet &labelSet, ReachabilityIndex *&bestBound);
+        bool defaultStrategy(const LCRQuery &query, ReachabilityIndex *&bestBound, QueryContext &context) const;
 
-        void countFrequencies(std::stack<VertexLabelSet> &queue, Vertex vertex, VertexLabelSetVisitedSet &visited,
-                              std::unordered_map<LabelSet, uint32_t> &frequencyMap, uint32_t &setCount);
+        bool queryBelowCombinations(const ReachQuery &query, const LabelSet &labelSet, const std::vector<Label> &labels,
+                                    QueryContext &context) const;
+        int8_t queryAboveCombinations(const ReachQuery &query, const LabelSet &labelSet, ReachabilityIndex *&bestBound,
+                                      QueryContext &context) const;
 
         bool queryForCombination(const ReachQuery &reachQuery, LabelSet &labelSet, const std::vector<Label> &labels,
-                                 uint32_t start, uint32_t end, uint32_t index);
+                                 uint32_t start, uint32_t end, uint32_t index, QueryContext &context) const;
     };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <utility/CategorizedStepTimer.hpp>
+#include "CombinationBuilder.hpp"
 #include "KLCIndex.hpp"
 
 namespace lcr {
@@ -6,22 +7,29 @@ namespace lcr {
         auto &labeledGraph = getGraph();
         uint64_t labelCount = labeledGraph.getLabelCount();
 
-        singleLabelIndices.resize(labeledGraph.getLabelCount());
+        CombinationBuilder builder(labeledGraph, getMemoryBudget());
+
+        auto createIndex = [this]() {
+            return ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+        };
 
         for (auto label = 0u; label < labeledGraph.getLabelCount(); label++) {
-            createSingleIndex(label);
+            LabelSet labelSet(labelCount);
+            labelSet[label] = true;
+
+            builder.add(labelSet, createIndex, false);
         }
 
         std::queue<std::tuple<LabelSet, uint32_t, uint32_t>> queue;
         queue.emplace(labelCount, 0, 0);
 
-        auto expectedCount = calculateCombinationsUpToK(maxCombinations, labelCount);
-
-        std::vector<std::pair<uint32_t, Label>> numEdgesByLabel;
-        labelDistribution(labeledGraph, numEdgesByLabel);
+        auto addCombination = [&](const LabelSet &labelSet) {
+            if (labelSet.count() <= 1 || labelSet.all()) {
+                return;
+            }
 
-        indices.reserve(expectedCount - labeledGraph.getLabelCount());
-        sccGraphs.reserve(expectedCount - labeledGraph.getLabelCount());
+            builder.add(labelSet, createIndex, true);
+        };
 
         while (!queue.empty()) {
             auto current = queue.front();
@@ -32,21 +40,8 @@ namespace lcr {
             auto count = std::get<2>(current);
 
             // Do something with combination
-            if (i >= labelCount) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet);
-                continue;
-            }
-
-            if (count == maxCombinations) {
-                if (labelSet.none()) {
-                    continue;
-                }
-
-                createIndex(labelSet);
+            if (i >= labelCount || count == maxCombinations) {
+                addCombination(labelSet);
                 continue;
             }
 
@@ -58,94 +53,51 @@ namespace lcr {
             queue.emplace(next, i + 1, count + 1);
         }
 
+        auto combinationsEnd = builder.getBuildCount();
+
         if (maxCombinations < labelCount) {
             LabelSet labelSet(labelCount);
             labelSet.set();
 
             // Create for all labels.
-            allIndex = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
-
-            MergedGraphStats stats;
-            auto graph = mergeGraphForLabels(getGraph(), labelSet, stats);
-
-            allSccGraph = tarjanSCC(*graph);
-            allIndex->setGraph(allSccGraph.get());
-
-            allIndex->train();
-
-            if (allIndex->canDiscardComponentGraph()) {
-                allSccGraph->clearComponentGraph();
-            }
+            builder.add(labelSet, createIndex, false);
         }
-    }
 
-    void KLCIndex::createSingleIndex(Label label) {
-        if (singleLabelIndices[label] != nullptr) {
-            // Already indexed.
-            return;
-        }
+        builder.run();
 
-        auto &labeledGraph = getGraph();
-
-        LabelSet labelSet(labeledGraph.getLabelCount());
-        labelSet[label] = true;
-
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
-
-        singleLabelIndices[label] = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
-        auto &index = singleLabelIndices[label];
-
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
-
-        index->setGraph(sccGraph.get());
+        // Take over the results in the order the builds were added.
+        singleLabelIndices.resize(labelCount);
+        sccGraphs.reserve(combinationsEnd);
 
-        index->train();
+        for (auto label = 0u; label < labelCount; label++) {
+            auto &build = builder.getBuild(label);
 
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
+            singleLabelIndices[label] = std::move(build.index);
+            sccGraphs.emplace_back(std::move(build.sccGraph));
         }
-    }
 
-    bool KLCIndex::createIndex(const LabelSet &labelSet) {
-        if (labelSet.count() <= 1) {
-            return false;
-        }
-
-        if (labelSet.all()) {
-            return false;
-        }
+        initializeCombinations();
 
-        auto &labeledGraph = getGraph();
+        for (auto position = labelCount; position < combinationsEnd; position++) {
+            auto &build = builder.getBuild(position);
 
-        MergedGraphStats stats;
-        auto graph = mergeGraphForLabels(labeledGraph, labelSet, stats);
+            if (build.index == nullptr) {
+                continue;
+            }
 
-        // Only index the label set if it gives a significant win.
-        // Otherwise it will be found by a previous combination.
-        if (std::abs(stats.increasePercentage) <= 0) {
-            return false;
+            indices[ranking.rank(build.labelSet)] = std::move(build.index);
+            sccGraphs.emplace_back(std::move(build.sccGraph));
         }
 
-        auto &index = indices[labelSet];
-        index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
-
-        auto &sccGraph = sccGraphs.emplace_back();
-        sccGraph = std::move(tarjanSCC(*graph));
+        if (combinationsEnd < builder.getBuildCount()) {
+            auto &build = builder.getBuild(combinationsEnd);
 
-        index->setGraph(sccGraph.get());
-
-        index->train();
-
-        if (index->canDiscardComponentGraph()) {
-            sccGraph->clearComponentGraph();
+            allIndex = std::move(build.index);
+            allSccGraph = std::move(build.sccGraph);
         }
-
-        return true;
     }
 
-    bool KLCIndex::query(const LCRQuery &query) {
+    bool KLCIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -160,11 +112,11 @@ namespace lcr {
         }
 
         ReachQuery reachQuery(query.source, query.target);
-        auto reachIndex = indices.find(query.labelSet);
+        auto *reachIndex = findCombination(query.labelSet);
 
         // If there is an exact match, use that index.
-        if (reachIndex != indices.end()) {
-            return reachIndex->second->query(reachQuery);
+        if (reachIndex != nullptr) {
+            return reachIndex->query(reachQuery, context);
         } else if (labels.count() == 1) {
             // Otherwise if it is a single label, query the single label indices.
             for (auto label = 0u; label < labels.size(); label++) {
@@ -172,7 +124,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return true;
                 }
 
@@ -181,7 +133,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (!allIndex->query(reachQuery)) {
+        if (!allIndex->query(reachQuery, context)) {
             return false;
         }
 
@@ -192,21 +144,21 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return true;
             }
         }
 
         // Go over all combinations that could match.
-        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels)) {
+        if (queryBelowCombinations(reachQuery, query.labelSet, context)) {
             return true;
         }
 
         // Fall back to default strategy.
-        return defaultStrategy(query);
+        return fallbackSearch(query, context);
     }
 
-    QueryResult KLCIndex::queryOnce(const LCRQuery &query) {
+    QueryResult KLCIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         auto source = query.source;
         auto target = query.target;
 
@@ -221,11 +173,11 @@ namespace lcr {
         }
 
         ReachQuery reachQuery(query.source, query.target);
-        auto reachIndex = indices.find(query.labelSet);
+        auto *reachIndex = findCombination(query.labelSet);
 
         // If there is an exact match, use that index.
-        if (reachIndex != indices.end()) {
-            return reachIndex->second->query(reachQuery) ? QR_Reachable : QR_NotReachable;
+        if (reachIndex != nullptr) {
+            return reachIndex->query(reachQuery, context) ? QR_Reachable : QR_NotReachable;
         } else if (labels.count() == 1) {
             // Otherwise if it is a single label, query the single label indices.
             for (auto label = 0u; label < labels.size(); label++) {
@@ -233,7 +185,7 @@ namespace lcr {
                     continue;
                 }
 
-                if (singleLabelIndices[label]->query(reachQuery)) {
+                if (singleLabelIndices[label]->query(reachQuery, context)) {
                     return QR_Reachable;
                 }
 
@@ -242,7 +194,7 @@ namespace lcr {
         }
 
         // If not even reachable in the full graph, we can stop early.
-        if (!allIndex->query(reachQuery)) {
+        if (!allIndex->query(reachQuery, context)) {
             return QR_NotReachable;
         }
 
@@ -253,13 +205,13 @@ namespace lcr {
 
         for (auto label : query.labels) {
             // If found in a single label, no need to continue.
-            if (singleLabelIndices[label]->query(reachQuery)) {
+            if (singleLabelIndices[label]->query(reachQuery, context)) {
                 return QR_Reachable;
             }
         }
 
         // Go over all combinations that could match.
-        if (queryBelowCombinations(reachQuery, query.labelSet, query.labels)) {
+        if (queryBelowCombinations(reachQuery, query.labelSet, context)) {
             return QR_Reachable;
         }
 
@@ -267,77 +219,128 @@ namespace lcr {
         return QR_MaybeReachable;
     }
 
-    bool KLCIndex::queryBelowCombinations(const ReachQuery &query, const LabelSet &labelSet, const std::vector<Label>& labels) {
-        LabelSet toCheckSet(getLabelCount());
-        return queryForCombination(query, toCheckSet, labels, 0, labels.size() - 1, 0);
+    bool KLCIndex::queryBelowCombinations(const ReachQuery &query, const LabelSet &labels,
+                                          QueryContext &context) const {
+        auto labelCount = uint32_t(labels.count());
+
+        // Below 2 labels there are no combinations, only the single label indices.
+        if (maxCombinations < 2 || labelCount < maxCombinations) {
+            return false;
+        }
+
+        return queryForCombination(query, labels, 0, labelCount, 0, 0, context);
     }
 
-    bool
-    KLCIndex::queryForCombination(const ReachQuery &reachQuery, LabelSet &labelSet, const std::vector<Label> &labels,
-                                  uint32_t start, uint32_t end, uint32_t index) {
+    bool KLCIndex::queryForCombination(const ReachQuery &reachQuery, const LabelSet &labels, Label start,
+                                       uint32_t remaining, uint32_t index, size_t rank, QueryContext &context) const {
         if (index == maxCombinations) {
-            auto reachIndexIt = indices.find(labelSet);
+            auto &reachIndex = indices[ranking.offset(maxCombinations) + rank];
 
-            if (reachIndexIt != indices.end()) {
-                return reachIndexIt->second->query(reachQuery);
+            if (reachIndex != nullptr) {
+                return reachIndex->query(reachQuery, context);
             }
 
             // Nothing found here.
             return false;
         }
 
-        for (uint32_t i = start; i <= end && end - i + 1 >= maxCombinations - index; i++) {
-            labelSet[labels[i]] = true;
+        for (auto label = start; label < labels.size() && remaining >= maxCombinations - index; label++) {
+            if (!labels[label]) {
+                continue;
+            }
+
+            remaining--;
+
+            auto labelRank = rank + ranking.binomial(label, index + 1);
 
-            if (queryForCombination(reachQuery, labelSet, labels, i + 1, end, index + 1)) {
+            if (queryForCombination(reachQuery, labels, label + 1, remaining, index + 1, labelRank, context)) {
                 return true;
             }
-
-            labelSet[labels[i]] = false;
         }
 
         return false;
     }
 
-    bool KLCIndex::defaultStrategy(const LCRQuery &query) {
-        auto &graph = getGraph();
+    void KLCIndex::initializeCombinations() {
+        if (maxCombinations < 2) {
+            ranking = CombinationRanking();
+        } else {
+            ranking = CombinationRanking(getLabelCount(), 2, maxCombinations);
+        }
 
-        auto source = query.source;
-        auto target = query.target;
-        auto &labels = query.labelSet;
+        indices.clear();
+        indices.resize(ranking.size());
+    }
 
-        // Default to BFS.
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
-        queue.emplace_back(source);
+    const ReachabilityIndex *KLCIndex::findCombination(const LabelSet &labelSet) const {
+        auto rank = ranking.rank(labelSet);
 
-        visited[source] = true;
+        if (rank == CombinationRanking::npos) {
+            return nullptr;
+        }
 
-        while (!queue.empty()) {
-            source = queue.front();
-            queue.pop_front();
+        return indices[rank].get();
+    }
 
-            auto it = graph.getConnected(source);
+    void KLCIndex::serialize(IndexWriter &writer) const {
+        writer.write(uint64_t(singleLabelIndices.size()));
 
-            while (it.next()) {
-                auto &edge = *it;
+        for (auto &index : singleLabelIndices) {
+            serializeNested(writer, *index);
+        }
 
-                if (!query.labelSet[edge.label]) {
-                    continue;
-                }
+        auto count = std::count_if(indices.begin(), indices.end(), [](auto &index) { return index != nullptr; });
+        writer.write(uint64_t(count));
 
-                if (edge.target == target) {
-                    return true;
-                }
+        for (auto rank = 0u; rank < indices.size(); rank++) {
+            if (indices[rank] == nullptr) {
+                continue;
+            }
 
-                if (!visited[edge.target]) {
-                    visited[edge.target] = true;
-                    queue.emplace_back(edge.target);
-                }
+            writer.write(ranking.unrank(rank));
+            serializeNested(writer, *indices[rank]);
+        }
+
+        writer.write(uint8_t(allIndex != nullptr));
+
+        if (allIndex != nullptr) {
+            serializeNested(writer, *allIndex);
+        }
+    }
+
+    void KLCIndex::deserialize(IndexReader &reader) {
+        VertexMappingStore mappings;
+
+        singleLabelIndices.resize(reader.read<uint64_t>());
+
+        for (auto &index : singleLabelIndices) {
+            index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+            deserializeNested(reader, *index, sccGraphs.emplace_back(), mappings);
+        }
+
+        initializeCombinations();
+
+        auto count = reader.read<uint64_t>();
+
+        for (auto i = 0u; i < count; i++) {
+            LabelSet labelSet;
+            reader.read(labelSet);
+
+            auto rank = ranking.rank(labelSet);
+
+            if (labelSet.size() != getLabelCount() || rank == CombinationRanking::npos) {
+                std::cerr << "Index file is corrupt! Name: " << indexName << std::fatal;
             }
+
+            auto &index = indices[rank];
+            index = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+            deserializeNested(reader, *index, sccGraphs.emplace_back(), mappings);
         }
 
-        return false;
+        if (reader.read<uint8_t>() != 0) {
+            allIndex = ReachabilityIndex::create(reachIndexName, std::to_string(reachIndexOptionalParam));
+            deserializeNested(reader, *allIndex, allSccGraph, mappings);
+        }
     }
 
     size_t KLCIndex::indexSize() const {
@@ -348,7 +351,9 @@ namespace lcr {
         }
 
         for (auto &index : indices) {
-            size += index.second->indexSize();
+            if (index != nullptr) {
+                size += index->indexSize();
+            }
         }
 
         for (auto &sccGraph : sccGraphs) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <reachIndex/ReachabilityIndex.hpp>
+#include <dataStructures/CombinationRanking.hpp>
 #include <utility>
 #include "Index.hpp"
 
@@ -15,7 +16,11 @@ namespace lcr {
         uint32_t reachIndexOptionalParam;
 
         std::vector<std::unique_ptr<ReachabilityIndex>> singleLabelIndices;
-        std::unordered_map<LabelSet, std::unique_ptr<ReachabilityIndex>> indices;
+
+        // The combinations of 2 up to k labels, at the rank of their label set. Empty if a combination is skipped.
+        CombinationRanking ranking;
+        std::vector<std::unique_ptr<ReachabilityIndex>> indices;
+
         std::vector<std::unique_ptr<SCCGraph>> sccGraphs;
 
         std::unique_ptr<ReachabilityIndex> allIndex;
@@ -29,17 +34,21 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
-        QueryResult queryOnce(const LCRQuery& query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
+
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
 
         void setGraph(LabeledEdgeGraph *labeledGraph) override {
             Index::setGraph(labeledGraph);
+            auto nestedName = " (" + nestedIndexName(reachIndexName, reachIndexOptionalParam) + ")";
 
             if (maxCombinations != std::numeric_limits<uint32_t>::max()) {
-                indexName = "KLC k=" + std::to_string(maxCombinations) + " (" + reachIndexName + ")";
+                indexName = "KLC k=" + std::to_string(maxCombinations) + nestedName;
 
                 return;
             }
@@ -49,22 +58,32 @@ namespace lcr {
             if (labelCount <= 4) {
                 // For very small label counts, just do everything
                 maxCombinations = labelCount;
-                indexName = "KLC k=" + std::to_string(maxCombinations) + " (" + reachIndexName + ")";
+                indexName = "KLC k=" + std::to_string(maxCombinations) + nestedName;
                 return;
             }
 
             maxCombinations = 2;
-            indexName = "KLC k=" + std::to_string(maxCombinations) + " (" + reachIndexName + ")";
+            indexName = "KLC k=" + std::to_string(maxCombinations) + nestedName;
         }
 
     private:
-        void createSingleIndex(Label label);
-        bool createIndex(const LabelSet &labelSet);
-
-        bool defaultStrategy(const LCRQuery &query);
-
-        bool queryBelowCombinations(const ReachQuery &query, const LabelSet &labelSet, const std::vector<Label>& labels);
-        bool queryForCombination(const ReachQuery &reachQuery, LabelSet &labelSet, const std::vector<Label> &labels,
-                                 uint32_t start, uint32_t end, uint32_t index);
+        bool queryBelowCombinations(const ReachQuery &query, const LabelSet &labels, QueryContext &context) const;
+
+        /**
+         * @brief queries the combinations of the labels from start on, remaining is the number of those labels.
+         * The labels are taken from the label set in ascending order, thus rank is the colex rank of those taken.
+         */
+        bool queryForCombination(const ReachQuery &reachQuery, const LabelSet &labels, Label start, uint32_t remaining,
+                                 uint32_t index, size_t rank, QueryContext &context) const;
+
+        /**
+         * @brief ranks the combinations of 2 up to k labels, every combination starts out without an index.
+         */
+        void initializeCombinations();
+
+        /**
+         * @brief the index of the combination of exactly the labels in labelSet, or nullptr if it has none.
+         */
+        [[nodiscard]] const ReachabilityIndex *findCombination(const LabelSet &labelSet) const;
     };
 }
\ No newline at end of file
@@ -1,20 +1,22 @@
 #include "LWBFIndex.hpp"
 
 namespace lcr {
-    bool LWBFIndex::isReachable(Vertex source, Vertex target, const LabelSet &labelSet) {
+    bool LWBFIndex::isReachable(Vertex source, Vertex target, const LabelSet &labelSet) const {
         if (!isBloomFilter(source)) {
             return true;
         }
 
+        // All filters have the same size, thus the bits of a vertex are computed once for all of them.
         if (isBloomFilter(target)) {
             bool isMaybeReachable = false;
+            auto sourceProbe = BlockedBloomFilter::probe(source, bloomFilterBits, hashCount);
 
             for (auto &targetLabelIn : incomingLabels[bloomFilterMapping[target]]) {
                 if (!targetLabelIn.first.is_subset_of(labelSet)) {
                     continue;
                 }
 
-                if (targetLabelIn.second.contains(source)) {
+                if (targetLabelIn.second.contains(sourceProbe)) {
                     isMaybeReachable = true;
                     break;
                 }
@@ -26,13 +28,14 @@ namespace lcr {
         }
 
         bool isMaybeReachable = false;
+        auto targetProbe = BlockedBloomFilter::probe(target, bloomFilterBits, hashCount);
 
         for (auto &sourceLabelOut : outgoingLabels[bloomFilterMapping[source]]) {
             if (!sourceLabelOut.first.is_subset_of(labelSet)) {
                 continue;
             }
 
-            if (sourceLabelOut.second.contains(target)) {
+            if (sourceLabelOut.second.contains(targetProbe)) {
                 isMaybeReachable = true;
                 break;
             }
@@ -172,7 +175,7 @@ namespace lcr {
             auto &bloomFilterOut = outgoingLabels[bloomFilterMapping[vertex]].emplace_back();
 
             bloomFilterOut.first = pair.first;
-            bloomFilterOut.second.setup(bloomFilterBits);
+            bloomFilterOut.second.setup(bloomFilterBits, hashCount);
 
             for (auto reachableVertex : pair.second) {
                 bloomFilterOut.second.add(reachableVertex);
@@ -182,7 +185,7 @@ namespace lcr {
                     auto &bloomFilterIn = incomingMap[pair.first];
 
                     if (bloomFilterIn.empty()) {
-                        bloomFilterIn.setup(bloomFilterBits);
+                        bloomFilterIn.setup(bloomFilterBits, hashCount);
                     }
 
                     bloomFilterIn.add(vertex);
@@ -204,7 +207,7 @@ namespace lcr {
             auto &bloomFilterOut = outgoingLabels[bloomFilterMapping[vertex]].emplace_back();
 
             bloomFilterOut.first = pair.first;
-            bloomFilterOut.second.setup(bloomFilterBits);
+            bloomFilterOut.second.setup(bloomFilterBits, hashCount);
 
             for (auto reachableVertex : pair.second) {
                 bloomFilterOut.second.add(reachableVertex);
@@ -214,7 +217,7 @@ namespace lcr {
                     auto &bloomFilterIn = incomingMap[pair.first];
 
                     if (bloomFilterIn.empty()) {
-                        bloomFilterIn.setup(bloomFilterBits);
+                        bloomFilterIn.setup(bloomFilterBits, hashCount);
                     }
 
                     bloomFilterIn.add(vertex);
@@ -289,7 +292,7 @@ namespace lcr {
         }
     }
 
-    bool LWBFIndex::query(const LCRQuery &query) {
+    bool LWBFIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -313,10 +316,13 @@ namespace lcr {
             return queryLandmark(source, target, query.labelSet);
         }
 
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
 
-        visited[source] = true;
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
+
+        visited.set(source);
         queue.emplace_back(source);
 
         while (!queue.empty()) {
@@ -349,7 +355,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
@@ -358,7 +364,7 @@ namespace lcr {
         return false;
     }
 
-    QueryResult LWBFIndex::queryOnce(const LCRQuery &query) {
+    QueryResult LWBFIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         if (!isReachable(query.source, query.target, query.labelSet)) {
             return QR_NotReachable;
         }
@@ -370,7 +376,7 @@ namespace lcr {
         return QR_MaybeReachable;
     }
 
-    QueryResult LWBFIndex::queryOnceRecursive(const LCRQuery &query) {
+    QueryResult LWBFIndex::queryOnceRecursive(const LCRQuery &query, QueryContext &context) const {
         if (!isReachable(query.source, query.target, query.labelSet)) {
             return QR_NotReachable;
         }
@@ -382,7 +388,7 @@ namespace lcr {
         return QR_MaybeReachable;
     }
 
-    bool LWBFIndex::queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) {
+    bool LWBFIndex::queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) const {
         auto &landmarkIndex = landmarkMap[landmarkMapping[landmark]];
 
         auto pair = std::make_pair(target, labelSet);
@@ -409,7 +415,7 @@ namespace lcr {
     }
 
     bool LWBFIndex::queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet,
-                                  boost::dynamic_bitset<> &visited) {
+                                  EpochVisitedSet &visited) const {
         auto index = landmarkMapping[landmark];
         auto &landmarkIndex = landmarkMap[index];
 
@@ -436,6 +442,70 @@ namespace lcr {
         return false;
     }
 
+    void LWBFIndex::serialize(IndexWriter &writer) const {
+        // The name does not contain the parameters, thus they are stored with the index.
+        writer.write(landmarkCount);
+        writer.write(numBloomFilters);
+        writer.write(bloomFilterBits);
+        writer.write(hashCount);
+
+        serializeFilters(writer, outgoingLabels);
+        serializeFilters(writer, incomingLabels);
+
+        writer.write(landmarkMapping);
+        writer.write(bloomFilterMapping);
+        writer.write(landmarkMap);
+    }
+
+    void LWBFIndex::deserialize(IndexReader &reader) {
+        auto storedLandmarkCount = reader.read<uint32_t>();
+        auto storedNumBloomFilters = reader.read<uint32_t>();
+        auto storedBloomFilterBits = reader.read<uint32_t>();
+        auto storedHashCount = reader.read<uint32_t>();
+
+        if (storedLandmarkCount != landmarkCount || storedNumBloomFilters != numBloomFilters ||
+            storedBloomFilterBits != bloomFilterBits || storedHashCount != hashCount) {
+            std::cerr << "Index file was trained with different parameters! Name: " << indexName << std::fatal;
+        }
+
+        deserializeFilters(reader, outgoingLabels);
+        deserializeFilters(reader, incomingLabels);
+
+        reader.read(landmarkMapping);
+        reader.read(bloomFilterMapping);
+        reader.read(landmarkMap);
+    }
+
+    void LWBFIndex::serializeFilters(IndexWriter &writer,
+                                     const std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> &filters) {
+        writer.write(uint64_t(filters.size()));
+
+        for (auto &vertexFilters : filters) {
+            writer.write(uint64_t(vertexFilters.size()));
+
+            for (auto &filter : vertexFilters) {
+                writer.write(filter.first);
+                writer.write(filter.second.getBlocks());
+            }
+        }
+    }
+
+    void LWBFIndex::deserializeFilters(
+            IndexReader &reader, std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> &filters) const {
+        filters.resize(reader.read<uint64_t>());
+
+        for (auto &vertexFilters : filters) {
+            vertexFilters.resize(reader.read<uint64_t>());
+
+            for (auto &filter : vertexFilters) {
+                reader.read(filter.first);
+
+                filter.second.setup(bloomFilterBits, hashCount);
+                reader.read(filter.second.getBlocks());
+            }
+        }
+    }
+
     size_t LWBFIndex::indexSize() const {
         size_t size = 0;
 
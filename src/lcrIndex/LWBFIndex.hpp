@@ -8,7 +8,7 @@ namespace lcr {
         VertexQueueVec queue;
 
         boost::dynamic_bitset<> landmarkVisited;
-        std::vector<std::map<LabelSet, BloomFilter1Hash>> incomingLabels;
+        std::vector<std::map<LabelSet, BlockedBloomFilter>> incomingLabels;
 
         std::vector<std::vector<LabelSet>> vertexLookup;
 
@@ -26,9 +26,10 @@ namespace lcr {
         uint32_t landmarkCount;
         uint32_t numBloomFilters;
         uint32_t bloomFilterBits;
+        uint32_t hashCount;
 
-        std::vector<std::vector<std::pair<LabelSet, BloomFilter1Hash>>> outgoingLabels;
-        std::vector<std::vector<std::pair<LabelSet, BloomFilter1Hash>>> incomingLabels;
+        std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> outgoingLabels;
+        std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> incomingLabels;
 
         std::vector<uint32_t> landmarkMapping;
         std::vector<uint32_t> bloomFilterMapping;
@@ -36,9 +37,9 @@ namespace lcr {
         std::vector<std::vector<std::pair<Vertex, LabelSet>>> landmarkMap;
 
     public:
-        explicit LWBFIndex(uint32_t landmarkCount, uint32_t numBloomFilters,
-                           uint32_t bloomFilterBits) : landmarkCount(landmarkCount), numBloomFilters(numBloomFilters),
-                                                       bloomFilterBits(bloomFilterBits) {
+        explicit LWBFIndex(uint32_t landmarkCount, uint32_t numBloomFilters, uint32_t bloomFilterBits,
+                           uint32_t hashCount) : landmarkCount(landmarkCount), numBloomFilters(numBloomFilters),
+                                                 bloomFilterBits(bloomFilterBits), hashCount(hashCount) {
             indexName = "Landmarks with bloom filters";
         }
 
@@ -63,10 +64,10 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
-        QueryResult queryOnce(const LCRQuery& query) override;
-        QueryResult queryOnceRecursive(const LCRQuery& query) override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnceRecursive(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
 
@@ -74,8 +75,16 @@ namespace lcr {
             return indexName;
         }
 
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
+
     private:
-        bool isReachable(Vertex source, Vertex target, const LabelSet &labelSet);
+        bool isReachable(Vertex source, Vertex target, const LabelSet &labelSet) const;
+
+        static void serializeFilters(IndexWriter &writer,
+                                     const std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> &filters);
+        void deserializeFilters(IndexReader &reader,
+                                std::vector<std::vector<std::pair<LabelSet, BlockedBloomFilter>>> &filters) const;
 
         void forwardBFS(Vertex vertex, LWBFTrainState &trainState);
         void createBloomFilter(Vertex vertex, LWBFTrainState &trainState);
@@ -84,8 +93,8 @@ namespace lcr {
         [[nodiscard]] bool isLandmark(Vertex vertex) const;
         [[nodiscard]] bool isBloomFilter(Vertex vertex) const;
 
-        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet);
-        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet, boost::dynamic_bitset<> &visited);
+        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) const;
+        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet, EpochVisitedSet &visited) const;
 
         void
         tryInsertLandmark(Vertex landmark, Vertex otherLandmark, const LabelSet &labelSet, LWBFTrainState &trainState);
@@ -73,7 +73,7 @@ namespace lcr {
         }
     }
 
-    bool LandmarkPlusIndex::query(const LCRQuery &query) {
+    bool LandmarkPlusIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -93,7 +93,11 @@ namespace lcr {
             return queryLandmark(source, target, labelSet);
         }
 
-        boost::dynamic_bitset<> visited(getVertexCount());
+        auto scratch = context.acquire();
+        scratch->prepareVisited(getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
 
         if (isNonLandmark(source)) {
             if (queryNonLandmark(source, target, labelSet, visited)) {
@@ -101,7 +105,6 @@ namespace lcr {
             }
         }
 
-        std::deque<Vertex> queue;
         queue.emplace_back(source);
 
         while (!queue.empty()) {
@@ -112,7 +115,7 @@ namespace lcr {
                 continue;
             }
 
-            visited[source] = true;
+            visited.set(source);
 
             if (isLandmark(source)) {
                 if (queryExtensive(source, target, labelSet, visited)) {
@@ -144,7 +147,7 @@ namespace lcr {
         return false;
     }
 
-    QueryResult LandmarkPlusIndex::queryOnce(const LCRQuery &query) {
+    QueryResult LandmarkPlusIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         if (isLandmark(query.source)) {
             if (queryLandmark(query.source, query.target, query.labelSet)) {
                 return QR_Reachable;
@@ -162,7 +165,7 @@ namespace lcr {
         return QR_MaybeReachable;
     }
 
-    QueryResult LandmarkPlusIndex::queryOnceRecursive(const LCRQuery &query) {
+    QueryResult LandmarkPlusIndex::queryOnceRecursive(const LCRQuery &query, QueryContext &context) const {
         if (isLandmark(query.source)) {
             if (queryLandmark(query.source, query.target, query.labelSet)) {
                 return QR_Reachable;
@@ -175,14 +178,14 @@ namespace lcr {
     }
 
     bool LandmarkPlusIndex::queryExtensive(Vertex landmark, Vertex target, const LabelSet &labelSet,
-                                           boost::dynamic_bitset<> &visited) {
+                                           EpochVisitedSet &visited) const {
         if (queryLandmark(landmark, target, labelSet)) {
             return true;
         }
 
         for (auto &reachableSet : getReachableBy(landmark)) {
             if (reachableSet.labelSet.is_subset_of(labelSet)) {
-                visited |= reachableSet.reachable;
+                visited.insertAll(reachableSet.reachable);
                 break;
             }
         }
@@ -190,7 +193,7 @@ namespace lcr {
         return false;
     }
 
-    bool LandmarkPlusIndex::queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) {
+    bool LandmarkPlusIndex::queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) const {
         auto &landmarkIndex = getLandmark(landmark);
 
         auto pair = std::make_pair(target, labelSet);
@@ -217,7 +220,7 @@ namespace lcr {
     }
 
     bool LandmarkPlusIndex::queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet,
-                                             boost::dynamic_bitset<> &visited) {
+                                             EpochVisitedSet &visited) const {
         auto &nonLandmarkIndex = getNonLandmark(vertex);
 
         auto pair = std::make_pair(target, labelSet);
@@ -251,7 +254,7 @@ namespace lcr {
         return false;
     }
 
-    bool LandmarkPlusIndex::queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet) {
+    bool LandmarkPlusIndex::queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet) const {
         auto &nonLandmarkIndex = getNonLandmark(vertex);
 
         auto pair = std::make_pair(target, labelSet);
@@ -483,6 +486,21 @@ namespace lcr {
         return nonLandmarkMap[index];
     }
 
+    const std::vector<std::pair<Vertex, LabelSet>> &LandmarkPlusIndex::getLandmark(Vertex current) const {
+        auto index = uint32_t(landmarkMapping[current]);
+        return landmarkMap[index];
+    }
+
+    const std::vector<ReachableEntry> &LandmarkPlusIndex::getReachableBy(Vertex current) const {
+        auto index = uint32_t(landmarkMapping[current]);
+        return reachableBy[index];
+    }
+
+    const std::vector<std::pair<Vertex, LabelSet>> &LandmarkPlusIndex::getNonLandmark(Vertex current) const {
+        auto index = uint32_t(-(landmarkMapping[current] + 1));
+        return nonLandmarkMap[index];
+    }
+
     bool LandmarkPlusIndex::isLandmark(Vertex current) const {
         return landmarkMapping[current] < landmarkCount && landmarkMapping[current] >= 0;
     }
@@ -667,6 +685,44 @@ namespace lcr {
         }
     }
 
+    void LandmarkPlusIndex::serialize(IndexWriter &writer) const {
+        writer.write(landmarkMapping);
+        writer.write(landmarkMap);
+        writer.write(nonLandmarkMap);
+        writer.write(uint64_t(reachableBy.size()));
+
+        for (auto &entries : reachableBy) {
+            writer.write(uint64_t(entries.size()));
+
+            for (auto &entry : entries) {
+                writer.write(entry.labelSet);
+                writer.write(entry.reachable);
+            }
+        }
+    }
+
+    void LandmarkPlusIndex::deserialize(IndexReader &reader) {
+        reader.read(landmarkMapping);
+        reader.read(landmarkMap);
+        reader.read(nonLandmarkMap);
+        reachableBy.resize(reader.read<uint64_t>());
+
+        for (auto &entries : reachableBy) {
+            auto count = reader.read<uint64_t>();
+
+            entries.clear();
+            entries.reserve(count);
+
+            for (auto i = 0u; i < count; i++) {
+                LabelSet labelSet;
+                reader.read(labelSet);
+
+                auto &entry = entries.emplace_back(std::move(labelSet), 0);
+                reader.read(entry.reachable);
+            }
+        }
+    }
+
     size_t LandmarkPlusIndex::indexSize() const {
         size_t size = 0;
 
@@ -48,25 +48,28 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
-        QueryResult queryOnce(const LCRQuery& query) override;
-        QueryResult queryOnceRecursive(const LCRQuery& query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnceRecursive(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override {
             return indexName;
         }
 
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
+
     private:
         void createIndexForLandmark(VertexReachQueue &queue, Vertex vertex,
                                     std::vector<std::vector<LabelSet>> &vertexLookup);
         void createIndexForNonLandmark(VertexReachQueue &queue, Vertex vertex,
                                        std::vector<std::vector<LabelSet>> &vertexLookup);
 
-        bool queryExtensive(Vertex landmark, Vertex target, const LabelSet &labelSet, boost::dynamic_bitset<> &visited);
-        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet);
-        bool queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet, boost::dynamic_bitset<> &visited);
-        bool queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet);
+        bool queryExtensive(Vertex landmark, Vertex target, const LabelSet &labelSet, EpochVisitedSet &visited) const;
+        bool queryLandmark(Vertex landmark, Vertex target, const LabelSet &labelSet) const;
+        bool queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet, EpochVisitedSet &visited) const;
+        bool queryNonLandmark(Vertex vertex, Vertex target, const LabelSet &labelSet) const;
 
         [[nodiscard]] bool isLandmark(Vertex current) const;
         [[nodiscard]] bool isNonLandmark(Vertex current) const;
@@ -75,6 +78,10 @@ namespace lcr {
         [[nodiscard]] std::vector<std::pair<Vertex, LabelSet>> &getNonLandmark(Vertex current);
         [[nodiscard]] std::vector<ReachableEntry> &getReachableBy(Vertex current);
 
+        [[nodiscard]] const std::vector<std::pair<Vertex, LabelSet>> &getLandmark(Vertex current) const;
+        [[nodiscard]] const std::vector<std::pair<Vertex, LabelSet>> &getNonLandmark(Vertex current) const;
+        [[nodiscard]] const std::vector<ReachableEntry> &getReachableBy(Vertex current) const;
+
         void tryInsertLandmark(Vertex landmark, Vertex otherLandmark, const LabelSet &labelSet,
                                std::vector<std::vector<LabelSet>> &vertexLookup, uint32_t &totalCount);
         static bool tryInsert(Vertex landmark, Vertex target, const LabelSet &labelSet,
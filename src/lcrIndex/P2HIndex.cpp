@@ -1,4 +1,5 @@
 #include <utility/CategorizedStepTimer.hpp>
+#include <threading/ThreadPool.hpp>
 #include "P2HIndex.hpp"
 
 namespace lcr {
@@ -15,6 +16,8 @@ namespace lcr {
             }
 
             buildPrimaryIndex(graph, visited);
+            freeze(primaryReachIn, flatPrimaryReachIn, graph.getLabelCount());
+            freeze(primaryReachOut, flatPrimaryReachOut, graph.getLabelCount());
         } else {
             std::vector<Label> labelOrder;
             orderLabelsByFrequency(graph, labelOrder);
@@ -35,6 +38,9 @@ namespace lcr {
                 buildPrimaryIndex(*primaryGraph, visited);
             }
 
+            freeze(primaryReachIn, flatPrimaryReachIn, numMostFrequentLabels);
+            freeze(primaryReachOut, flatPrimaryReachOut, numMostFrequentLabels);
+
             visited.reset();
             virtualLabelMapping.resize(graph.getLabelCount());
 
@@ -44,10 +50,72 @@ namespace lcr {
 
                 buildSecondaryIndex(*virtualLabelGraph, visited);
             }
+
+            freeze(secondaryReachIn, flatSecondaryReachIn, numMostFrequentLabels);
+            freeze(secondaryReachOut, flatSecondaryReachOut, numMostFrequentLabels);
         }
     }
 
+    void P2HIndex::freeze(TwoHopIndex &index, FlatTwoHopIndex &flatIndex, size_t labelCount) {
+        flatIndex.freeze(index, labelCount);
+
+        // The nested labels are only needed for pruning during construction.
+        TwoHopIndex().swap(index);
+    }
+
+    void FlatTwoHopIndex::freeze(const TwoHopIndex &index, size_t labelCount) {
+        wordsPerMask = std::max(1u, uint32_t((labelCount + LabelSet::bits_per_block - 1) / LabelSet::bits_per_block));
+
+        std::vector<uint32_t> offsets(index.size() + 1);
+        offsets[0] = 0;
+
+        for (auto vertex = 0u; vertex < index.size(); vertex++) {
+            offsets[vertex + 1] = offsets[vertex] + uint32_t(index[vertex].size());
+        }
+
+        std::vector<Vertex> hubs(offsets.back());
+        std::vector<LabelSet::block_type> masks(size_t(offsets.back()) * wordsPerMask, 0);
+
+        for (auto vertex = 0u; vertex < index.size(); vertex++) {
+            auto entry = offsets[vertex];
+
+            for (auto &hubAndLabels : index[vertex]) {
+                auto &labelSet = hubAndLabels.second;
+                auto words = std::min(size_t(wordsPerMask), labelSet.num_blocks());
+
+                hubs[entry] = hubAndLabels.first;
+                std::copy(labelSet.data(), labelSet.data() + words, masks.begin() + size_t(entry) * wordsPerMask);
+
+                entry++;
+            }
+        }
+
+        this->offsets.assign(std::move(offsets));
+        this->hubs.assign(std::move(hubs));
+        this->masks.assign(std::move(masks));
+    }
+
+    void FlatTwoHopIndex::serialize(IndexWriter &writer) const {
+        writer.write(wordsPerMask);
+        writer.write(offsets.data(), offsets.size());
+        writer.write(hubs.data(), hubs.size());
+        writer.write(masks.data(), masks.size());
+    }
+
+    void FlatTwoHopIndex::deserialize(IndexReader &reader) {
+        reader.read(wordsPerMask);
+        reader.read(offsets);
+        reader.read(hubs);
+        reader.read(masks);
+    }
+
     void P2HIndex::buildPrimaryIndex(const LabeledEdgeGraph &graph, boost::dynamic_bitset<> &visited) {
+        // With a single thread the batches only add merge work, thus the sequential construction is used.
+        if (parallel && (getThreadPool().getNumThreads() > 1 || forceBatches)) {
+            buildIndexParallel(graph, primaryReachIn, primaryReachOut);
+            return;
+        }
+
         std::vector<Vertex> order;
 
         // Order the landmark selection by degree.
@@ -79,6 +147,11 @@ namespace lcr {
     }
 
     void P2HIndex::buildSecondaryIndex(const LabeledEdgeGraph &graph, boost::dynamic_bitset<> &visited) {
+        if (parallel && (getThreadPool().getNumThreads() > 1 || forceBatches)) {
+            buildIndexParallel(graph, secondaryReachIn, secondaryReachOut);
+            return;
+        }
+
         // Order the landmark selection by degree.
         std::vector<Vertex> order;
         vertexOrderByDegree(graph, order);
@@ -106,6 +179,203 @@ namespace lcr {
         }
     }
 
+    void P2HIndex::buildIndexParallel(const LabeledEdgeGraph &graph, TwoHopIndex &reachIn, TwoHopIndex &reachOut) {
+        std::vector<Vertex> order;
+        vertexOrderByDegree(graph, order);
+
+        std::vector<uint32_t> rank(graph.getVertexCount());
+
+        for (auto k = 0u; k < order.size(); k++) {
+            rank[order[k]] = k;
+        }
+
+        FrontierSetComparatorWithOrder comparatorWithOrder(&order);
+
+        auto &threadPool = getThreadPool();
+        auto threadCount = std::max(threadPool.getNumThreads(), 1u);
+        auto maxBatchSize = threadCount * 4;
+
+        std::vector<BuildScratch> scratches;
+        scratches.reserve(threadCount);
+
+        for (auto i = 0u; i < threadCount; i++) {
+            scratches.emplace_back(comparatorWithOrder);
+        }
+
+        std::vector<std::vector<std::pair<Vertex, LabelSet>>> forwardCandidates;
+        std::vector<std::vector<std::pair<Vertex, LabelSet>>> reverseCandidates;
+
+        reachIn.resize(graph.getVertexCount());
+        reachOut.resize(graph.getVertexCount());
+
+        // The first landmarks prune the largest part of the graph, therefore the batches start small and grow.
+        auto batchSize = 1u;
+
+        for (auto k = 0u; k < graph.getVertexCount();) {
+            auto batchEnd = uint32_t(std::min(size_t(k + batchSize), graph.getVertexCount()));
+
+            forwardCandidates.clear();
+            reverseCandidates.clear();
+            forwardCandidates.resize(batchEnd - k);
+            reverseCandidates.resize(batchEnd - k);
+
+            // Every landmark of the batch explores the graph using the labels of the previous batches only.
+            std::vector<std::function<void(uint32_t id)>> workGroup;
+
+            for (auto i = k; i < batchEnd; i++) {
+                workGroup.emplace_back([&, i](uint32_t id) {
+                    auto vertex = order[i];
+
+                    collectPrunedBFS(graph, reachIn, reachOut, rank, scratches[id], vertex, false,
+                                     forwardCandidates[i - k]);
+                    collectPrunedBFS(graph, reachIn, reachOut, rank, scratches[id], vertex, true,
+                                     reverseCandidates[i - k]);
+                });
+            }
+
+            threadPool.runWorkGroup(workGroup);
+
+            // Merge in rank order, dropping the labels that are already covered by a higher ranked landmark.
+            for (auto i = k; i < batchEnd; i++) {
+                auto vertex = order[i];
+
+                for (auto &candidate : forwardCandidates[i - k]) {
+                    if (!isReachable(vertex, candidate.first, candidate.second, reachIn, reachOut)) {
+                        insertToIndex(reachIn, candidate.first, vertex, candidate.second);
+                    }
+                }
+
+                for (auto &candidate : reverseCandidates[i - k]) {
+                    if (!isReachable(candidate.first, vertex, candidate.second, reachIn, reachOut)) {
+                        insertToIndex(reachOut, candidate.first, vertex, candidate.second);
+                    }
+                }
+            }
+
+            k = batchEnd;
+            batchSize = std::min(batchSize * 2, maxBatchSize);
+        }
+    }
+
+    void P2HIndex::collectPrunedBFS(const LabeledEdgeGraph &graph, const TwoHopIndex &reachIn,
+                                    const TwoHopIndex &reachOut, const std::vector<uint32_t> &rank,
+                                    BuildScratch &scratch, Vertex vertex, bool reverse,
+                                    std::vector<std::pair<Vertex, LabelSet>> &outCandidates) {
+        auto &current = scratch.current;
+        auto &plusOne = scratch.plusOne;
+        auto &temp = scratch.temp;
+
+        current.clear();
+        plusOne.clear();
+        temp.clear();
+        scratch.labels.clear();
+
+        auto vertexRank = rank[vertex];
+
+        // Vertices with a higher rank are landmarks that were already processed, or this landmark itself.
+        auto isCovered = [&](Vertex target, const LabelSet &labels) {
+            if (rank[target] <= vertexRank) {
+                return true;
+            }
+
+            if (reverse) {
+                return isReachable(target, vertex, labels, reachIn, reachOut);
+            }
+
+            return isReachable(vertex, target, labels, reachIn, reachOut);
+        };
+
+        auto getConnected = [&](Vertex source) {
+            return reverse ? graph.getReverseConnected(source) : graph.getConnected(source);
+        };
+
+        current.emplace(vertex, LabelSet(graph.getLabelCount()));
+
+        while (!current.empty() || !plusOne.empty()) {
+            while (!current.empty()) {
+                temp.clear();
+
+                for (auto &vertexAndLabels : current) {
+                    plusOne.emplace(vertexAndLabels.first, vertexAndLabels.second);
+
+                    auto it = getConnected(vertexAndLabels.first);
+
+                    while (it.next()) {
+                        auto &edge = *it;
+
+                        if (!vertexAndLabels.second[edge.label]) {
+                            continue;
+                        }
+
+                        if (isCovered(edge.target, vertexAndLabels.second)) {
+                            continue;
+                        }
+
+                        if (insertToScratch(scratch, edge.target, vertexAndLabels.second)) {
+                            temp.emplace(edge.target, vertexAndLabels.second);
+                        }
+                    }
+                }
+
+                current = temp;
+            }
+
+            temp.clear();
+
+            for (auto &vertexAndLabels : plusOne) {
+                auto it = getConnected(vertexAndLabels.first);
+
+                while (it.next()) {
+                    auto &edge = *it;
+
+                    if (vertexAndLabels.second[edge.label]) {
+                        continue;
+                    }
+
+                    LabelSet nextLabels(vertexAndLabels.second);
+                    nextLabels[edge.label] = true;
+
+                    if (isCovered(edge.target, nextLabels)) {
+                        continue;
+                    }
+
+                    if (insertToScratch(scratch, edge.target, nextLabels)) {
+                        temp.emplace(edge.target, nextLabels);
+                    }
+                }
+            }
+
+            current = temp;
+            plusOne.clear();
+        }
+
+        outCandidates.clear();
+
+        for (auto &targetAndLabels : scratch.labels) {
+            for (auto &labelSet : targetAndLabels.second) {
+                outCandidates.emplace_back(targetAndLabels.first, labelSet);
+            }
+        }
+    }
+
+    bool P2HIndex::insertToScratch(BuildScratch &scratch, Vertex target, const LabelSet &labelSet) {
+        auto &labelSets = scratch.labels[target];
+
+        for (auto &existing : labelSets) {
+            if (existing.is_subset_of(labelSet)) {
+                return false;
+            }
+        }
+
+        // Remove the label sets that are dominated by the new label set.
+        labelSets.erase(std::remove_if(labelSets.begin(), labelSets.end(), [&labelSet](const LabelSet &existing) {
+            return labelSet.is_subset_of(existing);
+        }), labelSets.end());
+
+        labelSets.emplace_back(labelSet);
+        return true;
+    }
+
     void P2HIndex::prunedBFS(const LabeledEdgeGraph &graph, TwoHopIndex &reachIn, TwoHopIndex &reachOut,
                              FrontierSet &current, FrontierSet &plusOne, FrontierSet &temp,
                              boost::dynamic_bitset<> &visited, Vertex vertex) {
@@ -334,7 +604,7 @@ namespace lcr {
         return true;
     }
 
-    bool P2HIndex::query(const LCRQuery &query) {
+    bool P2HIndex::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -355,17 +625,10 @@ namespace lcr {
         }
 
         LabelSet labelSet(numMostFrequentLabels);
-        bool fullyIncluded = true;
-        bool included = false;
+        bool fullyIncluded;
+        bool included;
 
-        for (auto label : query.labels) {
-            if (primaryLabelSet[label] != std::numeric_limits<uint32_t>::max()) {
-                included = true;
-                labelSet[primaryLabelSet[label]] = true;
-            } else {
-                fullyIncluded = false;
-            }
-        }
+        mapPrimaryLabels(query.labels, labelSet, fullyIncluded, included);
 
         if (fullyIncluded) {
             return isPrimaryReachable(source, target, labelSet);
@@ -379,25 +642,102 @@ namespace lcr {
             return false;
         }
 
-        return defaultStrategy(query);
+        return fallbackSearch(query, context);
     }
 
-    QueryResult P2HIndex::queryOnce(const LCRQuery &query) {
+    void P2HIndex::queryGroup(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                              QueryContext &context) const {
+        auto &graph = getGraph();
+        auto &first = *group.front();
+
+        // All queries in the group share the label set, so the label mappings are only computed once.
+        bool useSecondary = graph.getLabelCount() > numMostFrequentLabels;
+
+        LabelSet labelSet(numMostFrequentLabels);
+        LabelSet virtualLabels;
+        bool fullyIncluded = true;
+        bool included = false;
+
+        if (useSecondary) {
+            mapPrimaryLabels(first.labels, labelSet, fullyIncluded, included);
+            virtualLabels = mapSecondaryLabels(first.labels);
+        }
+
+        // The queries also share the source, so its outgoing entries are only filtered by the labels once.
+        auto &primaryLabels = useSecondary ? labelSet : first.labelSet;
+        std::vector<Vertex> primaryHubs;
+        std::vector<Vertex> secondaryHubs;
+
+        collectHubs(first.source, primaryLabels, flatPrimaryReachOut, primaryHubs);
+
+        if (useSecondary && !fullyIncluded) {
+            collectHubs(first.source, virtualLabels, flatSecondaryReachOut, secondaryHubs);
+        }
+
+        std::vector<uint32_t> unresolved;
+
+        for (auto i = 0u; i < group.size(); i++) {
+            auto source = group[i]->source;
+            auto target = group[i]->target;
+
+            if (source == target) {
+                results[i] = 1u;
+            } else if (first.labelSet.none()) {
+                results[i] = 0u;
+            } else if (!useSecondary || fullyIncluded) {
+                results[i] = isReachable(source, target, primaryHubs, primaryLabels, flatPrimaryReachIn) ? 1u : 0u;
+            } else if (included && isReachable(source, target, primaryHubs, primaryLabels, flatPrimaryReachIn)) {
+                results[i] = 1u;
+            } else if (!isReachable(source, target, secondaryHubs, virtualLabels, flatSecondaryReachIn)) {
+                results[i] = 0u;
+            } else {
+                unresolved.emplace_back(i);
+            }
+        }
+
+        // The remaining queries are answered by a single traversal from the shared source.
+        groupFallbackBFS(group, results, unresolved, context);
+    }
+
+    QueryResult P2HIndex::queryOnce(const LCRQuery &query, QueryContext &context) const {
         return isPrimaryReachable(query.source, query.target, query.labelSet) ? QR_Reachable : QR_NotReachable;
     }
 
-    bool P2HIndex::isPrimaryReachable(Vertex source, Vertex target, const LabelSet &labels) {
-        return isReachable(source, target, labels, primaryReachIn, primaryReachOut);
+    bool P2HIndex::isPrimaryReachable(Vertex source, Vertex target, const LabelSet &labels) const {
+        return isReachable(source, target, labels, flatPrimaryReachIn, flatPrimaryReachOut);
+    }
+
+    bool P2HIndex::isSecondaryReachable(Vertex source, Vertex target, const std::vector<Label> &labels) const {
+        return isSecondaryReachable(source, target, mapSecondaryLabels(labels));
+    }
+
+    bool P2HIndex::isSecondaryReachable(Vertex source, Vertex target, const LabelSet &virtualLabels) const {
+        return isReachable(source, target, virtualLabels, flatSecondaryReachIn, flatSecondaryReachOut);
+    }
+
+    void P2HIndex::mapPrimaryLabels(const std::vector<Label> &labels, LabelSet &labelSet, bool &fullyIncluded,
+                                    bool &included) const {
+        fullyIncluded = true;
+        included = false;
+
+        for (auto label : labels) {
+            if (primaryLabelSet[label] != std::numeric_limits<uint32_t>::max()) {
+                included = true;
+                labelSet[primaryLabelSet[label]] = true;
+            } else {
+                fullyIncluded = false;
+            }
+        }
     }
 
-    bool P2HIndex::isSecondaryReachable(Vertex source, Vertex target, const std::vector<Label> &labels) {
+    LabelSet P2HIndex::mapSecondaryLabels(const std::vector<Label> &labels) const {
         LabelSet virtualLabels(numMostFrequentLabels);
 
         for (auto label : labels) {
             virtualLabels[virtualLabelMapping[label]] = true;
         }
 
-        return isReachable(source, target, virtualLabels, secondaryReachIn, secondaryReachOut);
+        return virtualLabels;
     }
 
     bool P2HIndex::isReachable(Vertex source, Vertex target, const LabelSet &labels, const TwoHopIndex &reachIn,
@@ -521,76 +861,139 @@ namespace lcr {
         return false;
     }
 
-    bool P2HIndex::defaultStrategy(const LCRQuery &query) {
-        auto &graph = getGraph();
+    bool P2HIndex::isReachable(Vertex source, Vertex target, const LabelSet &labels,
+                               const FlatTwoHopIndex &reachIn, const FlatTwoHopIndex &reachOut) {
+        auto labelBlocks = labels.data();
 
-        auto source = query.source;
-        auto target = query.target;
-        auto &labels = query.labelSet;
-
-        // Default to BFS.
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
-        queue.emplace_back(source);
+        auto outgoingIndex = reachOut.begin(source);
+        auto outgoingEnd = reachOut.end(source);
 
-        visited[source] = true;
+        auto incomingIndex = reachIn.begin(target);
+        auto incomingEnd = reachIn.end(target);
 
-        while (!queue.empty()) {
-            source = queue.front();
-            queue.pop_front();
+        // Merge join the sorted hubs of both vertices, a hub may occur multiple times with different labels.
+        while (outgoingIndex < outgoingEnd && incomingIndex < incomingEnd) {
+            auto outgoingHub = reachOut.hub(outgoingIndex);
+            auto incomingHub = reachIn.hub(incomingIndex);
 
-            auto it = graph.getConnected(source);
-
-            while (it.next()) {
-                auto &edge = *it;
-
-                if (!query.labelSet[edge.label]) {
-                    continue;
+            if (outgoingHub < incomingHub) {
+                if (outgoingHub == target && reachOut.isSubsetOf(outgoingIndex, labelBlocks)) {
+                    return true;
                 }
 
-                if (edge.target == target) {
+                outgoingIndex++;
+                continue;
+            }
+
+            if (outgoingHub > incomingHub) {
+                if (incomingHub == source && reachIn.isSubsetOf(incomingIndex, labelBlocks)) {
                     return true;
                 }
 
-                if (!visited[edge.target]) {
-                    visited[edge.target] = true;
-                    queue.emplace_back(edge.target);
-                }
+                incomingIndex++;
+                continue;
+            }
+
+            bool outgoingSubset = false;
+            bool incomingSubset = false;
+
+            for (; outgoingIndex < outgoingEnd && reachOut.hub(outgoingIndex) == outgoingHub; outgoingIndex++) {
+                outgoingSubset |= reachOut.isSubsetOf(outgoingIndex, labelBlocks);
+            }
+
+            for (; incomingIndex < incomingEnd && reachIn.hub(incomingIndex) == incomingHub; incomingIndex++) {
+                incomingSubset |= reachIn.isSubsetOf(incomingIndex, labelBlocks);
+            }
+
+            if (outgoingSubset && (incomingSubset || outgoingHub == target)) {
+                return true;
+            }
+
+            if (incomingSubset && incomingHub == source) {
+                return true;
+            }
+        }
+
+        // Finish the remaining hubs, the target itself can be a hub of the source and vice versa.
+        for (; outgoingIndex < outgoingEnd && reachOut.hub(outgoingIndex) <= target; outgoingIndex++) {
+            if (reachOut.hub(outgoingIndex) == target && reachOut.isSubsetOf(outgoingIndex, labelBlocks)) {
+                return true;
+            }
+        }
+
+        for (; incomingIndex < incomingEnd && reachIn.hub(incomingIndex) <= source; incomingIndex++) {
+            if (reachIn.hub(incomingIndex) == source && reachIn.isSubsetOf(incomingIndex, labelBlocks)) {
+                return true;
             }
         }
 
         return false;
     }
 
-    size_t P2HIndex::indexSize() const {
-        size_t size = 0;
+    void P2HIndex::collectHubs(Vertex source, const LabelSet &labels, const FlatTwoHopIndex &reachOut,
+                               std::vector<Vertex> &hubs) {
+        auto labelBlocks = labels.data();
 
-        for (auto i = 0u; i < getVertexCount(); i++) {
-            for (const auto &reachableSet : primaryReachIn[i]) {
-                size += reachableSet.second.capacity() / 8;
-                size += sizeof(Vertex);
-            }
+        for (auto index = reachOut.begin(source); index < reachOut.end(source); index++) {
+            auto hub = reachOut.hub(index);
 
-            for (const auto &reachableSet : primaryReachOut[i]) {
-                size += reachableSet.second.capacity() / 8;
-                size += sizeof(Vertex);
+            if ((hubs.empty() || hubs.back() != hub) && reachOut.isSubsetOf(index, labelBlocks)) {
+                hubs.emplace_back(hub);
             }
+        }
+    }
 
-            if (getLabelCount() <= numMostFrequentLabels) {
-                continue;
-            }
+    bool P2HIndex::isReachable(Vertex source, Vertex target, const std::vector<Vertex> &sourceHubs,
+                               const LabelSet &labels, const FlatTwoHopIndex &reachIn) {
+        if (std::binary_search(sourceHubs.begin(), sourceHubs.end(), target)) {
+            return true;
+        }
 
-            for (const auto &reachableSet : secondaryReachIn[i]) {
-                size += reachableSet.second.capacity() / 8;
-                size += sizeof(Vertex);
+        auto labelBlocks = labels.data();
+        auto sourceHub = sourceHubs.begin();
+
+        // Merge join the collected hubs of the source with the sorted hubs of the target.
+        for (auto index = reachIn.begin(target); index < reachIn.end(target); index++) {
+            auto hub = reachIn.hub(index);
+
+            while (sourceHub != sourceHubs.end() && *sourceHub < hub) {
+                sourceHub++;
             }
 
-            for (const auto &reachableSet : secondaryReachOut[i]) {
-                size += reachableSet.second.capacity() / 8;
-                size += sizeof(Vertex);
+            if ((hub == source || (sourceHub != sourceHubs.end() && *sourceHub == hub)) &&
+                reachIn.isSubsetOf(index, labelBlocks)) {
+                return true;
             }
+        }
+
+        return false;
+    }
+
+    void P2HIndex::serialize(IndexWriter &writer) const {
+        writer.write(primaryLabelSet);
+        writer.write(virtualLabelMapping);
+
+        flatPrimaryReachIn.serialize(writer);
+        flatPrimaryReachOut.serialize(writer);
+        flatSecondaryReachIn.serialize(writer);
+        flatSecondaryReachOut.serialize(writer);
+    }
+
+    void P2HIndex::deserialize(IndexReader &reader) {
+        reader.read(primaryLabelSet);
+        reader.read(virtualLabelMapping);
+
+        flatPrimaryReachIn.deserialize(reader);
+        flatPrimaryReachOut.deserialize(reader);
+        flatSecondaryReachIn.deserialize(reader);
+        flatSecondaryReachOut.deserialize(reader);
+    }
+
+    size_t P2HIndex::indexSize() const {
+        size_t size = flatPrimaryReachIn.sizeInBytes() + flatPrimaryReachOut.sizeInBytes();
 
-            size += sizeof(Vertex);
+        if (getLabelCount() > numMostFrequentLabels) {
+            size += flatSecondaryReachIn.sizeInBytes() + flatSecondaryReachOut.sizeInBytes();
         }
 
         return size;
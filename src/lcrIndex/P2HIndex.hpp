@@ -6,6 +6,59 @@ namespace lcr {
     typedef std::vector<std::vector<std::pair<Vertex, LabelSet>>> TwoHopIndex;
     typedef std::set<std::pair<Vertex, LabelSet>, FrontierSetComparatorWithOrder> FrontierSet;
 
+    /**
+     * @brief frozen layout of one direction of the two-hop labels.
+     * The hubs of every vertex are stored contiguously and sorted, the label mask of every hub is stored in a parallel
+     * array of wordsPerMask blocks. Queries thereby walk two sequential ranges instead of separately allocated sets.
+     * A loaded index uses the arrays directly from the mapped index file.
+     */
+    class FlatTwoHopIndex {
+    private:
+        MappedArray<uint32_t> offsets;
+        MappedArray<Vertex> hubs;
+        MappedArray<LabelSet::block_type> masks;
+
+        uint32_t wordsPerMask = 1;
+
+    public:
+        void freeze(const TwoHopIndex &index, size_t labelCount);
+
+        void serialize(IndexWriter &writer) const;
+        void deserialize(IndexReader &reader);
+
+        [[nodiscard]] uint32_t begin(Vertex vertex) const {
+            return offsets[vertex];
+        }
+
+        [[nodiscard]] uint32_t end(Vertex vertex) const {
+            return offsets[vertex + 1];
+        }
+
+        [[nodiscard]] Vertex hub(uint32_t entry) const {
+            return hubs[entry];
+        }
+
+        [[nodiscard]] bool isSubsetOf(uint32_t entry, const LabelSet::block_type *labels) const {
+            if (wordsPerMask == 1) {
+                return (masks[entry] & ~labels[0]) == 0;
+            }
+
+            LabelSet::block_type missing = 0;
+            auto mask = masks.data() + size_t(entry) * wordsPerMask;
+
+            for (auto i = 0u; i < wordsPerMask; i++) {
+                missing |= mask[i] & ~labels[i];
+            }
+
+            return missing == 0;
+        }
+
+        [[nodiscard]] size_t sizeInBytes() const {
+            return offsets.size() * sizeof(uint32_t) + hubs.size() * sizeof(Vertex) +
+                   masks.size() * sizeof(LabelSet::block_type);
+        }
+    };
+
     class P2HIndex : public Index {
     private:
         std::vector<Label> primaryLabelSet;
@@ -16,27 +69,70 @@ namespace lcr {
         TwoHopIndex secondaryReachOut;
         TwoHopIndex secondaryReachIn;
 
+        FlatTwoHopIndex flatPrimaryReachOut;
+        FlatTwoHopIndex flatPrimaryReachIn;
+
+        FlatTwoHopIndex flatSecondaryReachOut;
+        FlatTwoHopIndex flatSecondaryReachIn;
+
         std::vector<Label> virtualLabelMapping;
         uint32_t numMostFrequentLabels;
 
+        bool parallel = false;
+        bool forceBatches = false;
+
         std::string indexName = "Pruned 2-Hop w=";
 
+        /**
+         * @brief per thread scratch space of the parallel construction.
+         */
+        struct BuildScratch {
+            FrontierSet current;
+            FrontierSet plusOne;
+            FrontierSet temp;
+
+            // Label sets of the landmark that is currently processed, by reached vertex.
+            std::unordered_map<Vertex, std::vector<LabelSet>> labels;
+
+            explicit BuildScratch(const FrontierSetComparatorWithOrder &comparator) : current(comparator),
+                                                                                     plusOne(comparator),
+                                                                                     temp(comparator) { }
+        };
+
     public:
         explicit P2HIndex() : numMostFrequentLabels(12) {
             indexName += std::to_string(12);
         }
 
-        explicit P2HIndex(uint32_t numMostFrequentLabels) : numMostFrequentLabels(numMostFrequentLabels) {
+        explicit P2HIndex(uint32_t numMostFrequentLabels, bool parallel = false) : numMostFrequentLabels(
+                numMostFrequentLabels), parallel(parallel) {
+            if (parallel) {
+                indexName = "Parallel " + indexName;
+            }
+
             indexName += std::to_string(numMostFrequentLabels);
         }
 
+        /**
+         * @brief uses the batched construction of a parallel index even on a single thread, such that it can be tested.
+         */
+        void setForceBatches(bool force) {
+            forceBatches = force;
+        }
+
         void train() override;
-        bool query(const LCRQuery &query) override;
-        QueryResult queryOnce(const LCRQuery& query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
+        QueryResult queryOnce(const LCRQuery &query, QueryContext &context) const override;
+
+        void queryGroup(const std::vector<const LCRQuery *> &group, std::vector<uint8_t> &results,
+                        QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
 
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
+
     private:
         void buildPrimaryIndex(const LabeledEdgeGraph &graph, boost::dynamic_bitset<> &visited);
         void buildSecondaryIndex(const LabeledEdgeGraph &graph, boost::dynamic_bitset<> &visited);
@@ -48,13 +144,41 @@ namespace lcr {
                                      FrontierSet &current, FrontierSet &plusOne, FrontierSet &temp,
                                      boost::dynamic_bitset<> &visited, Vertex vertex);
 
+        static void buildIndexParallel(const LabeledEdgeGraph &graph, TwoHopIndex &reachIn, TwoHopIndex &reachOut);
+
+        static void collectPrunedBFS(const LabeledEdgeGraph &graph, const TwoHopIndex &reachIn,
+                                     const TwoHopIndex &reachOut, const std::vector<uint32_t> &rank,
+                                     BuildScratch &scratch, Vertex vertex, bool reverse,
+                                     std::vector<std::pair<Vertex, LabelSet>> &outCandidates);
+
+        static bool insertToScratch(BuildScratch &scratch, Vertex target, const LabelSet &labelSet);
+
+        static void freeze(TwoHopIndex &index, FlatTwoHopIndex &flatIndex, size_t labelCount);
+
         static bool insertToIndex(TwoHopIndex &index, Vertex source, Vertex target, const LabelSet &labelSet);
 
-        bool isPrimaryReachable(Vertex source, Vertex target, const LabelSet &labels);
-        bool isSecondaryReachable(Vertex source, Vertex target, const std::vector<Label> &labels);
+        bool isPrimaryReachable(Vertex source, Vertex target, const LabelSet &labels) const;
+        bool isSecondaryReachable(Vertex source, Vertex target, const std::vector<Label> &labels) const;
+        bool isSecondaryReachable(Vertex source, Vertex target, const LabelSet &virtualLabels) const;
+
+        void mapPrimaryLabels(const std::vector<Label> &labels, LabelSet &labelSet, bool &fullyIncluded,
+                              bool &included) const;
+        [[nodiscard]] LabelSet mapSecondaryLabels(const std::vector<Label> &labels) const;
         static bool isReachable(Vertex source, Vertex target, const LabelSet &labels, const TwoHopIndex &reachIn,
                                 const TwoHopIndex &reachOut);
-
-        bool defaultStrategy(const LCRQuery &query);
+        static bool isReachable(Vertex source, Vertex target, const LabelSet &labels,
+                                const FlatTwoHopIndex &reachIn, const FlatTwoHopIndex &reachOut);
+
+        /**
+         * @brief collects the sorted, distinct hubs of the outgoing entries of source that are a subset of labels.
+         */
+        static void collectHubs(Vertex source, const LabelSet &labels, const FlatTwoHopIndex &reachOut,
+                                std::vector<Vertex> &hubs);
+
+        /**
+         * @brief answers a query from the hubs of its source that were collected with the same labels.
+         */
+        static bool isReachable(Vertex source, Vertex target, const std::vector<Vertex> &sourceHubs,
+                                const LabelSet &labels, const FlatTwoHopIndex &reachIn);
     };
 }
\ No newline at end of file
@@ -3,6 +3,36 @@
 
 namespace lcr {
     void ScaleHarness::train() {
+        buildIndexes([](Index &index) {
+            index.train();
+        });
+    }
+
+    void ScaleHarness::serialize(IndexWriter &writer) const {
+        for (auto *index : { primaryIndex.get(), secondaryIndex.get() }) {
+            if (index != nullptr) {
+                writer.write(index->getName());
+                index->serialize(writer);
+            }
+        }
+    }
+
+    void ScaleHarness::deserialize(IndexReader &reader) {
+        // The label mappings and graphs are derived again, the header guarantees the graph is the same.
+        buildIndexes([&reader](Index &index) {
+            std::string name;
+            reader.read(name);
+
+            if (name != index.getName()) {
+                std::cerr << "Index file contains a different index! Expected: " << index.getName() << " found: "
+                          << name << std::fatal;
+            }
+
+            index.deserialize(reader);
+        });
+    }
+
+    void ScaleHarness::buildIndexes(const std::function<void(Index &)> &build) {
         auto &graph = getGraph();
 
         boost::dynamic_bitset<> visited(graph.getVertexCount());
@@ -15,8 +45,10 @@ namespace lcr {
             }
 
             primaryIndex = Index::create(createdIndexName, createdIndexParams);
+            primaryIndex->setFallbackStrategy(getFallbackStrategy());
+            primaryIndex->setMemoryBudget(getMemoryBudget());
             primaryIndex->setGraph(const_cast<LabeledEdgeGraph *>(&graph));
-            primaryIndex->train();
+            build(*primaryIndex);
         } else {
             std::vector<Label> labelOrder;
             orderLabelsByFrequency(graph, labelOrder);
@@ -44,8 +76,10 @@ namespace lcr {
                 auto primaryGraph = splitGraph(graph, labelSet, primaryLabelMapping);
 
                 primaryIndex = Index::create(createdIndexName, createdIndexParams);
+                primaryIndex->setFallbackStrategy(getFallbackStrategy());
+                primaryIndex->setMemoryBudget(getMemoryBudget());
                 primaryIndex->setGraph(primaryGraph.get());
-                primaryIndex->train();
+                build(*primaryIndex);
             }
 
             visited.reset();
@@ -56,13 +90,15 @@ namespace lcr {
                                                                  numMostFrequentLabels / 2, secondaryLabelMapping);
 
                 secondaryIndex = Index::create(createdIndexName, createdIndexParams);
+                secondaryIndex->setFallbackStrategy(getFallbackStrategy());
+                secondaryIndex->setMemoryBudget(getMemoryBudget());
                 secondaryIndex->setGraph(virtualLabelGraph.get());
-                secondaryIndex->train();
+                build(*secondaryIndex);
             }
         }
     }
 
-    bool ScaleHarness::query(const LCRQuery &query) {
+    bool ScaleHarness::query(const LCRQuery &query, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -79,7 +115,7 @@ namespace lcr {
         }
 
         if (graph.getLabelCount() <= numMostFrequentLabels) {
-            return primaryIndex->query(query);
+            return primaryIndex->query(query, context);
         }
 
         LabelSet labelSet(numMostFrequentLabels);
@@ -104,7 +140,7 @@ namespace lcr {
         primaryQuery.target = target;
 
         if (fullyIncluded) {
-            auto result = primaryIndex->queryOnce(primaryQuery);
+            auto result = primaryIndex->queryOnce(primaryQuery, context);
 
             if (result == QR_NotReachable) {
                 return false;
@@ -114,7 +150,7 @@ namespace lcr {
                 return true;
             }
         } else {
-            if (included && primaryIndex->queryOnce(primaryQuery) == QR_Reachable) {
+            if (included && primaryIndex->queryOnce(primaryQuery, context) == QR_Reachable) {
                 return true;
             }
         }
@@ -133,15 +169,15 @@ namespace lcr {
         secondaryQuery.source = source;
         secondaryQuery.target = target;
 
-        if (secondaryIndex->queryOnce(secondaryQuery) == QR_NotReachable) {
+        if (secondaryIndex->queryOnce(secondaryQuery, context) == QR_NotReachable) {
             return false;
         }
 
-        return defaultStrategy(query, included, primaryQuery, secondaryQuery);
+        return defaultStrategy(query, included, primaryQuery, secondaryQuery, context);
     }
 
     bool ScaleHarness::defaultStrategy(const LCRQuery &query, bool isPrimaryPossible, const LCRQuery &primaryQuery,
-                                       const LCRQuery &secondaryQuery) {
+                                       const LCRQuery &secondaryQuery, QueryContext &context) const {
         auto &graph = getGraph();
 
         auto source = query.source;
@@ -149,11 +185,14 @@ namespace lcr {
         auto &labels = query.labelSet;
 
         // Default to BFS.
-        boost::dynamic_bitset<> visited(graph.getVertexCount());
-        std::deque<Vertex> queue;
+        auto scratch = context.acquire();
+        scratch->prepareVisited(graph.getVertexCount());
+
+        auto &visited = scratch->visited;
+        auto &queue = scratch->queue;
         queue.emplace_back(source);
 
-        visited[source] = true;
+        visited.set(source);
 
         while (!queue.empty()) {
             source = queue.front();
@@ -162,11 +201,11 @@ namespace lcr {
             auto it = graph.getConnected(source);
 
             if(landmarked[source]) {
-                if (secondaryIndex->queryOnceRecursive(secondaryQuery) == QR_NotReachable) {
+                if (secondaryIndex->queryOnceRecursive(secondaryQuery, context) == QR_NotReachable) {
                     continue;
                 }
 
-                if (isPrimaryPossible && primaryIndex->queryOnceRecursive(primaryQuery) == QR_Reachable) {
+                if (isPrimaryPossible && primaryIndex->queryOnceRecursive(primaryQuery, context) == QR_Reachable) {
                     return true;
                 }
             }
@@ -183,7 +222,7 @@ namespace lcr {
                 }
 
                 if (!visited[edge.target]) {
-                    visited[edge.target] = true;
+                    visited.set(edge.target);
                     queue.emplace_back(edge.target);
                 }
             }
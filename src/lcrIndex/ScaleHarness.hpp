@@ -31,13 +31,21 @@ namespace lcr {
         }
 
         void train() override;
-        bool query(const LCRQuery &query) override;
+        bool query(const LCRQuery &query, QueryContext &context) const override;
 
         [[nodiscard]] size_t indexSize() const override;
         [[nodiscard]] const std::string &getName() const override { return indexName; }
 
+        void serialize(IndexWriter &writer) const override;
+        void deserialize(IndexReader &reader) override;
+
     private:
+        /**
+         * @brief derives the label mappings and graphs of the nested indexes, and builds the indexes on those graphs.
+         */
+        void buildIndexes(const std::function<void(Index &)> &build);
+
         bool defaultStrategy(const LCRQuery &query, bool isPrimaryPossible, const LCRQuery &primaryQuery,
-                             const LCRQuery &secondaryQuery);
+                             const LCRQuery &secondaryQuery, QueryContext &context) const;
     };
 }
@@ -9,6 +9,9 @@
 
 static Timer timer;
 
+// Extension of the written query files, which selects the query writer.
+static std::string queryFileExtension = ".csv";
+
 std::unique_ptr<LabeledEdgeGraph> readGraph(const std::string &graphFileIn) {
     auto graphReader = GraphReader::createGraphReader();
     timer.begin("read graph");
@@ -46,7 +49,7 @@ void writeQueries(const std::string &graphFileName, const std::vector<LCRQuery>
     auto pathAndNameWithoutExtension = graphFileName.substr(0, lastSlash);
 
     timer.begin("writing queries");
-    queryWriter->writeLabeledQueries(queries, pathAndNameWithoutExtension + ".queries-lcr.csv");
+    queryWriter->writeLabeledQueries(queries, pathAndNameWithoutExtension + ".queries-lcr" + queryFileExtension);
     timer.end();
 }
 
@@ -65,12 +68,14 @@ void writeQueries(const std::string &graphFileName,
 
         if (!falseQueries.empty()) {
             queryWriter->writeLabeledQueries(falseQueries,
-                                             pathAndNameWithoutExtension + ".queries-lcr." + pair.first + ".false.csv");
+                                             pathAndNameWithoutExtension + ".queries-lcr." + pair.first + ".false" +
+                                                 queryFileExtension);
         }
 
         if (!trueQueries.empty()) {
             queryWriter->writeLabeledQueries(trueQueries,
-                                             pathAndNameWithoutExtension + ".queries-lcr." + pair.first + ".true.csv");
+                                             pathAndNameWithoutExtension + ".queries-lcr." + pair.first + ".true" +
+                                                 queryFileExtension);
         }
     }
 
@@ -97,12 +102,15 @@ mergeQueries(LabeledEdgeGraph &labeledEdgeGraph, std::unordered_map<std::string,
         index->setGraph(&labeledEdgeGraph);
         index->train();
 
+        // One query context per thread, such that the index can be queried concurrently.
+        std::vector<QueryContext> contexts(threadPool.getNumThreads());
+
         for (auto &pair : queries) {
             for (auto i = 0u; i < pair.second.size(); i++) {
                 auto &query = pair.second[i];
 
-                workGroup.emplace_back([&queryResults, &index, &pair, i, &query](uint32_t id) {
-                    queryResults.at(pair.first)[i] = index->query(query) ? 1u : 0u;
+                workGroup.emplace_back([&queryResults, &index, &contexts, &pair, i, &query](uint32_t id) {
+                    queryResults.at(pair.first)[i] = index->query(query, contexts[id]) ? 1u : 0u;
                 });
             }
         }
@@ -143,12 +151,15 @@ evaluateQueries(LabeledEdgeGraph &labeledEdgeGraph, std::unordered_map<std::stri
     index->setGraph(&labeledEdgeGraph);
     index->train();
 
+    // One query context per thread, such that the index can be queried concurrently.
+    std::vector<QueryContext> contexts(threadPool.getNumThreads());
+
     for (auto &pair : queries) {
         for (auto i = 0u; i < pair.second.size(); i++) {
             auto &query = pair.second[i];
 
-            workGroup.emplace_back([&queryResults, &index, &pair, i, &query](uint32_t id) {
-                queryResults.at(pair.first)[i] = index->query(query) ? 1u : 0u;
+            workGroup.emplace_back([&queryResults, &index, &contexts, &pair, i, &query](uint32_t id) {
+                queryResults.at(pair.first)[i] = index->query(query, contexts[id]) ? 1u : 0u;
             });
         }
     }
@@ -237,8 +248,8 @@ std::vector<uint32_t> createLabelGenModes(const LabeledEdgeGraph &graph) {
 
 int main(int argc, char **argv) {
     if (argc < 1) {
-        std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--allInOne] "
-                     "[--splitRandomFromConnected] --randomQueries [count] --connectedQueries [count]" << std::endl;
+        std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--allInOne] [--splitRandomFromConnected] "
+                     "[--binaryQueries] --randomQueries [count] --connectedQueries [count]" << std::endl;
         return 1;
     }
 
@@ -261,6 +272,8 @@ int main(int argc, char **argv) {
                 allInOne = true;
             } else if (content == "--splitRandomFromConnected") {
                 splitRandomFromConnected = true;
+            } else if (content == "--binaryQueries") {
+                queryFileExtension = ".lcrq";
             } else if (content == "--graphFile") {
                 if (i + 1 >= argc) {
                     std::cerr << "expected graph file name after --graphFile" << std::fatal;
@@ -287,8 +300,8 @@ int main(int argc, char **argv) {
                 connectedQueriesCount = std::stoul(next);
             } else {
                 std::cerr << "unrecognized switch: " << content << std::endl;
-                std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--allInOne] "
-                             "[--splitRandomFromConnected] --randomQueries [count] --connectedQueries [count]" << std::endl;
+                std::cerr << "Usage: --graphFile [graphFileIn] [--printStats] [--allInOne] [--splitRandomFromConnected] "
+                             "[--binaryQueries] --randomQueries [count] --connectedQueries [count]" << std::endl;
             }
         }
     }
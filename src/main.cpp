@@ -9,7 +9,9 @@ int main(int argc, char **argv) {
     if (argc <= 1) {
         std::cerr << "Usage: [reach|lcr] --graphFile [graphFile] --queryFile [queriesFile]"
                      " --index [indexName] --indexParams [parameterList]"
-                     " [--control] --timeLimit [timeLimitInSeconds] --memoryLimit [memoryLimitInMBs]" << std::endl;
+                     " [--control] [--batch] [--fallback bfs|bibfs] [--saveIndex file] [--loadIndex file]"
+                     " --timeLimit [timeLimitInSeconds]"
+                     " --memoryLimit [memoryLimitInMBs]" << std::endl;
         return 1;
     }
 
@@ -139,7 +141,11 @@ void readArgsAndRun(int argc, char *const *argv, bool doReachQueries) {
     std::string graphFile;
     std::vector<std::string> queryFiles;
     bool control = false;
+    bool batch = false;
+    lcr::FallbackStrategy fallback = lcr::FS_BFS;
     std::vector<std::string> indexParams;
+    std::string saveIndexFile;
+    std::string loadIndexFile;
 
     int64_t timeLimit = -1;
     int64_t memoryLimit = -1;
@@ -206,6 +212,34 @@ void readArgsAndRun(int argc, char *const *argv, bool doReachQueries) {
                 memoryLimit = std::stoll(next);
             } else if (content == "--control") {
                 control = true;
+            } else if (content == "--batch") {
+                batch = true;
+            } else if (content == "--fallback") {
+                if (i + 1 >= argc) {
+                    std::cerr << "expected bfs or bibfs after --fallback" << std::fatal;
+                }
+
+                std::string next(argv[++i]);
+
+                if (next == "bfs") {
+                    fallback = lcr::FS_BFS;
+                } else if (next == "bibfs") {
+                    fallback = lcr::FS_BiBFS;
+                } else {
+                    std::cerr << "expected bfs or bibfs after --fallback" << std::fatal;
+                }
+            } else if (content == "--saveIndex") {
+                if (i + 1 >= argc) {
+                    std::cerr << "expected index file name after --saveIndex" << std::fatal;
+                }
+
+                saveIndexFile = argv[++i];
+            } else if (content == "--loadIndex") {
+                if (i + 1 >= argc) {
+                    std::cerr << "expected index file name after --loadIndex" << std::fatal;
+                }
+
+                loadIndexFile = argv[++i];
             } else {
                 std::cerr << "unrecognized switch: " << content << std::fatal;
             }
@@ -262,7 +296,17 @@ void readArgsAndRun(int argc, char *const *argv, bool doReachQueries) {
         }
 
         runner.setLimit(std::move(multiLimit));
-        runner.addIndex(lcr::Index::create(index, indexParams));
+        runner.setBatchMode(batch);
+        runner.setSaveIndexFile(saveIndexFile);
+        runner.setLoadIndexFile(loadIndexFile);
+        auto lcrIndex = lcr::Index::create(index, indexParams);
+        lcrIndex->setFallbackStrategy(fallback);
+
+        if (memoryLimit > 0) {
+            lcrIndex->setMemoryBudget(size_t(memoryLimit) * 1000ull * 1000ull);
+        }
+
+        runner.addIndex(std::move(lcrIndex));
         runner.run(graphFile, queryFiles);
     }
 }
@@ -1,6 +1,7 @@
 #include "BFLIndex.hpp"
 
-bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex target) {
+bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex target,
+                           EpochVisitedSet &visited) const {
     auto sourceInterval = intervalLabels[source];
     auto targetInterval = intervalLabels[target];
 
@@ -18,11 +19,11 @@ bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex
     auto &targetEdgesIn = componentGraph.getReverseConnected(target);
     auto &targetEdgesOut = componentGraph.getConnected(target);
 
-    auto &sourceLabelIn = incomingLabels[source];
-    auto &sourceLabelOut = outgoingLabels[source];
+    auto *sourceLabelIn = incomingLabels[source];
+    auto *sourceLabelOut = outgoingLabels[source];
 
-    auto &targetLabelIn = incomingLabels[target];
-    auto &targetLabelOut = outgoingLabels[target];
+    auto *targetLabelIn = incomingLabels[target];
+    auto *targetLabelOut = outgoingLabels[target];
 
     // If nothing leads to target, then it is not reachable.
     if (targetEdgesIn.empty()) {
@@ -40,11 +41,9 @@ bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the outgoing target labels are a subset of the outgoing source labels.
-            if ((sourceLabelOut[i] & targetLabelOut[i]) != targetLabelOut[i]) {
-                return false;
-            }
+        // Check if the outgoing target labels are a subset of the outgoing source labels.
+        if (!BloomLabels::isSubset(targetLabelOut, sourceLabelOut, labelSize)) {
+            return false;
         }
     }
 
@@ -54,22 +53,18 @@ bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the incoming source labels are a subset of the incoming target labels.
-            if ((sourceLabelIn[i] & targetLabelIn[i]) != sourceLabelIn[i]) {
-                return false;
-            }
+        // Check if the incoming source labels are a subset of the incoming target labels.
+        if (!BloomLabels::isSubset(sourceLabelIn, targetLabelIn, labelSize)) {
+            return false;
         }
     }
 
     for (auto adjVertex : componentGraph.getConnected(source)) {
-        if (visited[adjVertex] == curVisited) {
+        if (!visited.insert(adjVertex)) {
             continue;
         }
 
-        visited[adjVertex] = curVisited;
-
-        if (isReachable(componentGraph, adjVertex, target)) {
+        if (isReachable(componentGraph, adjVertex, target, visited)) {
             return true;
         }
     }
@@ -77,7 +72,7 @@ bool BFLIndex::isReachable(const DiGraph &componentGraph, Vertex source, Vertex
     return false;
 }
 
-bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Vertex target) {
+bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Vertex target) const {
     auto sourceInterval = intervalLabels[source];
     auto targetInterval = intervalLabels[target];
 
@@ -92,11 +87,11 @@ bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Ver
     auto &sourceEdgesIn = componentGraph.getReverseConnected(source);
     auto &targetEdgesOut = componentGraph.getConnected(target);
 
-    auto &sourceLabelIn = incomingLabels[source];
-    auto &sourceLabelOut = outgoingLabels[source];
+    auto *sourceLabelIn = incomingLabels[source];
+    auto *sourceLabelOut = outgoingLabels[source];
 
-    auto &targetLabelIn = incomingLabels[target];
-    auto &targetLabelOut = outgoingLabels[target];
+    auto *targetLabelIn = incomingLabels[target];
+    auto *targetLabelOut = outgoingLabels[target];
 
     if (targetEdgesOut.empty()) {
         // Check if the outgoing target labels are a subset of the outgoing source labels.
@@ -104,11 +99,9 @@ bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Ver
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the outgoing target labels are a subset of the outgoing source labels.
-            if ((sourceLabelOut[i] & targetLabelOut[i]) != targetLabelOut[i]) {
-                return false;
-            }
+        // Check if the outgoing target labels are a subset of the outgoing source labels.
+        if (!BloomLabels::isSubset(targetLabelOut, sourceLabelOut, labelSize)) {
+            return false;
         }
     }
 
@@ -118,11 +111,9 @@ bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Ver
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the incoming source labels are a subset of the incoming target labels.
-            if ((sourceLabelIn[i] & targetLabelIn[i]) != sourceLabelIn[i]) {
-                return false;
-            }
+        // Check if the incoming source labels are a subset of the incoming target labels.
+        if (!BloomLabels::isSubset(sourceLabelIn, targetLabelIn, labelSize)) {
+            return false;
         }
     }
 
@@ -132,7 +123,6 @@ bool BFLIndex::isReachableOnce(const DiGraph &componentGraph, Vertex source, Ver
 void BFLIndex::reverseDFS(Vertex target) {
     // Mark target visited
     visited[target] = curVisited;
-    incomingLabels[target].resize(labelSize);
 
     auto &incomingVertices = getGraph().getReverseConnected(target);
 
@@ -142,10 +132,6 @@ void BFLIndex::reverseDFS(Vertex target) {
         return;
     }
 
-    for (auto i = 0u; i < labelSize; i++) {
-        incomingLabels[target][i] = 0;
-    }
-
     for (auto source : incomingVertices) {
         if (visited[source] != curVisited) {
             reverseDFS(source);
@@ -173,7 +159,6 @@ void BFLIndex::forwardDFS(Vertex source, uint32_t &intervalMarker) {
     // Mark target visited
     visited[source] = curVisited;
     intervalLabels[source].first = intervalMarker++;
-    outgoingLabels[source].resize(labelSize);
 
     auto &outgoingVertices = getGraph().getConnected(source);
 
@@ -184,10 +169,6 @@ void BFLIndex::forwardDFS(Vertex source, uint32_t &intervalMarker) {
         return;
     }
 
-    for (auto i = 0u; i < labelSize; i++) {
-        outgoingLabels[source][i] = 0;
-    }
-
     for (auto target : outgoingVertices) {
         if (visited[target] != curVisited) {
             forwardDFS(target, intervalMarker);
@@ -216,8 +197,8 @@ void BFLIndex::train() {
     auto &componentGraph = getGraph();
     maxCounter = componentGraph.getVertexCount() / intervalCount;
 
-    incomingLabels.resize(componentGraph.getVertexCount());
-    outgoingLabels.resize(componentGraph.getVertexCount());
+    incomingLabels.resize(componentGraph.getVertexCount(), labelSize);
+    outgoingLabels.resize(componentGraph.getVertexCount(), labelSize);
     intervalLabels.resize(componentGraph.getVertexCount());
 
     visited.resize(componentGraph.getVertexCount());
@@ -245,7 +226,7 @@ void BFLIndex::train() {
     }
 }
 
-bool BFLIndex::query(const ReachQuery &query) {
+bool BFLIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto &sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -260,11 +241,13 @@ bool BFLIndex::query(const ReachQuery &query) {
         return false;
     }
 
-    curVisited++;
-    return isReachable(getGraph(), sourceComponent, targetComponent);
+    auto scratch = context.acquire();
+    scratch->prepareVisited(getGraph().getVertexCount());
+
+    return isReachable(getGraph(), sourceComponent, targetComponent, scratch->visited);
 }
 
-bool BFLIndex::queryOnce(const ReachQuery &query) {
+bool BFLIndex::queryOnce(const ReachQuery &query, QueryContext &context) const {
     auto &sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -283,16 +266,22 @@ bool BFLIndex::queryOnce(const ReachQuery &query) {
 }
 
 size_t BFLIndex::indexSize() const {
-    size_t size = 0;
+    size_t size = incomingLabels.sizeInBytes() + outgoingLabels.sizeInBytes();
+    size += intervalLabels.size() * sizeof(std::pair<uint32_t, uint32_t>);
 
-    for (auto i = 0u; i < getGraph().getVertexCount(); i++) {
-        size += incomingLabels[i].size() * sizeof(uint32_t);
-        size += outgoingLabels[i].size() * sizeof(uint32_t);
+    return size;
+}
 
-        size += sizeof(std::pair<uint32_t, uint32_t>);
-    }
+void BFLIndex::serialize(IndexWriter &writer) const {
+    writer.write(incomingLabels);
+    writer.write(outgoingLabels);
+    writer.write(intervalLabels);
+}
 
-    return size;
+void BFLIndex::deserialize(IndexReader &reader) {
+    reader.read(incomingLabels);
+    reader.read(outgoingLabels);
+    reader.read(intervalLabels);
 }
 
 uint32_t BFLIndex::hashGet() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReachabilityIndex.hpp"
+#include "dataStructures/BloomLabels.hpp"
 
 class BFLIndex : public ReachabilityIndex {
 private:
@@ -10,8 +11,8 @@ private:
     uint32_t labelBitSize;
     uint32_t intervalCount;
 
-    std::vector<std::vector<uint32_t>> incomingLabels;                   // L_In
-    std::vector<std::vector<uint32_t>> outgoingLabels;                   // L_Out
+    BloomLabels incomingLabels;                                          // L_In
+    BloomLabels outgoingLabels;                                          // L_Out
 
     std::vector<std::pair<uint32_t, uint32_t>> intervalLabels;              // L_int = [L_dis, L_fin]
 
@@ -24,6 +25,7 @@ private:
     uint32_t intervalCounter;
     uint32_t maxCounter;
 
+    // Visited state used during training, queries use the visited set of the query context.
     uint32_t curVisited;
     std::vector<uint32_t> visited;
 
@@ -40,18 +42,21 @@ public:
     }
 
     void train() override;
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
     [[nodiscard]] size_t indexSize() const override;
 
-    bool queryOnce(const ReachQuery &query) override;
+    void serialize(IndexWriter &writer) const override;
+    void deserialize(IndexReader &reader) override;
+
+    bool queryOnce(const ReachQuery &query, QueryContext &context) const override;
 
     [[nodiscard]] const std::string &getName() const override {
         return indexName;
     }
 
 private:
-    bool isReachable(const DiGraph &componentGraph, Vertex source, Vertex target);
-    bool isReachableOnce(const DiGraph &componentGraph, Vertex source, Vertex target);
+    bool isReachable(const DiGraph &componentGraph, Vertex source, Vertex target, EpochVisitedSet &visited) const;
+    bool isReachableOnce(const DiGraph &componentGraph, Vertex source, Vertex target) const;
 
     void reverseDFS(Vertex target);
     void forwardDFS(Vertex source, uint32_t &intervalMarker);
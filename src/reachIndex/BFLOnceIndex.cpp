@@ -1,6 +1,6 @@
 #include "BFLOnceIndex.hpp"
 
-bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) {
+bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) const {
     auto sourceInterval = intervalLabels[source];
     auto targetInterval = intervalLabels[target];
 
@@ -12,11 +12,11 @@ bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) {
         return true;
     }
 
-    auto &sourceLabelIn = incomingLabels[source];
-    auto &sourceLabelOut = outgoingLabels[source];
+    auto *sourceLabelIn = incomingLabels[source];
+    auto *sourceLabelOut = outgoingLabels[source];
 
-    auto &targetLabelIn = incomingLabels[target];
-    auto &targetLabelOut = outgoingLabels[target];
+    auto *targetLabelIn = incomingLabels[target];
+    auto *targetLabelOut = outgoingLabels[target];
 
     // If nothing leads to target, then it is not reachable.
     if (inEmpty[target]) {
@@ -34,11 +34,9 @@ bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) {
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the outgoing target labels are a subset of the outgoing source labels.
-            if ((sourceLabelOut[i] & targetLabelOut[i]) != targetLabelOut[i]) {
-                return false;
-            }
+        // Check if the outgoing target labels are a subset of the outgoing source labels.
+        if (!BloomLabels::isSubset(targetLabelOut, sourceLabelOut, labelSize)) {
+            return false;
         }
     }
 
@@ -48,11 +46,9 @@ bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) {
             return false;
         }
     } else {
-        for (auto i = 0u; i < labelSize; i++) {
-            // Check if the incoming source labels are a subset of the incoming target labels.
-            if ((sourceLabelIn[i] & targetLabelIn[i]) != sourceLabelIn[i]) {
-                return false;
-            }
+        // Check if the incoming source labels are a subset of the incoming target labels.
+        if (!BloomLabels::isSubset(sourceLabelIn, targetLabelIn, labelSize)) {
+            return false;
         }
     }
 
@@ -62,7 +58,6 @@ bool BFLOnceIndex::isReachableOnce(Vertex source, Vertex target) {
 void BFLOnceIndex::reverseDFS(std::vector<uint32_t> &visited, Vertex target, uint32_t curVisited) {
     // Mark target visited
     visited[target] = curVisited;
-    incomingLabels[target].resize(labelSize);
 
     auto &incomingVertices = getGraph().getReverseConnected(target);
 
@@ -72,10 +67,6 @@ void BFLOnceIndex::reverseDFS(std::vector<uint32_t> &visited, Vertex target, uin
         return;
     }
 
-    for (auto i = 0u; i < labelSize; i++) {
-        incomingLabels[target][i] = 0;
-    }
-
     for (auto source : incomingVertices) {
         if (visited[source] != curVisited) {
             reverseDFS(visited, source, curVisited);
@@ -104,7 +95,6 @@ BFLOnceIndex::forwardDFS(std::vector<uint32_t> &visited, Vertex source, uint32_t
     // Mark target visited
     visited[source] = curVisited;
     intervalLabels[source].first = intervalMarker++;
-    outgoingLabels[source].resize(labelSize);
 
     auto &outgoingVertices = getGraph().getConnected(source);
 
@@ -115,10 +105,6 @@ BFLOnceIndex::forwardDFS(std::vector<uint32_t> &visited, Vertex source, uint32_t
         return;
     }
 
-    for (auto i = 0u; i < labelSize; i++) {
-        outgoingLabels[source][i] = 0;
-    }
-
     for (auto target : outgoingVertices) {
         if (visited[target] != curVisited) {
             forwardDFS(visited, target, intervalMarker, curVisited);
@@ -147,8 +133,8 @@ void BFLOnceIndex::train() {
     auto &componentGraph = getGraph();
     maxCounter = componentGraph.getVertexCount() / intervalCount;
 
-    incomingLabels.resize(componentGraph.getVertexCount());
-    outgoingLabels.resize(componentGraph.getVertexCount());
+    incomingLabels.resize(componentGraph.getVertexCount(), labelSize);
+    outgoingLabels.resize(componentGraph.getVertexCount(), labelSize);
     intervalLabels.resize(componentGraph.getVertexCount());
 
     inEmpty.resize(componentGraph.getVertexCount());
@@ -181,12 +167,12 @@ void BFLOnceIndex::train() {
     }
 }
 
-bool BFLOnceIndex::query(const ReachQuery &query) {
+bool BFLOnceIndex::query(const ReachQuery &query, QueryContext &context) const {
     std::cout << "Not allowed to use query on BFL Once index" << std::fatal;
     return false;
 }
 
-bool BFLOnceIndex::queryOnce(const ReachQuery &query) {
+bool BFLOnceIndex::queryOnce(const ReachQuery &query, QueryContext &context) const {
     auto &sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -205,18 +191,29 @@ bool BFLOnceIndex::queryOnce(const ReachQuery &query) {
 }
 
 size_t BFLOnceIndex::indexSize() const {
-    size_t size = 0;
+    size_t size = incomingLabels.sizeInBytes() + outgoingLabels.sizeInBytes();
+    size += intervalLabels.size() * sizeof(std::pair<uint32_t, uint32_t>);
 
-    for (auto i = 0u; i < incomingLabels.size(); i++) {
-        size += incomingLabels[i].size() * sizeof(uint32_t);
-        size += outgoingLabels[i].size() * sizeof(uint32_t);
+    // The empty flags of a vertex.
+    size += 2 * intervalLabels.size();
 
-        size += 2;
+    return size;
+}
 
-        size += sizeof(std::pair<uint32_t, uint32_t>);
-    }
+void BFLOnceIndex::serialize(IndexWriter &writer) const {
+    writer.write(incomingLabels);
+    writer.write(outgoingLabels);
+    writer.write(outEmpty);
+    writer.write(inEmpty);
+    writer.write(intervalLabels);
+}
 
-    return size;
+void BFLOnceIndex::deserialize(IndexReader &reader) {
+    reader.read(incomingLabels);
+    reader.read(outgoingLabels);
+    reader.read(outEmpty);
+    reader.read(inEmpty);
+    reader.read(intervalLabels);
 }
 
 uint32_t BFLOnceIndex::hashGet() {
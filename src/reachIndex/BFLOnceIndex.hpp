@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ReachabilityIndex.hpp"
+#include "dataStructures/BloomLabels.hpp"
 
 class BFLOnceIndex : public ReachabilityIndex {
 private:
@@ -10,8 +11,8 @@ private:
     uint32_t labelBitSize;
     uint32_t intervalCount;
 
-    std::vector<std::vector<uint32_t>> incomingLabels;                   // L_In
-    std::vector<std::vector<uint32_t>> outgoingLabels;                   // L_Out
+    BloomLabels incomingLabels;                                          // L_In
+    BloomLabels outgoingLabels;                                          // L_Out
 
     boost::dynamic_bitset<> outEmpty;
     boost::dynamic_bitset<> inEmpty;
@@ -41,17 +42,20 @@ public:
     }
 
     void train() override;
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
     [[nodiscard]] size_t indexSize() const override;
 
-    bool queryOnce(const ReachQuery &query) override;
+    void serialize(IndexWriter &writer) const override;
+    void deserialize(IndexReader &reader) override;
+
+    bool queryOnce(const ReachQuery &query, QueryContext &context) const override;
 
     [[nodiscard]] const std::string &getName() const override {
         return indexName;
     }
 
 private:
-    bool isReachableOnce(Vertex source, Vertex target);
+    [[nodiscard]] bool isReachableOnce(Vertex source, Vertex target) const;
 
     void reverseDFS(std::vector<uint32_t> &visited, Vertex target, uint32_t curVisited);
     void forwardDFS(std::vector<uint32_t> &visited, Vertex source, uint32_t &intervalMarker, uint32_t curVisited);
@@ -1,6 +1,6 @@
 #include "BFSIndex.hpp"
 
-bool BFSIndex::query(const ReachQuery &query) {
+bool BFSIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -8,10 +8,13 @@ private:
 
 public:
     void train() override { }
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
 
     [[nodiscard]] size_t indexSize() const override { return 0; }
 
+    void serialize(IndexWriter &writer) const override { }
+    void deserialize(IndexReader &reader) override { }
+
     [[nodiscard]] const std::string &getName() const override {
         return indexName;
     }
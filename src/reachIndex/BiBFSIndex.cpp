@@ -1,6 +1,6 @@
 #include "BiBFSIndex.hpp"
 
-bool BiBFSIndex::query(const ReachQuery& query) {
+bool BiBFSIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -1,6 +1,6 @@
 #include "DFSIndex.hpp"
 
-bool DFSIndex::query(const ReachQuery &query) {
+bool DFSIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -1,16 +1,8 @@
 #include "HybridBFSIndex.hpp"
 
-static std::vector<uint32_t> frontiers;
+void HybridBFSIndex::train() { }
 
-static uint32_t baseStep = 0;
-static uint32_t previousStep = 0;
-static uint32_t currentStep = 0;
-
-void HybridBFSIndex::train() {
-    frontiers.resize(getGraph().getVertexCount());
-}
-
-bool HybridBFSIndex::query(const ReachQuery &query) {
+bool HybridBFSIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto &graph = getGraph();
     auto& sccGraph = getSCCGraph();
 
@@ -34,22 +26,22 @@ bool HybridBFSIndex::query(const ReachQuery &query) {
     uint32_t edgesInFrontier = graph.getConnected(source).size();
     uint32_t unexploredEdges = graph.getEdgeCount() - edgesInFrontier;
 
-    previousStep++;
-    currentStep++;
+    // Every level of the search is told apart in the visited set, there are at most vertex count + 1 levels.
+    auto scratch = context.acquire();
+    auto &visited = scratch->visited;
 
-    baseStep = currentStep - 1;
-    frontiers[source] = currentStep;
+    visited.reset(totalNodes, totalNodes + 1);
+    visited.set(source);
 
     bool shouldDoBottomUp = false;
 
     while (nodesInFrontier != 0) {
-        currentStep++;
+        visited.nextLevel();
         nodesInFrontier = 0;
         edgesInFrontier = 0;
 
         if (shouldDoBottomUp) {
-            if (bottomUp(graph, target, nodesInFrontier, edgesInFrontier)) {
-                previousStep++;
+            if (bottomUp(graph, target, visited, nodesInFrontier, edgesInFrontier)) {
                 return true;
             }
 
@@ -60,8 +52,7 @@ bool HybridBFSIndex::query(const ReachQuery &query) {
                 shouldDoBottomUp = false;
             }
         } else {
-            if (topDown(graph, target, nodesInFrontier, edgesInFrontier)) {
-                previousStep++;
+            if (topDown(graph, target, visited, nodesInFrontier, edgesInFrontier)) {
                 return true;
             }
 
@@ -72,21 +63,22 @@ bool HybridBFSIndex::query(const ReachQuery &query) {
                 shouldDoBottomUp = true;
             }
         }
-
-        previousStep++;
     }
 
     return false;
 }
 
-bool HybridBFSIndex::bottomUp(const DiGraph &graph, Vertex target, uint32_t &nodesInFrontier, uint32_t &edgesInFrontier) {
+bool HybridBFSIndex::bottomUp(const DiGraph &graph, Vertex target, EpochVisitedSet &visited,
+                              uint32_t &nodesInFrontier, uint32_t &edgesInFrontier) {
+    auto previousLevel = visited.currentLevel() - 1;
+
     for (auto vertex = 0; vertex < graph.getVertexCount(); vertex++) {
-        if (frontiers[vertex] > baseStep) {
+        if (visited[vertex]) {
             continue;
         }
 
         for (auto &previous : graph.getReverseConnected(vertex)) {
-            if (frontiers[previous] != previousStep) {
+            if (visited.level(previous) != previousLevel) {
                 continue;
             }
 
@@ -94,7 +86,7 @@ bool HybridBFSIndex::bottomUp(const DiGraph &graph, Vertex target, uint32_t &nod
                 return true;
             }
 
-            frontiers[vertex] = currentStep;
+            visited.set(vertex);
             nodesInFrontier++;
             edgesInFrontier += graph.getConnected(vertex).size();
             break;
@@ -104,14 +96,17 @@ bool HybridBFSIndex::bottomUp(const DiGraph &graph, Vertex target, uint32_t &nod
     return false;
 }
 
-bool HybridBFSIndex::topDown(const DiGraph &graph, Vertex target, uint32_t &nodesInFrontier, uint32_t &edgesInFrontier) {
+bool HybridBFSIndex::topDown(const DiGraph &graph, Vertex target, EpochVisitedSet &visited,
+                             uint32_t &nodesInFrontier, uint32_t &edgesInFrontier) {
+    auto previousLevel = visited.currentLevel() - 1;
+
     for (auto vertex = 0; vertex < graph.getVertexCount(); vertex++) {
-        if (frontiers[vertex] != previousStep) {
+        if (visited.level(vertex) != previousLevel) {
             continue;
         }
 
         for (auto &next : graph.getConnected(vertex)) {
-            if (frontiers[next] > baseStep) {
+            if (!visited.insert(next)) {
                 continue;
             }
 
@@ -119,7 +114,6 @@ bool HybridBFSIndex::topDown(const DiGraph &graph, Vertex target, uint32_t &node
                 return true;
             }
 
-            frontiers[next] = currentStep;
             nodesInFrontier++;
             edgesInFrontier += graph.getConnected(next).size();
         }
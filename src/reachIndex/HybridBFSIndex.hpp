@@ -8,15 +8,23 @@ private:
 
 public:
     void train() override;
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
 
     [[nodiscard]] size_t indexSize() const override { return 0; }
 
+    void serialize(IndexWriter &writer) const override { }
+    void deserialize(IndexReader &reader) override { }
+
     [[nodiscard]] const std::string &getName() const override {
         return indexName;
     }
 
 private:
-    static bool bottomUp(const DiGraph &graph, Vertex target, uint32_t &nodesInFrontier, uint32_t &edgesInFrontier);
-    static bool topDown(const DiGraph &graph, Vertex target, uint32_t &nodesInFrontier, uint32_t &edgesInFrontier);
+    /**
+     * @brief visits the vertices that follow the previous level of visited, at its current level.
+     */
+    static bool bottomUp(const DiGraph &graph, Vertex target, EpochVisitedSet &visited, uint32_t &nodesInFrontier,
+                         uint32_t &edgesInFrontier);
+    static bool topDown(const DiGraph &graph, Vertex target, EpochVisitedSet &visited, uint32_t &nodesInFrontier,
+                        uint32_t &edgesInFrontier);
 };
@@ -1,6 +1,25 @@
 #include "PLLIndex.hpp"
+#include "threading/ThreadPool.hpp"
+
+bool PLLIndex::isBitParallelReachable(Vertex source, Vertex target) const {
+    auto *outgoingMasks = bitParallelTo.data() + size_t(source) * bitParallelRoots;
+    auto *incomingMasks = bitParallelFrom.data() + size_t(target) * bitParallelRoots;
+
+    for (auto i = 0u; i < bitParallelRoots; i++) {
+        // Some vertex of the root is reachable from source and reaches target.
+        if ((outgoingMasks[i] & incomingMasks[i]) != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool PLLIndex::isReachable(Vertex sourceComponent, Vertex targetComponent) const {
+    if (isBitParallelReachable(sourceComponent, targetComponent)) {
+        return true;
+    }
 
-bool PLLIndex::isReachable(Vertex sourceComponent, Vertex targetComponent) {
     auto &outgoingLabels = reachTo[sourceComponent];
     auto &incomingLabels = reachFrom[targetComponent];
 
@@ -30,7 +49,11 @@ bool PLLIndex::isReachable(Vertex sourceComponent, Vertex targetComponent) {
     return false;
 }
 
-void PLLIndex::prunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &queue, uint32_t label, Vertex landmark) {
+void PLLIndex::prunedBFS(SearchState &state, const std::vector<uint32_t> &rank, Vertex landmark,
+                         std::vector<Vertex> &labeled) const {
+    auto &visited = state.visited;
+    auto &queue = state.queue;
+
     auto queueStartPtr = 0u;
     auto queueEndPtr = 0u;
 
@@ -45,10 +68,11 @@ void PLLIndex::prunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &
             continue;
         }
 
-        reachFrom[source].push_back(label);
+        labeled.push_back(source);
 
         for (auto vertex : getGraph().getConnected(source)) {
-            if (!visited[vertex]) {
+            // Paths through earlier landmarks are covered by their labels.
+            if (!visited[vertex] && rank[vertex] > rank[landmark]) {
                 visited[vertex] = true;
                 queue[queueEndPtr++] = vertex;
             }
@@ -61,7 +85,11 @@ void PLLIndex::prunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &
     }
 }
 
-void PLLIndex::reversePrunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &queue, uint32_t label, Vertex landmark) {
+void PLLIndex::reversePrunedBFS(SearchState &state, const std::vector<uint32_t> &rank, Vertex landmark,
+                                std::vector<Vertex> &labeled) const {
+    auto &visited = state.visited;
+    auto &queue = state.queue;
+
     auto queueStartPtr = 0u;
     auto queueEndPtr = 0u;
 
@@ -76,10 +104,10 @@ void PLLIndex::reversePrunedBFS(boost::dynamic_bitset<> &visited, std::vector<Ve
             continue;
         }
 
-        reachTo[target].push_back(label);
+        labeled.push_back(target);
 
         for (auto vertex : getGraph().getReverseConnected(target)) {
-            if (!visited[vertex]) {
+            if (!visited[vertex] && rank[vertex] > rank[landmark]) {
                 visited[vertex] = true;
                 queue[queueEndPtr++] = vertex;
             }
@@ -92,33 +120,221 @@ void PLLIndex::reversePrunedBFS(boost::dynamic_bitset<> &visited, std::vector<Ve
     }
 }
 
+uint32_t PLLIndex::batchSize(uint32_t label) {
+    return std::clamp(label / 32, 1u, 4096u);
+}
+
+std::vector<std::vector<Vertex>> PLLIndex::selectBitParallelRoots(const std::vector<Vertex> &order) const {
+    auto &componentGraph = getGraph();
+
+    std::vector<uint32_t> rank(componentGraph.getVertexCount());
+
+    for (auto i = 0u; i < order.size(); i++) {
+        rank[order[i]] = i;
+    }
+
+    std::vector<std::vector<Vertex>> roots;
+    boost::dynamic_bitset<> used(componentGraph.getVertexCount());
+    std::vector<Vertex> neighbours;
+
+    for (auto next = 0u; next < order.size() && roots.size() < bitParallelRoots; next++) {
+        auto root = order[next];
+
+        if (used[root]) {
+            continue;
+        }
+
+        // The remaining vertices have no edges either, they do not cover any pair.
+        if (componentGraph.getConnected(root).empty() && componentGraph.getReverseConnected(root).empty()) {
+            break;
+        }
+
+        neighbours.clear();
+        neighbours.insert(neighbours.end(), componentGraph.getConnected(root).begin(),
+                          componentGraph.getConnected(root).end());
+        neighbours.insert(neighbours.end(), componentGraph.getReverseConnected(root).begin(),
+                          componentGraph.getReverseConnected(root).end());
+
+        // Prefer the neighbours that would become landmarks first.
+        std::sort(neighbours.begin(), neighbours.end(), [&rank](Vertex lhs, Vertex rhs) {
+            return rank[lhs] < rank[rhs];
+        });
+
+        auto &members = roots.emplace_back();
+        members.emplace_back(root);
+        used[root] = true;
+
+        for (auto neighbour : neighbours) {
+            if (members.size() == 64) {
+                break;
+            }
+
+            if (!used[neighbour]) {
+                members.emplace_back(neighbour);
+                used[neighbour] = true;
+            }
+        }
+    }
+
+    return roots;
+}
+
+void PLLIndex::trainBitParallel(const std::vector<std::vector<Vertex>> &roots) {
+    auto &componentGraph = getGraph();
+    auto vertexCount = componentGraph.getVertexCount();
+
+    std::vector<std::vector<uint64_t>> rootsTo(roots.size());
+    std::vector<std::vector<uint64_t>> rootsFrom(roots.size());
+
+    std::vector<std::function<void(uint32_t id)>> workGroup;
+
+    for (auto i = 0u; i < roots.size(); i++) {
+        workGroup.emplace_back([&, i](uint32_t) {
+            auto &to = rootsTo[i];
+            auto &from = rootsFrom[i];
+
+            to.resize(vertexCount, 0);
+            from.resize(vertexCount, 0);
+
+            for (auto j = 0u; j < roots[i].size(); j++) {
+                to[roots[i][j]] |= 1ull << j;
+                from[roots[i][j]] |= 1ull << j;
+            }
+
+            // Edges of the component graph go from a higher to a lower component, thus the targets of a vertex are
+            // final before the vertex itself and a single pass in each direction suffices.
+            for (Vertex vertex = 0; vertex < vertexCount; vertex++) {
+                for (auto target : componentGraph.getConnected(vertex)) {
+                    to[vertex] |= to[target];
+                }
+            }
+
+            for (auto vertex = Vertex(vertexCount); vertex-- > 0;) {
+                for (auto source : componentGraph.getReverseConnected(vertex)) {
+                    from[vertex] |= from[source];
+                }
+            }
+        });
+    }
+
+    getThreadPool().runWorkGroup(workGroup);
+
+    bitParallelTo.assign(vertexCount * bitParallelRoots, 0);
+    bitParallelFrom.assign(vertexCount * bitParallelRoots, 0);
+
+    for (Vertex vertex = 0; vertex < vertexCount; vertex++) {
+        for (auto i = 0u; i < roots.size(); i++) {
+            bitParallelTo[size_t(vertex) * bitParallelRoots + i] = rootsTo[i][vertex];
+            bitParallelFrom[size_t(vertex) * bitParallelRoots + i] = rootsFrom[i][vertex];
+        }
+    }
+}
+
 void PLLIndex::train() {
-    auto& componentGraph = getGraph();
-    reachTo.resize(componentGraph.getVertexCount());
-    reachFrom.resize(componentGraph.getVertexCount());
+    auto &componentGraph = getGraph();
+    auto vertexCount = uint32_t(componentGraph.getVertexCount());
+
+    reachTo.resize(vertexCount);
+    reachFrom.resize(vertexCount);
 
-    boost::dynamic_bitset<> visited(componentGraph.getVertexCount());
-    std::vector<Vertex> queue(componentGraph.getVertexCount());
     std::vector<Vertex> order;
 
     // Order the landmark selection by degree.
     vertexOrderByDegree(componentGraph, order);
 
-    for (auto vertex = 0u; vertex < componentGraph.getVertexCount(); vertex++) {
-        auto landmark = order[vertex];
+    auto roots = selectBitParallelRoots(order);
+    trainBitParallel(roots);
+
+    // The vertices of the bit-parallel roots come first, such that the pruned searches never pass them.
+    // The label of a landmark is its rank.
+    std::vector<Vertex> landmarks;
+    std::vector<uint32_t> rank(vertexCount, std::numeric_limits<uint32_t>::max());
 
-        // First perform pruned bfs for outgoingLabels.
-        prunedBFS(visited, queue, vertex, landmark);
+    landmarks.reserve(vertexCount);
+
+    for (auto &members : roots) {
+        for (auto vertex : members) {
+            rank[vertex] = uint32_t(landmarks.size());
+            landmarks.emplace_back(vertex);
+        }
+    }
 
-        // Then perform reversed bfs for incomingLabels.
-        reversePrunedBFS(visited, queue, vertex, landmark);
+    auto firstLandmark = uint32_t(landmarks.size());
 
-        // Mark the vertex as visited.
-        visited[landmark] = true;
+    for (auto vertex : order) {
+        if (rank[vertex] == std::numeric_limits<uint32_t>::max()) {
+            rank[vertex] = uint32_t(landmarks.size());
+            landmarks.emplace_back(vertex);
+        }
+    }
+
+    auto &threadPool = getThreadPool();
+    auto parallel = threadPool.getNumThreads() > 1 || forceBatches;
+    auto threadCount = std::max(threadPool.getNumThreads(), 1u);
+
+    // A state is allocated by the first search that uses it, thus only threads taking part in the build allocate.
+    std::vector<SearchState> states(threadCount);
+
+    std::vector<LandmarkLabels> batch;
+    std::vector<std::function<void(uint32_t id)>> workGroup;
+
+    // Landmarks of a batch only prune with the labels of earlier batches, thus they can be searched concurrently.
+    // Their labels are committed in rank order, which keeps the labels of every vertex sorted.
+    for (auto batchStart = firstLandmark; batchStart < vertexCount;) {
+        auto batchLength = parallel ? batchSize(batchStart - firstLandmark) : 1u;
+        auto batchEnd = batchStart + std::min(batchLength, vertexCount - batchStart);
+        batch.resize(batchEnd - batchStart);
+
+        auto search = [&, batchStart, batchEnd](uint32_t id, uint32_t first, uint32_t stride) {
+            auto &state = states[id];
+
+            if (state.queue.empty()) {
+                state.visited.resize(vertexCount);
+                state.queue.resize(vertexCount);
+            }
+
+            for (auto label = first; label < batchEnd; label += stride) {
+                auto &labels = batch[label - batchStart];
+                labels.reachFrom.clear();
+                labels.reachTo.clear();
+
+                // First perform pruned bfs for outgoingLabels, then reversed bfs for incomingLabels.
+                prunedBFS(state, rank, landmarks[label], labels.reachFrom);
+                reversePrunedBFS(state, rank, landmarks[label], labels.reachTo);
+            }
+        };
+
+        if (batchEnd - batchStart == 1) {
+            search(0, batchStart, 1);
+        } else {
+            // The searches of the first landmarks in a batch are the largest, thus the tasks take them in turns.
+            auto taskCount = std::min(batchEnd - batchStart, threadCount * 4);
+            workGroup.clear();
+
+            for (auto task = 0u; task < taskCount; task++) {
+                workGroup.emplace_back([&search, first = batchStart + task, stride = taskCount](uint32_t id) {
+                    search(id, first, stride);
+                });
+            }
+
+            threadPool.runWorkGroup(workGroup);
+        }
+
+        for (auto label = batchStart; label < batchEnd; label++) {
+            for (auto vertex : batch[label - batchStart].reachFrom) {
+                reachFrom[vertex].push_back(label);
+            }
+
+            for (auto vertex : batch[label - batchStart].reachTo) {
+                reachTo[vertex].push_back(label);
+            }
+        }
+
+        batchStart = batchEnd;
     }
 }
 
-bool PLLIndex::query(const ReachQuery &query) {
+bool PLLIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -144,5 +360,37 @@ size_t PLLIndex::indexSize() const {
         size += reachFrom[i].size() * sizeof(uint32_t);
     }
 
+    size += (bitParallelTo.size() + bitParallelFrom.size()) * sizeof(uint64_t);
+
     return size;
 }
+
+void PLLIndex::serialize(IndexWriter &writer) const {
+    writer.write(reachTo);
+    writer.write(reachFrom);
+    writer.write(bitParallelRoots);
+    writer.write(bitParallelTo);
+    writer.write(bitParallelFrom);
+}
+
+void PLLIndex::deserialize(IndexReader &reader) {
+    reader.read(reachTo);
+    reader.read(reachFrom);
+
+    // The roots of the bit-parallel labels are not in the pruned labels, the masks are needed to answer queries.
+    auto roots = reader.read<uint32_t>();
+
+    if (roots != bitParallelRoots) {
+        std::cerr << "Index file was trained with " << roots << " bit-parallel roots! Expected: " << bitParallelRoots
+                  << std::fatal;
+    }
+
+    reader.read(bitParallelTo);
+    reader.read(bitParallelFrom);
+
+    auto maskCount = getSCCGraph().getComponentCount() * bitParallelRoots;
+
+    if (bitParallelTo.size() != maskCount || bitParallelFrom.size() != maskCount) {
+        std::cerr << "Index file is corrupt! Name: " << indexName << std::fatal;
+    }
+}
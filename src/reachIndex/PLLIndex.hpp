@@ -8,22 +8,78 @@ private:
     std::vector<std::vector<Vertex>> reachTo;
     std::vector<std::vector<Vertex>> reachFrom;
 
-    inline static const std::string indexName = "Pruned Landmark Labeling";
+    // Bit-parallel labels, every root covers itself and up to 63 of its neighbours with one 64-bit mask per vertex.
+    // The masks of a vertex are stored at vertex * bitParallelRoots, bit j of the i-th mask is set if the vertex
+    // reaches, or is reached from, the j-th vertex of root i.
+    uint32_t bitParallelRoots;
+    std::vector<uint64_t> bitParallelTo;
+    std::vector<uint64_t> bitParallelFrom;
+
+    std::string indexName = "Pruned Landmark Labeling";
+
+    bool forceBatches = false;
 
 public:
-    explicit PLLIndex() {
+    explicit PLLIndex(uint32_t bitParallelRoots = 0) : bitParallelRoots(bitParallelRoots) {
         requiresComponentGraphDuringQueries = false;
+
+        if (bitParallelRoots != 0) {
+            indexName += " bp=" + std::to_string(bitParallelRoots);
+        }
+    }
+
+    /**
+     * @brief searches the landmarks in batches even on a single thread, such that the batched build can be tested.
+     */
+    void setForceBatches(bool force) {
+        forceBatches = force;
     }
 
     void train() override;
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
     [[nodiscard]] size_t indexSize() const override;
 
+    void serialize(IndexWriter &writer) const override;
+    void deserialize(IndexReader &reader) override;
+
     [[nodiscard]] const std::string &getName() const override { return indexName; }
 
 private:
-    void prunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &queue, uint32_t label, Vertex landmark);
-    void reversePrunedBFS(boost::dynamic_bitset<> &visited, std::vector<Vertex> &queue, uint32_t label, Vertex landmark);
+    /**
+     * @brief scratch space of a thread running pruned searches.
+     */
+    struct SearchState {
+        boost::dynamic_bitset<> visited;
+        std::vector<Vertex> queue;
+    };
+
+    /**
+     * @brief the vertices that receive the label of a landmark, in the order they were visited.
+     */
+    struct LandmarkLabels {
+        std::vector<Vertex> reachFrom;
+        std::vector<Vertex> reachTo;
+    };
+
+    /**
+     * @brief the number of landmarks searched concurrently once the landmarks before label are committed.
+     * The first landmarks cover most pairs, thus they are searched one by one, such that they still prune the others.
+     */
+    [[nodiscard]] static uint32_t batchSize(uint32_t label);
+
+    /**
+     * @brief picks the vertices of the bit-parallel roots, every root is followed by its neighbours.
+     * A vertex is part of at most one root, the roots are taken in the order of the landmarks.
+     */
+    [[nodiscard]] std::vector<std::vector<Vertex>> selectBitParallelRoots(const std::vector<Vertex> &order) const;
+
+    void trainBitParallel(const std::vector<std::vector<Vertex>> &roots);
+
+    void prunedBFS(SearchState &state, const std::vector<uint32_t> &rank, Vertex landmark,
+                   std::vector<Vertex> &labeled) const;
+    void reversePrunedBFS(SearchState &state, const std::vector<uint32_t> &rank, Vertex landmark,
+                          std::vector<Vertex> &labeled) const;
 
-    bool isReachable(Vertex source, Vertex target);
+    [[nodiscard]] bool isReachable(Vertex source, Vertex target) const;
+    [[nodiscard]] bool isBitParallelReachable(Vertex source, Vertex target) const;
 };
@@ -1,6 +1,6 @@
 #include "PPLIndex.hpp"
 
-bool PPLIndex::isReachable(Vertex sourceComponent, Vertex targetComponent) {
+bool PPLIndex::isReachable(Vertex sourceComponent, Vertex targetComponent) const {
     // Start by doing Pruned Path Labeling.
     auto &outgoingPaths = reachToPath[sourceComponent];
     auto &incomingPaths = reachFromPath[sourceComponent];
@@ -308,7 +308,7 @@ void PPLIndex::train() {
     }
 }
 
-bool PPLIndex::query(const ReachQuery &query) {
+bool PPLIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -338,3 +338,17 @@ size_t PPLIndex::indexSize() const {
 
     return size;
 }
+
+void PPLIndex::serialize(IndexWriter &writer) const {
+    writer.write(reachToPath);
+    writer.write(reachFromPath);
+    writer.write(reachTo);
+    writer.write(reachFrom);
+}
+
+void PPLIndex::deserialize(IndexReader &reader) {
+    reader.read(reachToPath);
+    reader.read(reachFromPath);
+    reader.read(reachTo);
+    reader.read(reachFrom);
+}
@@ -20,13 +20,16 @@ public:
     }
 
     void train() override;
-    bool query(const ReachQuery &query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
     [[nodiscard]] size_t indexSize() const override;
 
+    void serialize(IndexWriter &writer) const override;
+    void deserialize(IndexReader &reader) override;
+
     [[nodiscard]] const std::string &getName() const override { return indexName; }
 
 private:
-    bool isReachable(Vertex source, Vertex target);
+    [[nodiscard]] bool isReachable(Vertex source, Vertex target) const;
 
     void buildOptimalPath(boost::dynamic_bitset<>&  used, std::vector<Vertex>& path);
 
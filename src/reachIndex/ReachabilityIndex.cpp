@@ -1,4 +1,5 @@
 #include <utility/Format.hpp>
+#include <utility/MappedFile.hpp>
 #include "BFSIndex.hpp"
 #include "DFSIndex.hpp"
 #include "BiBFSIndex.hpp"
@@ -40,7 +41,17 @@ ReachabilityIndex::create(const std::string &name, std::vector<std::string>& par
     }
 
     if (lowerCaseName == "pll") {
-        return std::make_unique<PLLIndex>();
+        if (params.empty()) {
+            return std::make_unique<PLLIndex>();
+        }
+
+        if (params.size() != 1) {
+            std::cerr << "Expected no arguments or [bp=]<roots> as input! Name: " << name << std::fatal;
+        }
+
+        // The number of bit-parallel roots, the LCR indexes pass it as a plain number.
+        auto roots = params[0].rfind("bp=", 0) == 0 ? params[0].substr(3) : params[0];
+        return std::make_unique<PLLIndex>(uint32_t(std::stoll(roots)));
     }
 
     if (lowerCaseName == "ppl") {
@@ -59,6 +70,82 @@ ReachabilityIndex::create(const std::string &name, std::vector<std::string>& par
     return nullptr;
 }
 
+void ReachabilityIndex::save(const std::string &filePath) const {
+    auto &graph = getGraph();
+
+    IndexFileHeader header { };
+    std::copy(IndexFileHeader::expectedMagic, IndexFileHeader::expectedMagic + 8, header.magic);
+    header.version = IndexFileHeader::currentVersion;
+    header.vertexCount = getSCCGraph().getOriginalVertexCount();
+    header.labelCount = 0;
+    header.edgeCount = graph.getEdgeCount();
+    header.fingerprint = graphFingerprint(graph);
+
+    IndexWriter writer(filePath);
+    writer.writeHeader(header, getName());
+    serialize(writer);
+
+    if (writer.fail()) {
+        std::cerr << "Failed to write index file: " << filePath << std::fatal;
+    }
+}
+
+void ReachabilityIndex::load(const std::string &filePath) {
+    auto file = MappedFile::open(filePath);
+
+    if (file == nullptr) {
+        std::cerr << "Failed to open file: " << filePath << std::fatal;
+    }
+
+    auto &graph = getGraph();
+
+    IndexReader reader(file);
+    IndexFileHeader header { };
+    std::string name;
+    reader.readHeader(header, name);
+
+    if (header.vertexCount != getSCCGraph().getOriginalVertexCount() || header.labelCount != 0 ||
+        header.edgeCount != graph.getEdgeCount() || header.fingerprint != graphFingerprint(graph)) {
+        std::cerr << "Index was trained on a different graph! File: " << filePath << std::fatal;
+    }
+
+    if (name != getName()) {
+        std::cerr << "Index file contains a different index! Expected: " << getName() << " found: " << name
+                  << std::fatal;
+    }
+
+    deserialize(reader);
+
+    if (!reader.atEnd()) {
+        std::cerr << "Index file is corrupt! File: " << filePath << std::fatal;
+    }
+}
+
+void ReachabilityIndex::serialize(IndexWriter &writer) const {
+    std::cerr << "Index does not support persistence! Name: " << getName() << std::fatal;
+}
+
+void ReachabilityIndex::deserialize(IndexReader &reader) {
+    std::cerr << "Index does not support persistence! Name: " << getName() << std::fatal;
+}
+
+void serializeNested(IndexWriter &writer, const ReachabilityIndex &index) {
+    writer.write(index.getSCCGraph());
+    index.serialize(writer);
+}
+
+void deserializeNested(IndexReader &reader, ReachabilityIndex &index, std::unique_ptr<SCCGraph> &sccGraph) {
+    reader.read(sccGraph);
+    index.setGraph(sccGraph.get());
+    index.deserialize(reader);
+}
+
+void deserializeNested(IndexReader &reader, ReachabilityIndex &index, std::unique_ptr<SCCGraph> &sccGraph,
+                       VertexMappingStore &mappings) {
+    deserializeNested(reader, index, sccGraph);
+    sccGraph->shareVertexMapping(mappings);
+}
+
 std::ostream &operator <<(std::ostream &out, const ReachabilityIndex &index) {
     formatWidth(out, index.getName(), 50);
     out << "size: ";
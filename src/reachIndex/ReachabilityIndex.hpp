@@ -1,11 +1,16 @@
 #pragma once
 
 #include <graphs/Query.hpp>
+#include <dataStructures/QueryContext.hpp>
+#include <io/IndexFile.hpp>
 
 class ReachabilityIndex {
 private:
     SCCGraph* sccGraph = nullptr;
 
+    // Context for callers that query from a single thread.
+    QueryContext queryContext;
+
 protected:
     bool requiresComponentGraphDuringQueries = true;
 
@@ -20,21 +25,54 @@ public:
     ReachabilityIndex &operator =(ReachabilityIndex &&) = default;
 
     virtual void train() = 0;
-    virtual bool query(const ReachQuery &query) = 0;
+
+    /**
+     * @brief answers the query, safe to call concurrently as long as every thread uses its own context.
+     */
+    virtual bool query(const ReachQuery &query, QueryContext &context) const = 0;
 
     /**
      * @brief true -> possibly reachable.
      *       false -> definitely not reachable.
      */
-    virtual bool queryOnce(const ReachQuery& reachQuery) {
+    virtual bool queryOnce(const ReachQuery &reachQuery, QueryContext &context) const {
         // As a default, just fallback to normal querying.
-        return query(reachQuery);
+        return query(reachQuery, context);
+    }
+
+    bool query(const ReachQuery &reachQuery) {
+        return query(reachQuery, queryContext);
+    }
+
+    bool queryOnce(const ReachQuery &reachQuery) {
+        return queryOnce(reachQuery, queryContext);
     }
 
     [[nodiscard]] virtual size_t indexSize() const = 0;
     [[nodiscard]] virtual const std::string &getName() const = 0;
     [[nodiscard]] bool canDiscardComponentGraph() const { return !requiresComponentGraphDuringQueries; }
 
+    /**
+     * @brief writes the trained index to a file, such that it can be loaded instead of trained again.
+     */
+    void save(const std::string &filePath) const;
+
+    /**
+     * @brief loads an index written by save, instead of training it.
+     * The graph has to be set first, and has to be the graph the index was trained on.
+     */
+    void load(const std::string &filePath);
+
+    /**
+     * @brief writes the data of the trained index, without the graph.
+     */
+    virtual void serialize(IndexWriter &writer) const;
+
+    /**
+     * @brief reads the data written by serialize, the graph of the index is set before reading.
+     */
+    virtual void deserialize(IndexReader &reader);
+
     void setGraph(SCCGraph* graphPtr) {
         this->sccGraph = graphPtr;
     }
@@ -67,4 +105,20 @@ private:
     }
 };
 
+/**
+ * @brief writes an index nested in another index, together with its strongly connected component graph.
+ */
+void serializeNested(IndexWriter &writer, const ReachabilityIndex &index);
+
+/**
+ * @brief reads an index written by serializeNested, the index references the read component graph.
+ */
+void deserializeNested(IndexReader &reader, ReachabilityIndex &index, std::unique_ptr<SCCGraph> &sccGraph);
+
+/**
+ * @brief reads an index written by serializeNested and shares the vertex mapping of its component graph in mappings.
+ */
+void deserializeNested(IndexReader &reader, ReachabilityIndex &index, std::unique_ptr<SCCGraph> &sccGraph,
+                       VertexMappingStore &mappings);
+
 std::ostream &operator <<(std::ostream &out, const ReachabilityIndex &index);
\ No newline at end of file
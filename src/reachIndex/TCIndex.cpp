@@ -24,7 +24,7 @@ void TCIndex::train() {
     }
 }
 
-bool TCIndex::query(const ReachQuery &query) {
+bool TCIndex::query(const ReachQuery &query, QueryContext &context) const {
     auto& sccGraph = getSCCGraph();
 
     auto sourceComponent = sccGraph.getComponentIndex(query.source);
@@ -46,3 +46,19 @@ size_t TCIndex::indexSize() const {
     // Divide by 8 since the compiler can optimize std::vector<bool> by compacting the booleans to bits.
     return closure.size() * closure.size() / 8u;
 }
+
+void TCIndex::serialize(IndexWriter &writer) const {
+    writer.write(uint64_t(closure.size()));
+
+    for (auto &row : closure) {
+        writer.write(row);
+    }
+}
+
+void TCIndex::deserialize(IndexReader &reader) {
+    closure.resize(reader.read<uint64_t>());
+
+    for (auto &row : closure) {
+        reader.read(row);
+    }
+}
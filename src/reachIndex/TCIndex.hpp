@@ -14,8 +14,11 @@ public:
     }
 
     void train() override;
-    bool query(const ReachQuery& query) override;
+    bool query(const ReachQuery &query, QueryContext &context) const override;
 
     [[nodiscard]] size_t indexSize() const override;
+
+    void serialize(IndexWriter &writer) const override;
+    void deserialize(IndexReader &reader) override;
     [[nodiscard]] const std::string &getName() const override { return indexName; }
 };
@@ -1,7 +1,13 @@
 #include "threading/ThreadPool.hpp"
 #include <iostream>
 
+// Id of the worker running on this thread, or noWorker for threads outside of the pool.
+static constexpr uint32_t noWorker = std::numeric_limits<uint32_t>::max();
+static thread_local uint32_t currentWorkerId = noWorker;
+
 void ThreadPool::run(ThreadPool *threadPool, uint32_t id) {
+    currentWorkerId = id;
+
     std::shared_ptr<ThreadWorkGroup> currentWorkGroup = nullptr;
     std::function<void(uint32_t id)> currentFunction;
     std::mutex threadSleepMutex;
@@ -124,6 +130,18 @@ std::shared_ptr<WaitHandle> ThreadPool::queueWorkGroup(std::vector<std::function
     return workGroup->waitHandle;
 }
 
+void ThreadPool::runWorkGroup(std::vector<std::function<void(uint32_t id)>> &functions) {
+    if (currentWorkerId != noWorker) {
+        for (auto &function : functions) {
+            function(currentWorkerId);
+        }
+
+        return;
+    }
+
+    queueWorkGroup(functions)->waitTillCompleted();
+}
+
 std::shared_ptr<WaitHandle> ThreadPool::queueWorkGroup(std::vector<std::function<void(uint32_t id)>> &functions,
                                                        std::shared_ptr<WaitHandle> &handleToWaitFor) {
     std::shared_ptr<ThreadWorkGroup> workGroup = std::make_shared<ThreadWorkGroup>(uint32_t(functions.size()));
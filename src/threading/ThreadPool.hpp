@@ -49,6 +49,20 @@ public:
      */
     std::shared_ptr<WaitHandle> queueWorkGroup(std::vector<std::function<void(uint32_t id)>> &functions, std::shared_ptr<WaitHandle>& handleToWaitFor);
 
+    /**
+     * @brief Run a list of functions and wait till they are finished.
+     * Called from a worker thread, the functions run on that thread instead, as waiting there could starve the pool.
+     * @param functions the functions to execute.
+     */
+    void runWorkGroup(std::vector<std::function<void(uint32_t id)>> &functions);
+
+    /**
+     * @brief The number of worker threads, the id passed to queued functions is below this number.
+     */
+    [[nodiscard]] uint32_t getNumThreads() const {
+        return numThreads;
+    }
+
 private:
     static void run(ThreadPool* threadPool, uint32_t id);
 
@@ -0,0 +1,71 @@
+#include "MappedFile.hpp"
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+
+    #define MMAP_ENABLED 1
+#else
+    #define MMAP_ENABLED 0
+#endif
+
+MappedFile::~MappedFile() {
+#if MMAP_ENABLED == 1
+    if (buffer.empty() && size != 0) {
+        munmap(const_cast<char *>(data), size);
+    }
+#endif
+}
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string &filePath) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#if MMAP_ENABLED == 1
+    auto descriptor = ::open(filePath.c_str(), O_RDONLY);
+
+    if (descriptor < 0) {
+        return nullptr;
+    }
+
+    struct stat status { };
+
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        return nullptr;
+    }
+
+    file->size = size_t(status.st_size);
+
+    if (file->size != 0) {
+        auto *mapped = mmap(nullptr, file->size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+        if (mapped == MAP_FAILED) {
+            close(descriptor);
+            file->size = 0;
+            return nullptr;
+        }
+
+        file->data = static_cast<const char *>(mapped);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    close(descriptor);
+#else
+    std::ifstream stream { filePath, std::ios::binary | std::ios::ate };
+
+    if (stream.fail()) {
+        return nullptr;
+    }
+
+    file->buffer.resize(size_t(stream.tellg()));
+    stream.seekg(0);
+    stream.read(file->buffer.data(), std::streamsize(file->buffer.size()));
+
+    file->data = file->buffer.data();
+    file->size = file->buffer.size();
+#endif
+
+    return file;
+}
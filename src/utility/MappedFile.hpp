@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @brief a read only view of a whole file, memory mapped where the platform supports it.
+ * Mapped pages are shared through the page cache, such that processes reading the same file share its memory.
+ * On other platforms the file is read into a buffer instead.
+ */
+class MappedFile {
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+
+    std::vector<char> buffer;
+
+    MappedFile() = default;
+
+public:
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+
+    MappedFile &operator =(const MappedFile &) = delete;
+    MappedFile &operator =(MappedFile &&) = delete;
+
+    /**
+     * @brief maps the file, returns nullptr if the file cannot be opened.
+     */
+    static std::shared_ptr<const MappedFile> open(const std::string &filePath);
+
+    [[nodiscard]] const char *getData() const {
+        return data;
+    }
+
+    [[nodiscard]] size_t getSize() const {
+        return size;
+    }
+};
@@ -203,3 +203,30 @@ size_t getCurrentPSS( )
 	return (size_t)0L;			/* Unsupported. */
 #endif
 }
+
+/**
+ * Returns the size of the physical memory of the machine measured
+ * in bytes, or zero if the value cannot be determined on this OS.
+ */
+size_t getPhysicalMemory( )
+{
+#if defined(_WIN32)
+    /* Windows -------------------------------------------------- */
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if ( !GlobalMemoryStatusEx( &status ) )
+        return (size_t)0L;		/* Can't access? */
+    return (size_t)status.ullTotalPhys;
+
+#elif defined(_SC_PHYS_PAGES)
+	/* Linux, OSX and other POSIX systems ----------------------- */
+	long pages = sysconf( _SC_PHYS_PAGES );
+	if ( pages <= 0 )
+		return (size_t)0L;		/* Can't read? */
+	return (size_t)pages * (size_t)sysconf( _SC_PAGESIZE );
+
+#else
+	/* Unknown OS ----------------------------------------------- */
+	return (size_t)0L;			/* Unsupported. */
+#endif
+}
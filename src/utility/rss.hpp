@@ -8,6 +8,8 @@ size_t getCurrentRSS( );
 
 size_t getPeakPSS();
 size_t getCurrentPSS();
+
+size_t getPhysicalMemory();
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "dataStructures/BloomFilter.hpp"
+
+TEST(blockedBloomFilter, containsAddedKeys) {
+    // Arrange
+    std::vector<uint32_t> sizes = { 32, 160, 512, 4096 };
+
+    for (auto bits : sizes) {
+        for (auto hashCount = 1u; hashCount <= 4u; hashCount++) {
+            BlockedBloomFilter first;
+            BlockedBloomFilter second;
+
+            first.setup(bits, hashCount);
+            second.setup(bits, hashCount);
+
+            // Act
+            for (Vertex vertex = 0; vertex < 100; vertex++) {
+                first.add(vertex);
+                second.add(vertex + 100);
+            }
+
+            first |= second;
+
+            // Assert
+            for (Vertex vertex = 0; vertex < 200; vertex++) {
+                auto probe = BlockedBloomFilter::probe(vertex, bits, hashCount);
+
+                EXPECT_TRUE(first.contains(vertex)) << bits << " " << hashCount;
+                EXPECT_TRUE(first.contains(probe)) << bits << " " << hashCount;
+                EXPECT_EQ(second.contains(probe), second.contains(vertex));
+            }
+
+            EXPECT_EQ(first.sizeInBytes(), size_t(bits / 8));
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+#include "dataStructures/BloomLabels.hpp"
+
+TEST(bloomLabels, isSubset) {
+    // Arrange
+    std::mt19937 generator(11);
+
+    for (auto words = 1u; words <= 21u; words++) {
+        BloomLabels labels;
+        labels.resize(2, words);
+
+        auto *subset = labels[0];
+        auto *superset = labels[1];
+
+        for (auto i = 0u; i < words; i++) {
+            superset[i] = generator();
+            subset[i] = superset[i] & generator();
+        }
+
+        // Act
+        auto isSubset = BloomLabels::isSubset(subset, superset, words);
+
+        // Assert
+        EXPECT_TRUE(isSubset) << words;
+
+        // Every word is checked, including the ones past the last full vector.
+        for (auto i = 0u; i < words; i++) {
+            auto missing = ~superset[i];
+
+            if (missing == 0) {
+                continue;
+            }
+
+            auto previous = subset[i];
+            subset[i] |= missing & (~missing + 1);
+
+            EXPECT_FALSE(BloomLabels::isSubset(subset, superset, words)) << words << " " << i;
+            subset[i] = previous;
+        }
+    }
+}
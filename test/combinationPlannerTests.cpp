@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "algorithms/GraphAlgorithms.hpp"
+#include "lcrIndex/CombinationPlanner.hpp"
+
+TEST(combinationPlanner, plansDeterministicallyWithinBudget) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(256, 8, 1024);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 255);
+    std::uniform_int_distribution<Label> labelDistribution(0, 7);
+
+    for (auto i = 0u; i < 1024; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    std::vector<Vertex> order;
+    vertexOrderByDegree(graph, order);
+
+    LabelEdgeCounts labelEdgeCounts(graph);
+    std::vector<std::unique_ptr<lcr::CombinationPlanner>> planners;
+
+    for (auto i = 0u; i < 2; i++) {
+        auto &planner = planners.emplace_back(std::make_unique<lcr::CombinationPlanner>(graph, 3, 5));
+
+        for (Label label = 0; label < 8; label++) {
+            LabelSet labelSet(8);
+            labelSet[label] = true;
+
+            planner->calibrate(labelSet, 1024 + 16 * labelEdgeCounts.countEdges(labelSet));
+        }
+
+        // The second planner divides the sources over more tasks, the sample must not change.
+        planner->sample(order, 1u << 20, i == 0 ? 1 : 7);
+    }
+
+    auto unlimited = planners[0]->plan(std::numeric_limits<size_t>::max());
+    size_t unlimitedBytes = 0;
+
+    for (auto &labelSet : unlimited) {
+        unlimitedBytes += planners[0]->estimateBytes(labelSet);
+    }
+
+    // Act
+    auto plan = planners[0]->plan(unlimitedBytes / 2);
+    auto otherPlan = planners[1]->plan(unlimitedBytes / 2);
+
+    // Assert
+    ASSERT_FALSE(unlimited.empty());
+    ASSERT_FALSE(plan.empty());
+    EXPECT_EQ(plan, otherPlan);
+    EXPECT_LT(plan.size(), unlimited.size());
+
+    size_t plannedBytes = 0;
+    size_t plannedEdges = 0;
+
+    for (auto &labelSet : plan) {
+        EXPECT_GE(labelSet.count(), 3);
+        EXPECT_FALSE(labelSet.all());
+
+        plannedBytes += planners[0]->estimateBytes(labelSet);
+        plannedEdges += labelEdgeCounts.countEdges(labelSet);
+    }
+
+    EXPECT_LE(plannedBytes, unlimitedBytes / 2);
+    EXPECT_LE(plannedEdges, planners[0]->getTrainingEdges());
+}
@@ -0,0 +1,31 @@
+#include "gtest/gtest.h"
+#include "dataStructures/CombinationRanking.hpp"
+
+TEST(combinationRanking, ranksDensely) {
+    // Arrange
+    uint32_t labelCount = 9;
+    CombinationRanking ranking(labelCount, 2, 4);
+
+    std::vector<bool> ranked(ranking.size());
+
+    // Act
+    for (auto mask = 0u; mask < (1u << labelCount); mask++) {
+        LabelSet labelSet(labelCount, mask);
+        auto rank = ranking.rank(labelSet);
+
+        // Assert
+        if (labelSet.count() < 2 || labelSet.count() > 4) {
+            EXPECT_EQ(rank, CombinationRanking::npos) << mask;
+            continue;
+        }
+
+        ASSERT_LT(rank, ranking.size()) << mask;
+        EXPECT_FALSE(ranked[rank]) << mask;
+        EXPECT_EQ(ranking.unrank(rank), labelSet) << mask;
+
+        ranked[rank] = true;
+    }
+
+    EXPECT_EQ(ranking.size(), 36u + 84u + 126u);
+    EXPECT_TRUE(std::all_of(ranked.begin(), ranked.end(), [](bool value) { return value; }));
+}
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "lcrIndex/Index.hpp"
+#include "reachIndex/ReachabilityIndex.hpp"
+#include "io/IndexFile.hpp"
+#include "utility/MappedFile.hpp"
+
+TEST(indexPersistence, saveAndLoad) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(256, 6, 1024);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 255);
+    std::uniform_int_distribution<Label> labelDistribution(0, 5);
+
+    for (auto i = 0u; i < 1024; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    auto filePath = (std::filesystem::temp_directory_path() / "indexPersistence.lcri").string();
+
+    // P2H with w=4 splits the labels in a primary and a secondary index, the scale harness nests them.
+    std::vector<std::vector<std::string>> indexes = {{ "p2h", "4" }, { "klc", "pll" }, { "sh", "4", "p2h" }};
+
+    for (auto &params : indexes) {
+        auto name = params[0];
+        params.erase(params.begin());
+
+        auto trained = lcr::Index::create(name, params);
+        trained->setGraph(&graph);
+        trained->train();
+
+        auto loaded = lcr::Index::create(name, params);
+        loaded->setGraph(&graph);
+
+        // Act
+        trained->save(filePath);
+        loaded->load(filePath);
+
+        // Assert
+        for (auto labels = 1ul; labels < 64; labels += 5) {
+            std::vector<Label> queryLabels;
+
+            for (Label label = 0; label < 6; label++) {
+                if ((labels >> label) & 1ul) {
+                    queryLabels.emplace_back(label);
+                }
+            }
+
+            for (Vertex source = 0; source < 256; source += 13) {
+                for (Vertex target = 0; target < 256; target += 7) {
+                    LCRQuery query(source, target, queryLabels);
+                    query.init(graph);
+
+                    EXPECT_EQ(loaded->query(query), trained->query(query)) << trained->getName();
+                }
+            }
+        }
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(indexPersistence, rejectsDifferentParameters) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(256, 6, 1024);
+
+    std::mt19937 generator(9);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 255);
+    std::uniform_int_distribution<Label> labelDistribution(0, 5);
+
+    for (auto i = 0u; i < 1024; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    auto filePath = (std::filesystem::temp_directory_path() / "indexParameters.lcri").string();
+
+    auto trained = lcr::Index::create("klc", "2", "pll", "16");
+    trained->setGraph(&graph);
+    trained->train();
+    trained->save(filePath);
+
+    auto loaded = lcr::Index::create("klc", "2", "pll");
+    loaded->setGraph(&graph);
+
+    // Nested indexes are stored without a name, the bit-parallel roots of PLL are checked on their own.
+    DiGraph diGraph;
+    diGraph.setVertices(256);
+
+    for (auto i = 0u; i < 1024; i++) {
+        diGraph.addEdge(vertexDistribution(generator), vertexDistribution(generator));
+    }
+
+    auto sccGraph = tarjanSCC(diGraph);
+
+    auto trainedPLL = ReachabilityIndex::create("pll", "16");
+    trainedPLL->setGraph(sccGraph.get());
+    trainedPLL->train();
+
+    auto nestedPath = (std::filesystem::temp_directory_path() / "nestedParameters.lcri").string();
+
+    {
+        IndexWriter writer(nestedPath);
+        serializeNested(writer, *trainedPLL);
+    }
+
+    auto loadedPLL = ReachabilityIndex::create("pll");
+    std::unique_ptr<SCCGraph> loadedSCCGraph;
+
+    // Act & Assert
+    EXPECT_EXIT(loaded->load(filePath), ::testing::ExitedWithCode(1), "different index");
+
+    EXPECT_EXIT({
+                    IndexReader reader(MappedFile::open(nestedPath));
+                    deserializeNested(reader, *loadedPLL, loadedSCCGraph);
+                }, ::testing::ExitedWithCode(1), "bit-parallel roots");
+
+    std::filesystem::remove(filePath);
+    std::filesystem::remove(nestedPath);
+}
+
+TEST(indexPersistence, rejectsDecreasingOffsets) {
+    // Arrange
+    auto filePath = (std::filesystem::temp_directory_path() / "decreasingOffsets.lcri").string();
+
+    // Nested vectors are written as their offsets followed by their elements.
+    {
+        IndexWriter writer(filePath);
+        writer.write(std::vector<uint64_t> { 0, 3, 1 });
+        writer.write(std::vector<uint32_t> { 7 });
+    }
+
+    std::vector<std::vector<uint32_t>> values;
+
+    // Act & Assert
+    EXPECT_EXIT({
+                    IndexReader reader(MappedFile::open(filePath));
+                    reader.read(values);
+                }, ::testing::ExitedWithCode(1), "corrupt");
+
+    std::filesystem::remove(filePath);
+}
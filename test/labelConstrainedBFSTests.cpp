@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "lcrIndex/Index.hpp"
+
+TEST(labelConstrainedBFS, variantsMatchBFS) {
+    // Arrange
+    // Dense enough that the frontier grows past the switching threshold, such that bottom up steps are taken.
+    LabeledEdgeGraph graph;
+    graph.setSizes(256, 3, 2048);
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 255);
+    std::uniform_int_distribution<Label> labelDistribution(0, 2);
+
+    for (auto i = 0u; i < 2048; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    QueryContext context;
+    TraversalScratch forward;
+    TraversalScratch backward;
+
+    auto bfs = lcr::Index::create("bfs");
+    bfs->setGraph(&graph);
+
+    // Act & Assert
+    for (auto labels = 0ul; labels < 8; labels++) {
+        LabelSet labelSet(3, labels);
+
+        for (Vertex source = 0; source < 256; source += 17) {
+            for (Vertex target = 0; target < 256; target += 3) {
+                LCRQuery query;
+                query.source = source;
+                query.target = target;
+                query.labelSet = labelSet;
+
+                auto expected = bfs->query(query, context);
+
+                EXPECT_EQ(labelConstrainedBiBFS(graph, source, target, labelSet, forward, backward), expected);
+                EXPECT_EQ(labelConstrainedHybridBFS(graph, source, target, labelSet, forward), expected);
+                EXPECT_EQ(labelConstrainedHybridBiBFS(graph, source, target, labelSet, forward, backward), expected);
+            }
+        }
+    }
+}
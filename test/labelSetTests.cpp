@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "graphs/Definitions.hpp"
+
+static void testLabelSetOperations(uint32_t labelCount) {
+    // Arrange
+    LabelSet small(labelCount);
+    LabelSet large(labelCount);
+
+    small[1] = true;
+    small[labelCount - 1] = true;
+
+    large.set();
+    large[2] = false;
+
+    // Act
+    auto merged = small;
+    merged |= large;
+
+    auto copied = std::move(merged);
+    merged = copied;
+
+    // Assert
+    EXPECT_EQ(small.size(), labelCount);
+    EXPECT_EQ(small.count(), 2);
+    EXPECT_EQ(large.count(), labelCount - 1);
+    EXPECT_TRUE(small.is_subset_of(large));
+    EXPECT_FALSE(large.is_subset_of(small));
+    EXPECT_TRUE(small.intersects(large));
+
+    EXPECT_TRUE(merged == copied);
+    EXPECT_EQ(merged.hash(), large.hash());
+    EXPECT_TRUE(merged == large);
+    EXPECT_TRUE(small < large);
+
+    large.reset();
+    EXPECT_TRUE(large.none());
+    EXPECT_FALSE(small.intersects(large));
+}
+
+TEST(labelSet, inlineStorage) {
+    testLabelSetOperations(8);
+    testLabelSetOperations(128);
+}
+
+TEST(labelSet, heapStorage) {
+    testLabelSetOperations(129);
+    testLabelSetOperations(1000);
+}
+
+TEST(labelSet, resize) {
+    // Arrange
+    LabelSet labelSet(100);
+    labelSet[99] = true;
+
+    // Act
+    labelSet.resize(300, true);
+
+    // Assert
+    ASSERT_EQ(labelSet.size(), 300);
+    EXPECT_EQ(labelSet.count(), 201);
+    EXPECT_TRUE(labelSet[99]);
+    EXPECT_FALSE(labelSet[98]);
+
+    labelSet.resize(64);
+    EXPECT_EQ(labelSet.count(), 0);
+}
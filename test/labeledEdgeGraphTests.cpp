@@ -0,0 +1,288 @@
+#include "gtest/gtest.h"
+#include "graphs/LabeledGraph.hpp"
+#include "io/BinaryGraphFormat.hpp"
+#include "io/GraphReader.hpp"
+#include "io/GraphWriter.hpp"
+
+static std::unique_ptr<LabeledEdgeGraph> createSimpleGraph(bool groupByLabel) {
+    auto graph = std::make_unique<LabeledEdgeGraph>();
+
+    graph->setSizes(4, 3, 8);
+
+    if (groupByLabel) {
+        graph->groupByLabel();
+    }
+
+    graph->addEdge(0, 3, 2);
+    graph->addEdge(0, 1, 0);
+    graph->addEdge(0, 2, 1);
+    graph->addEdge(0, 1, 2);
+    graph->addEdge(0, 2, 0);
+    graph->addEdge(1, 2, 1);
+    graph->addEdge(3, 0, 1);
+
+    // Duplicate edges are removed by optimize.
+    graph->addEdge(0, 1, 0);
+
+    graph->optimize();
+    return graph;
+}
+
+static std::vector<std::pair<Vertex, Label>> collect(LabeledEdgeGraphLabelSetIterator it) {
+    std::vector<std::pair<Vertex, Label>> edges;
+
+    while (it.next()) {
+        edges.emplace_back(it->target, it->label);
+    }
+
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+TEST(labeledEdgeGraph, compressedAdjacency) {
+    // Arrange
+    auto graph = createSimpleGraph(false);
+
+    // Act
+    auto it = graph->getConnected(0);
+    auto revIt = graph->getReverseConnected(2);
+    auto emptyIt = graph->getConnected(2);
+
+    // Assert
+    ASSERT_EQ(graph->getEdgeCount(), 7);
+    EXPECT_EQ(graph->getEdgeCount(0), 2);
+
+    ASSERT_EQ(it.size(), 5);
+    EXPECT_EQ(it[0].target, 1);
+    EXPECT_EQ(it[0].label, 0);
+    EXPECT_EQ(it[4].target, 3);
+
+    ASSERT_EQ(revIt.size(), 3);
+    ASSERT_TRUE(revIt.next());
+    EXPECT_EQ(revIt->source, 2);
+    EXPECT_EQ(revIt->target, 0);
+    EXPECT_EQ(revIt->label, 0);
+    ASSERT_TRUE(revIt.next());
+    EXPECT_EQ(revIt->target, 0);
+    EXPECT_EQ(revIt->label, 1);
+    ASSERT_TRUE(revIt.next());
+    EXPECT_EQ(revIt->target, 1);
+    EXPECT_FALSE(revIt.next());
+
+    EXPECT_FALSE(emptyIt.isValid());
+    EXPECT_FALSE(emptyIt.next());
+}
+
+TEST(labeledEdgeGraph, groupByLabel) {
+    // Arrange
+    auto graph = createSimpleGraph(false);
+    auto groupedGraph = createSimpleGraph(true);
+
+    auto lateGroupedGraph = createSimpleGraph(false);
+    lateGroupedGraph->groupByLabel();
+
+    LabelSet labelSet(3);
+    labelSet[0] = true;
+    labelSet[2] = true;
+
+    // Act
+    auto labelIt = groupedGraph->getConnected(0, 2);
+    auto missingLabelIt = groupedGraph->getConnected(1, 0);
+
+    // Assert
+    EXPECT_TRUE(groupedGraph->isLabelGrouped());
+
+    ASSERT_TRUE(labelIt.next());
+    EXPECT_EQ(labelIt->target, 1);
+    ASSERT_TRUE(labelIt.next());
+    EXPECT_EQ(labelIt->target, 3);
+    EXPECT_FALSE(labelIt.next());
+
+    EXPECT_FALSE(missingLabelIt.next());
+
+    for (auto vertex = 0u; vertex < graph->getVertexCount(); vertex++) {
+        auto expected = collect(graph->getConnected(vertex, labelSet));
+        auto expectedReverse = collect(graph->getReverseConnected(vertex, labelSet));
+
+        EXPECT_EQ(collect(groupedGraph->getConnected(vertex, labelSet)), expected);
+        EXPECT_EQ(collect(groupedGraph->getReverseConnected(vertex, labelSet)), expectedReverse);
+        EXPECT_EQ(collect(lateGroupedGraph->getConnected(vertex, labelSet)), expected);
+        EXPECT_EQ(collect(lateGroupedGraph->getReverseConnected(vertex, labelSet)), expectedReverse);
+    }
+}
+
+TEST(labeledEdgeGraph, binaryRoundTrip) {
+    // Arrange
+    auto graph = createSimpleGraph(false);
+    auto filePath = (std::filesystem::temp_directory_path() / "labeledEdgeGraphRoundTrip.lcrg").string();
+
+    LabelSet labelSet(3);
+    labelSet[0] = true;
+    labelSet[1] = true;
+
+    // Act
+    GraphWriter::createGraphWriter()->writeLabeledGraph(*graph, filePath);
+    auto mappedGraph = GraphReader::createGraphReader()->readLabeledEdgeGraph(filePath);
+
+    // Assert
+    ASSERT_EQ(mappedGraph->getVertexCount(), graph->getVertexCount());
+    ASSERT_EQ(mappedGraph->getEdgeCount(), graph->getEdgeCount());
+    EXPECT_TRUE(mappedGraph->isLabelGrouped());
+
+    for (auto vertex = 0u; vertex < graph->getVertexCount(); vertex++) {
+        EXPECT_EQ(collect(mappedGraph->getConnected(vertex, labelSet)), collect(graph->getConnected(vertex, labelSet)));
+        EXPECT_EQ(collect(mappedGraph->getReverseConnected(vertex, labelSet)),
+                  collect(graph->getReverseConnected(vertex, labelSet)));
+    }
+
+    // Adding edges copies the mapped arrays, after which the file is no longer used.
+    mappedGraph->addEdge(2, 3, 1);
+    mappedGraph->optimize();
+    std::filesystem::remove(filePath);
+
+    auto it = mappedGraph->getConnected(2, 1);
+
+    EXPECT_EQ(mappedGraph->getEdgeCount(), 8);
+    ASSERT_TRUE(it.next());
+    EXPECT_EQ(it->target, 3);
+}
+
+TEST(labeledEdgeGraph, binaryRejectsCorruptFile) {
+    // Arrange
+    auto graph = createSimpleGraph(false);
+    auto filePath = (std::filesystem::temp_directory_path() / "labeledEdgeGraphCorrupt.lcrg").string();
+
+    GraphWriter::createGraphWriter()->writeLabeledGraph(*graph, filePath);
+
+    auto offsetsPosition = BinaryGraphHeader::alignedSize(sizeof(BinaryGraphHeader));
+    auto targetsPosition = offsetsPosition + BinaryGraphHeader::alignedSize(5 * sizeof(uint32_t));
+
+    auto overwrite = [&](uint64_t position, uint32_t value) {
+        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(std::streamoff(position));
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    // Act & Assert
+    // The first target is outside of the graph.
+    overwrite(targetsPosition, 4);
+    EXPECT_EXIT(GraphReader::createGraphReader()->readLabeledEdgeGraph(filePath), testing::ExitedWithCode(1),
+                "corrupt");
+
+    // The offsets of the first vertex go backwards.
+    overwrite(targetsPosition, 3);
+    overwrite(offsetsPosition + sizeof(uint32_t), 7);
+    overwrite(offsetsPosition + 2 * sizeof(uint32_t), 1);
+    EXPECT_EXIT(GraphReader::createGraphReader()->readLabeledEdgeGraph(filePath), testing::ExitedWithCode(1),
+                "corrupt");
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(labeledEdgeGraph, parseTextFormats) {
+    // Arrange
+    auto expected = std::make_unique<LabeledEdgeGraph>();
+    expected->setSizes(4096, 8, 0);
+
+    auto directory = std::filesystem::temp_directory_path();
+    auto nTriplesPath = (directory / "labeledEdgeGraphParse.nt").string();
+    auto edgePath = (directory / "labeledEdgeGraphParse.edge").string();
+
+    std::ofstream nTriplesFile { nTriplesPath };
+    std::ofstream edgeFile { edgePath };
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 4095);
+    std::uniform_int_distribution<Label> labelDistribution(0, 7);
+
+    // Enough edges for the file to be split in multiple chunks, the last vertex makes the derived counts exact.
+    auto edgeCount = 200000u;
+    nTriplesFile << 4096 << "," << edgeCount + 1 << "," << 8 << "\n";
+
+    for (auto i = 0u; i <= edgeCount; i++) {
+        auto source = i == edgeCount ? 4095 : vertexDistribution(generator);
+        auto target = vertexDistribution(generator);
+        auto label = i == edgeCount ? 7 : labelDistribution(generator);
+
+        expected->addEdge(source, target, label);
+        nTriplesFile << source << " " << label << " " << target << " .\n";
+        edgeFile << source << " " << target << " " << label << "\n";
+    }
+
+    nTriplesFile.close();
+    edgeFile.close();
+    expected->optimize();
+
+    // Act
+    auto nTriplesGraph = GraphReader::createGraphReader()->readLabeledEdgeGraph(nTriplesPath);
+    auto edgeGraph = GraphReader::createGraphReader()->readLabeledEdgeGraph(edgePath);
+
+    std::filesystem::remove(nTriplesPath);
+    std::filesystem::remove(edgePath);
+
+    // Assert
+    LabelSet labelSet(8);
+    labelSet.set();
+
+    for (auto *graph : { nTriplesGraph.get(), edgeGraph.get() }) {
+        ASSERT_EQ(graph->getVertexCount(), expected->getVertexCount());
+        ASSERT_EQ(graph->getLabelCount(), expected->getLabelCount());
+        ASSERT_EQ(graph->getEdgeCount(), expected->getEdgeCount());
+
+        for (auto vertex = 0u; vertex < expected->getVertexCount(); vertex++) {
+            EXPECT_EQ(collect(graph->getConnected(vertex, labelSet)), collect(expected->getConnected(vertex, labelSet)));
+        }
+    }
+}
+
+TEST(labeledEdgeGraph, optimizeLargeGraph) {
+    // Arrange
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 999);
+    std::uniform_int_distribution<Label> labelDistribution(0, 3);
+
+    // Enough edges to be packed on the thread pool, the small vertex range makes many of them duplicates.
+    std::set<std::tuple<Vertex, Vertex, Label>> edges;
+    LabeledEdgeGraph graph;
+    graph.setSizes(1000, 4, 200000);
+
+    for (auto i = 0u; i < 200000; i++) {
+        auto source = vertexDistribution(generator);
+        auto target = vertexDistribution(generator);
+        auto label = labelDistribution(generator);
+
+        edges.emplace(source, target, label);
+        graph.addEdge(source, target, label);
+    }
+
+    // Act
+    graph.optimize();
+
+    // Assert
+    ASSERT_EQ(graph.getEdgeCount(), edges.size());
+
+    std::vector<std::tuple<Vertex, Vertex, Label>> forwardEdges;
+    std::vector<std::tuple<Vertex, Vertex, Label>> reverseEdges;
+
+    for (auto vertex = 0u; vertex < graph.getVertexCount(); vertex++) {
+        auto it = graph.getConnected(vertex);
+        auto revIt = graph.getReverseConnected(vertex);
+
+        while (it.next()) {
+            forwardEdges.emplace_back(vertex, it->target, it->label);
+        }
+
+        while (revIt.next()) {
+            reverseEdges.emplace_back(revIt->target, vertex, revIt->label);
+        }
+    }
+
+    // Forward edges are ordered on source, target and label, reverse edges on target, source and label.
+    EXPECT_TRUE(std::equal(forwardEdges.begin(), forwardEdges.end(), edges.begin(), edges.end()));
+
+    std::stable_sort(forwardEdges.begin(), forwardEdges.end(), [](auto &left, auto &right) {
+        return std::get<1>(left) < std::get<1>(right);
+    });
+
+    EXPECT_EQ(reverseEdges, forwardEdges);
+}
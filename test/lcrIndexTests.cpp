@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "lcrIndex/Index.hpp"
+#include "lcrIndex/P2HIndex.hpp"
+
+TEST(lcrIndex, matchesBFS) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(128, 4, 384);
+
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 127);
+    std::uniform_int_distribution<Label> labelDistribution(0, 3);
+
+    for (auto i = 0u; i < 384; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    auto bfs = lcr::Index::create("bfs");
+    bfs->setGraph(&graph);
+    bfs->train();
+
+    // KLC with k below 2 only has single label indexes, no combinations.
+    std::vector<std::vector<std::string>> indexParams = {{ "klc", "0", "bfs" }, { "klc", "1", "bfs" },
+                                                         { "klc", "2", "pll" }, { "p2h", "4", "parallel" }};
+    std::vector<std::unique_ptr<lcr::Index>> indexes;
+
+    for (auto &params : indexParams) {
+        auto name = params[0];
+        params.erase(params.begin());
+
+        indexes.emplace_back(lcr::Index::create(name, params));
+    }
+
+    // The batched P2H construction, also on a single thread. With 2 primary labels the secondary index is batched too.
+    for (auto labels : { 4u, 2u }) {
+        auto batched = std::make_unique<lcr::P2HIndex>(labels, true);
+        batched->setForceBatches(true);
+
+        indexes.emplace_back(std::move(batched));
+    }
+
+    for (auto &index : indexes) {
+        index->setGraph(&graph);
+
+        // Act
+        index->train();
+
+        // Assert
+        for (auto labels = 1ul; labels < 16; labels++) {
+            std::vector<Label> queryLabels;
+
+            for (Label label = 0; label < 4; label++) {
+                if ((labels >> label) & 1ul) {
+                    queryLabels.emplace_back(label);
+                }
+            }
+
+            for (Vertex source = 0; source < 128; source += 5) {
+                for (Vertex target = 0; target < 128; target += 3) {
+                    LCRQuery query(source, target, queryLabels);
+                    query.init(graph);
+
+                    EXPECT_EQ(index->query(query), bfs->query(query)) << index->getName() << " " << labels;
+                }
+            }
+        }
+    }
+}
+
+TEST(lcrIndex, queryGroupMatchesQuery) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(128, 16, 512);
+
+    std::mt19937 generator(29);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 127);
+    std::uniform_int_distribution<Label> labelDistribution(0, 15);
+
+    for (auto i = 0u; i < 512; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    // P2H with 4 primary labels also answers through its secondary index and the fallback traversal.
+    std::vector<std::vector<std::string>> indexes = {{ "bfs" }, { "p2h", "4" }};
+    std::vector<std::vector<Label>> labelSets = {{ 0 }, { 1, 2 }, { 0, 5, 9 }, { 3, 4, 8, 12, 15 }};
+
+    for (auto &params : indexes) {
+        auto name = params[0];
+        params.erase(params.begin());
+
+        auto index = lcr::Index::create(name, params);
+        index->setGraph(&graph);
+        index->train();
+
+        QueryContext context;
+
+        for (auto &labels : labelSets) {
+            for (Vertex source = 0; source < 128; source += 7) {
+                std::vector<LCRQuery> queries;
+
+                for (Vertex target = 0; target < 128; target += 2) {
+                    queries.emplace_back(source, target, labels);
+                    queries.back().init(graph);
+                }
+
+                std::vector<const LCRQuery *> group;
+
+                for (auto &query : queries) {
+                    group.emplace_back(&query);
+                }
+
+                std::vector<uint8_t> results(group.size());
+
+                // Act
+                index->queryGroup(group, results, context);
+
+                // Assert
+                for (auto i = 0u; i < queries.size(); i++) {
+                    EXPECT_EQ(results[i] != 0, index->query(queries[i], context)) << index->getName();
+                }
+            }
+        }
+    }
+}
+
+TEST(lcrIndex, klcDuplicateAndUnsortedLabels) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(5, 4, 4);
+
+    // Reaching 2 from 0 takes labels 0 and 3, the other labels are only used elsewhere.
+    graph.addEdge(0, 1, 0);
+    graph.addEdge(1, 2, 3);
+    graph.addEdge(3, 4, 1);
+    graph.addEdge(4, 3, 2);
+    graph.optimize();
+
+    auto index = lcr::Index::create("klc", "2", "bfs");
+    index->setGraph(&graph);
+    index->train();
+
+    // The duplicate label 2 must not select the combination of labels 0 and 3.
+    LCRQuery duplicate(0, 2, { 0, 2, 2, 1 });
+    duplicate.init(graph);
+
+    LCRQuery unsorted(0, 2, { 3, 1, 0 });
+    unsorted.init(graph);
+
+    // Act
+    auto duplicateResult = index->query(duplicate);
+    auto unsortedResult = index->query(unsorted);
+
+    // Assert
+    EXPECT_FALSE(duplicateResult);
+    EXPECT_TRUE(unsortedResult);
+}
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "reachIndex/ReachabilityIndex.hpp"
+#include "reachIndex/PLLIndex.hpp"
+#include "graphs/SCCGraph.hpp"
+
+TEST(pllIndex, matchesBFS) {
+    // Arrange
+    DiGraph graph;
+    graph.setVertices(2000);
+
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 1999);
+
+    // Edges only go to lower vertices, such that every vertex is a landmark and the batched build forms batches.
+    for (auto i = 0u; i < 5000; i++) {
+        auto source = vertexDistribution(generator);
+        auto target = vertexDistribution(generator);
+
+        if (source != target) {
+            graph.addEdge(std::max(source, target), std::min(source, target));
+        }
+    }
+
+    auto sccGraph = tarjanSCC(graph, true);
+
+    auto bfs = ReachabilityIndex::create("bfs");
+    bfs->setGraph(sccGraph.get());
+    bfs->train();
+
+    // Without and with bit-parallel labels.
+    for (auto bitParallelRoots : { 0u, 16u }) {
+        PLLIndex sequential(bitParallelRoots);
+        sequential.setGraph(sccGraph.get());
+
+        // The batched build also runs on a single thread.
+        PLLIndex batched(bitParallelRoots);
+        batched.setForceBatches(true);
+        batched.setGraph(sccGraph.get());
+
+        // Act
+        sequential.train();
+        batched.train();
+
+        // Assert
+        QueryContext context;
+
+        for (Vertex source = 0; source < 2000; source += 7) {
+            for (Vertex target = 0; target < 2000; target += 11) {
+                ReachQuery query(source, target);
+                auto expected = bfs->query(query);
+
+                EXPECT_EQ(sequential.query(query, context), expected) << bitParallelRoots << " " << source;
+                EXPECT_EQ(batched.query(query, context), expected) << bitParallelRoots << " " << source;
+            }
+        }
+    }
+}
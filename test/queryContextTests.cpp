@@ -0,0 +1,186 @@
+#include "gtest/gtest.h"
+#include "lcrIndex/Index.hpp"
+
+TEST(queryContext, nestedLeases) {
+    // Arrange
+    QueryContext context;
+
+    // Act
+    auto outer = context.acquire();
+    outer->prepareVisited(8);
+    outer->visited.set(1);
+
+    TraversalScratch *innerScratch;
+
+    {
+        auto inner = context.acquire();
+        innerScratch = &*inner;
+        inner->prepareVisited(8);
+        inner->visited.set(2);
+    }
+
+    auto reused = context.acquire();
+    auto keptMark = reused->visited[2];
+    reused->prepareVisited(8);
+
+    // Assert
+    EXPECT_NE(&*outer, innerScratch);
+    EXPECT_EQ(&*reused, innerScratch);
+    EXPECT_TRUE(outer->visited[1]);
+    EXPECT_FALSE(outer->visited[2]);
+    EXPECT_TRUE(keptMark);
+    EXPECT_FALSE(reused->visited[2]);
+    EXPECT_EQ(reused->visited.sizeInBytes(), 8 * sizeof(uint32_t));
+}
+
+TEST(queryContext, concurrentQueries) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(64, 2, 126);
+
+    for (auto vertex = 0u; vertex < 63; vertex++) {
+        graph.addEdge(vertex, vertex + 1, 0);
+        graph.addEdge(vertex + 1, vertex, 1);
+    }
+
+    graph.optimize();
+
+    auto index = lcr::Index::create("BFS");
+    index->setGraph(&graph);
+    index->train();
+
+    LabelSet forward(2);
+    forward[0] = true;
+
+    std::vector<uint32_t> results(4 * 64);
+
+    // Act
+    std::vector<std::thread> threads;
+
+    for (auto thread = 0u; thread < 4; thread++) {
+        threads.emplace_back([&index, &forward, &results, thread]() {
+            QueryContext context;
+
+            for (auto target = 0u; target < 64; target++) {
+                LCRQuery query;
+                query.source = 63 - thread * 16;
+                query.target = target;
+                query.labelSet = forward;
+                query.labels = { 0 };
+
+                results[thread * 64 + target] = index->query(query, context) ? 1u : 0u;
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    for (auto thread = 0u; thread < 4; thread++) {
+        auto source = 63 - thread * 16;
+
+        for (auto target = 0u; target < 64; target++) {
+            EXPECT_EQ(results[thread * 64 + target], target >= source ? 1u : 0u);
+        }
+    }
+}
+
+TEST(queryContext, epochVisitedSet) {
+    // Arrange
+    EpochVisitedSet visited;
+    visited.reset(8);
+
+    boost::dynamic_bitset<> reachable(8);
+    reachable[5] = true;
+    reachable[7] = true;
+
+    // Act
+    visited.set(1);
+    auto firstInsert = visited.insert(3);
+    auto secondInsert = visited.insert(3);
+    visited.insertAll(reachable);
+
+    // Assert
+    EXPECT_TRUE(visited[1]);
+    EXPECT_TRUE(firstInsert);
+    EXPECT_FALSE(secondInsert);
+    EXPECT_TRUE(visited[5]);
+    EXPECT_TRUE(visited[7]);
+    EXPECT_FALSE(visited[0]);
+
+    visited.reset(8);
+
+    for (auto vertex = 0u; vertex < 8; vertex++) {
+        EXPECT_FALSE(visited[vertex]);
+    }
+}
+
+TEST(queryContext, epochVisitedSetLevels) {
+    // Arrange
+    EpochVisitedSet visited;
+    visited.reset(8);
+    visited.set(6);
+
+    // Act
+    visited.reset(8, 3);
+    visited.set(1);
+    visited.nextLevel();
+    visited.insert(2);
+    visited.nextLevel();
+    visited.insert(3);
+    auto secondInsert = visited.insert(2);
+
+    // Assert
+    EXPECT_EQ(visited.currentLevel(), 3);
+    EXPECT_EQ(visited.level(1), 1);
+    EXPECT_EQ(visited.level(2), 2);
+    EXPECT_EQ(visited.level(3), 3);
+    EXPECT_EQ(visited.level(6), 0);
+    EXPECT_FALSE(visited[6]);
+    EXPECT_FALSE(secondInsert);
+
+    visited.reset(8);
+
+    EXPECT_EQ(visited.level(3), 0);
+    EXPECT_FALSE(visited[3]);
+}
+
+TEST(queryContext, ringQueueWrapsAround) {
+    // Arrange
+    RingQueue<Vertex> queue;
+    std::vector<Vertex> popped;
+
+    // Act
+    for (auto i = 0u; i < 12; i++) {
+        queue.emplace_back(i);
+    }
+
+    for (auto i = 0u; i < 10; i++) {
+        popped.emplace_back(queue.front());
+        queue.pop_front();
+    }
+
+    // Pushing past the end of the buffer wraps around, and then grows the buffer.
+    for (auto i = 12u; i < 40; i++) {
+        queue.emplace_back(i);
+    }
+
+    queue.emplace_front(100);
+
+    // Assert
+    ASSERT_EQ(queue.size(), 31);
+    EXPECT_EQ(queue.front(), 100);
+    EXPECT_EQ(queue.back(), 39);
+
+    queue.pop_front();
+    queue.pop_back();
+
+    EXPECT_EQ(queue.front(), 10);
+    EXPECT_EQ(queue.back(), 38);
+    EXPECT_EQ(popped.back(), 9);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+}
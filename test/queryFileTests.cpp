@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include "io/QueryReader.hpp"
+#include "io/QueryWriter.hpp"
+
+TEST(queryFile, binaryAndCsvRoundTrip) {
+    // Arrange
+    LCRQuerySet queries;
+    queries.emplace_back(0, 3, std::vector<Label> { 0, 2 });
+    queries.emplace_back(7, 1, std::vector<Label> { 5 });
+    queries.emplace_back(2, 2, std::vector<Label> { 1, 3, 4 });
+
+    // The label set is written once the query is initialized, otherwise the label list is written.
+    queries[1].labelSet.resize(6);
+    queries[1].labelSet[5] = true;
+
+    auto directory = std::filesystem::temp_directory_path();
+    auto binaryPath = (directory / "queryFile.lcrq").string();
+    auto csvPath = (directory / "queryFile.csv").string();
+
+    auto queryWriter = QueryWriter::createQueryWriter();
+    auto queryReader = QueryReader::createQueryReader();
+
+    // Act
+    queryWriter->writeLabeledQueries(queries, binaryPath);
+    queryWriter->writeLabeledQueries(PackedLCRQuerySet(queries).unpack(), csvPath);
+
+    auto packedQueries = queryReader->readPackedLabeledQueries(binaryPath);
+    auto binaryQueries = queryReader->readLabeledQueries(binaryPath);
+    auto csvQueries = queryReader->readLabeledQueries(csvPath);
+
+    // Assert
+    ASSERT_EQ(packedQueries->size(), 3);
+    EXPECT_EQ(packedQueries->getLabelCount(), 6);
+    EXPECT_EQ(packedQueries->getSource(1), 7);
+    EXPECT_EQ(std::vector<Label>(packedQueries->labelsBegin(2), packedQueries->labelsEnd(2)),
+              std::vector<Label>({ 1, 3, 4 }));
+
+    ASSERT_EQ(binaryQueries->size(), queries.size());
+    ASSERT_EQ(csvQueries->size(), queries.size());
+
+    for (auto i = 0u; i < queries.size(); i++) {
+        EXPECT_EQ((*binaryQueries)[i].source, queries[i].source);
+        EXPECT_EQ((*binaryQueries)[i].target, queries[i].target);
+        EXPECT_EQ((*binaryQueries)[i].labels, queries[i].labels);
+        EXPECT_EQ((*binaryQueries)[i].labelSet.count(), queries[i].labels.size());
+
+        EXPECT_EQ((*csvQueries)[i].source, queries[i].source);
+        EXPECT_EQ((*csvQueries)[i].target, queries[i].target);
+        EXPECT_EQ((*csvQueries)[i].labels, queries[i].labels);
+    }
+
+    packedQueries.reset();
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(csvPath);
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "io/graphReader/RdfGraphReader.hpp"
+
+TEST(rdfGraphReader, readWithDictionaries) {
+    // Arrange
+    auto directory = std::filesystem::temp_directory_path();
+    auto filePath = (directory / "rdfGraphReader.rdf").string();
+    auto dictionaryPath = (directory / "rdfGraphReader.vertices").string();
+
+    std::ofstream file { filePath };
+    file << "<http://a> <http://knows> <http://b> .\n";
+    file << "# a comment, followed by an empty line\n\n";
+    file << "<http://b> <http://name> \"b \\\"quoted\\\" . name\"@en .\n";
+    file << "_:node <http://knows> <http://a>.\n";
+    file << "<http://a> <http://knows> <http://b> .\n";
+    file.close();
+
+    StringDictionary vertices;
+    StringDictionary labels;
+
+    // Act
+    auto graph = RdfGraphReader().readLabeledEdgeGraph(filePath, vertices, labels);
+    graph->optimize();
+
+    vertices.write(dictionaryPath);
+
+    StringDictionary loaded;
+    loaded.read(dictionaryPath);
+
+    std::filesystem::remove(filePath);
+    std::filesystem::remove(dictionaryPath);
+
+    // Assert
+    ASSERT_EQ(vertices.size(), 4);
+    ASSERT_EQ(labels.size(), 2);
+    EXPECT_EQ(graph->getVertexCount(), 4);
+    EXPECT_EQ(graph->getEdgeCount(), 3);
+
+    EXPECT_EQ(vertices[2], "\"b \\\"quoted\\\" . name\"@en");
+    EXPECT_EQ(vertices[3], "_:node");
+    EXPECT_EQ(labels[1], "<http://name>");
+
+    Vertex id;
+    ASSERT_TRUE(loaded.find("<http://b>", id));
+    EXPECT_EQ(id, 1);
+    EXPECT_FALSE(loaded.find("<http://c>", id));
+
+    auto it = graph->getConnected(3);
+    ASSERT_TRUE(it.next());
+    EXPECT_EQ(it->target, 0);
+    EXPECT_EQ(it->label, 0);
+}
+
+TEST(rdfGraphReader, readCrlfLines) {
+    // Arrange
+    auto filePath = (std::filesystem::temp_directory_path() / "rdfGraphReaderCrlf.rdf").string();
+
+    std::ofstream file { filePath, std::ios::binary };
+    file << "<http://a> <http://knows> _:node.\r\n";
+    file << "_:node <http://knows> <http://b>. \t\r\n";
+    file << "<http://b> <http://knows> <http://a> .\r\n";
+    file.close();
+
+    StringDictionary vertices;
+    StringDictionary labels;
+
+    // Act
+    auto graph = RdfGraphReader().readLabeledEdgeGraph(filePath, vertices, labels);
+    graph->optimize();
+
+    std::filesystem::remove(filePath);
+
+    // Assert
+    ASSERT_EQ(vertices.size(), 3);
+    ASSERT_EQ(labels.size(), 1);
+    EXPECT_EQ(vertices[1], "_:node");
+    EXPECT_EQ(vertices[2], "<http://b>");
+    EXPECT_EQ(graph->getEdgeCount(), 3);
+}
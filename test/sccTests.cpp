@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "graphs/SCCGraph.hpp"
+#include "graphs/LabeledEdgeGraph.hpp"
 
 TEST(tarjanSCC, simpleGraph) {
     // Arrange
@@ -350,4 +351,84 @@ TEST(tarjanSCC, GraphWithSingleVertex) {
     // Assert
     ASSERT_EQ(sccGraph->getComponentGraph().getVertexCount(), 1) << "Should have 1 components";
     EXPECT_TRUE(sccGraph->isSingleComponent(0));
-}
\ No newline at end of file
+}
+
+TEST(deriveSCCGraph, matchesMergedGraph) {
+    // Arrange
+    LabeledEdgeGraph graph;
+    graph.setSizes(300, 3, 900);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<Vertex> vertexDistribution(0, 299);
+    std::uniform_int_distribution<Label> labelDistribution(0, 2);
+
+    for (auto i = 0u; i < 900; i++) {
+        graph.addEdge(vertexDistribution(generator), vertexDistribution(generator), labelDistribution(generator));
+    }
+
+    graph.optimize();
+
+    LabelSet subsetLabelSet(3, 0b001);
+    MergedGraphStats subsetStats;
+    auto subsetGraph = tarjanSCC(*mergeGraphForLabels(graph, subsetLabelSet, subsetStats));
+
+    for (auto labels : { 0b011ul, 0b111ul }) {
+        LabelSet labelSet(3, labels);
+
+        MergedGraphStats expectedStats;
+        auto expected = tarjanSCC(*mergeGraphForLabels(graph, labelSet, expectedStats));
+
+        // Act
+        MergedGraphStats stats;
+        auto derived = deriveSCCGraph(graph, *subsetGraph, subsetLabelSet, labelSet, stats);
+
+        // Assert
+        ASSERT_EQ(derived->getComponentCount(), expected->getComponentCount()) << labels;
+        EXPECT_EQ(derived->getComponentGraph().getEdgeCount(), expected->getComponentGraph().getEdgeCount());
+        EXPECT_EQ(stats.increase, expectedStats.increase);
+
+        // The same vertices share a component, and the components are still topologically sorted.
+        for (Vertex first = 0; first < 300; first++) {
+            for (Vertex second = first + 1; second < 300; second++) {
+                EXPECT_EQ(derived->areInSameComponent(first, second), expected->areInSameComponent(first, second));
+            }
+        }
+
+        for (Vertex component = 0; component < derived->getComponentCount(); component++) {
+            for (auto target : derived->getComponentGraph().getConnected(component)) {
+                EXPECT_LT(target, component);
+            }
+        }
+    }
+}
+
+TEST(vertexMapping, storesRunsAndShares) {
+    // Arrange
+    std::mt19937 generator(5);
+    std::vector<Vertex> mapping(1000);
+
+    // Mostly runs of consecutive components, with a few vertices in shared components.
+    for (Vertex vertex = 0; vertex < mapping.size(); vertex++) {
+        mapping[vertex] = generator() % 10 == 0 ? generator() % 50 : vertex + 7;
+    }
+
+    VertexMappingStore store;
+
+    // Act
+    auto first = store.insert(std::vector<Vertex>(mapping));
+    auto second = store.insert(std::vector<Vertex>(mapping));
+
+    // Assert
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(first->isStoredAsRuns());
+    EXPECT_LT(first->getSizeInBytes(), mapping.size() * sizeof(Vertex) / 2);
+
+    for (Vertex vertex = 0; vertex < mapping.size(); vertex++) {
+        EXPECT_EQ((*first)[vertex], mapping[vertex]) << vertex;
+    }
+
+    EXPECT_EQ(first->decode(), mapping);
+
+    mapping[999]++;
+    EXPECT_NE(store.insert(std::vector<Vertex>(mapping)), first);
+}